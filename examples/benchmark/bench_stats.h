@@ -0,0 +1,166 @@
+/**
+ * @file bench_stats.h
+ * @brief Sample statistics shared by the benchmark and the compare tool.
+ *
+ * This file summarizes the run times of a benchmark (mean, standard deviation, median
+ * and the confidence interval of the mean) and computes the Welch interval of the
+ * difference of two means, the test the compare tool flags regressions with. The t
+ * quantiles invert the exact distribution function, the corrected levels of the compare
+ * tool reach far into the tails where the closed-form expansions fall short.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_BENCH_STATS_H
+#define ADAPTIVE_BENCH_STATS_H
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace adaptive_bench {
+    /**
+     * @brief The mean, spread and confidence interval of a set of samples
+     */
+    struct summary {
+        size_t n = 0;
+        double mean = 0;
+        double stddev = 0;
+        double median = 0;
+        double min = 0;
+        double ci_low = 0;
+        double ci_high = 0;
+    };
+
+    /**
+     * @brief The difference `b - a` of two means and its confidence interval
+     */
+    struct difference {
+        double diff = 0;
+        double low = 0;
+        double high = 0;
+        double df = 0;
+    };
+
+    /**
+     * @brief The `p` quantile of the standard normal distribution, Abramowitz and Stegun 26.2.23
+     */
+    inline double normal_quantile(double p) {
+        if(p <= 0.0 || p >= 1.0) return 0.0;
+        const double q = p < 0.5 ? p : 1.0 - p;
+        const double t = std::sqrt(-2.0 * std::log(q));
+        const double z = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+                             (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+        return p < 0.5 ? -z : z;
+    }
+
+    /**
+     * @brief The regularized incomplete beta function `I_x(a, b)`, Lentz's continued fraction
+     */
+    inline double incomplete_beta(double x, double a, double b) {
+        if(x <= 0.0) return 0.0;
+        if(x >= 1.0) return 1.0;
+        if(x > (a + 1.0) / (a + b + 2.0)) return 1.0 - incomplete_beta(1.0 - x, b, a);
+
+        const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                      a * std::log(x) + b * std::log1p(-x)) / a;
+        const double tiny = 1e-300;
+        double f = 1.0, c = 1.0, d = 0.0;
+        for(int i = 0; i <= 400; ++i) {
+            const double m = double(i / 2);
+            const double num = i == 0 ? 1.0
+                             : i % 2 == 0 ? m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m))
+                             : -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+            d = 1.0 + num * d;
+            d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+            c = 1.0 + num / c;
+            if(std::fabs(c) < tiny) c = tiny;
+            f *= c * d;
+            if(std::fabs(1.0 - c * d) < 1e-14) break;
+        }
+        return front * (f - 1.0);
+    }
+
+    /**
+     * @brief The distribution function of Student's t distribution with `df` degrees of freedom
+     */
+    inline double t_cdf(double t, double df) {
+        const double tail = 0.5 * incomplete_beta(df / (df + t * t), df / 2.0, 0.5);
+        return t < 0.0 ? tail : 1.0 - tail;
+    }
+
+    /**
+     * @brief The `p` quantile of Student's t distribution with `df` degrees of freedom
+     *
+     * Bisection on `t_cdf`, the normal quantile for `df` of 0 (unknown).
+     */
+    inline double t_quantile(double p, double df) {
+        if(df <= 0.0) return normal_quantile(p);
+        if(p <= 0.0 || p >= 1.0) return 0.0;
+        if(p < 0.5) return -t_quantile(1.0 - p, df);
+
+        double lo = 0.0, hi = 1.0;
+        while(t_cdf(hi, df) < p && hi < 1e12) { lo = hi; hi *= 2.0; }
+        for(int i = 0; i < 100 && hi - lo > 1e-9 * hi; ++i) {
+            const double mid = 0.5 * (lo + hi);
+            (t_cdf(mid, df) < p ? lo : hi) = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    /**
+     * @brief Summarizes `samples` with a two-sided interval of the mean at `confidence`
+     */
+    inline summary summarize(std::vector<double> samples, double confidence = 0.95) {
+        summary _result;
+        _result.n = samples.size();
+        if(samples.empty()) return _result;
+
+        std::sort(samples.begin(), samples.end());
+        double _sum = 0;
+        for(double s : samples) _sum += s;
+        _result.mean = _sum / double(_result.n);
+        _result.min = samples.front();
+        _result.median = _result.n % 2 ? samples[_result.n / 2] : 0.5 * (samples[_result.n / 2 - 1] + samples[_result.n / 2]);
+
+        double _var = 0;
+        for(double s : samples) _var += (s - _result.mean) * (s - _result.mean);
+        _result.stddev = _result.n > 1 ? std::sqrt(_var / double(_result.n - 1)) : 0.0;
+
+        const double half = _result.n > 1 ? t_quantile(0.5 + confidence / 2.0, double(_result.n - 1)) *
+                                            _result.stddev / std::sqrt(double(_result.n)) : 0.0;
+        _result.ci_low = _result.mean - half;
+        _result.ci_high = _result.mean + half;
+        return _result;
+    }
+
+    /**
+     * @brief Welch's interval of `b.mean - a.mean` at `confidence`, for samples of unequal variance
+     */
+    inline difference welch_interval(const summary& a, const summary& b, double confidence = 0.95) {
+        difference _result;
+        _result.diff = b.mean - a.mean;
+        if(a.n < 2 || b.n < 2) {
+            _result.low = _result.high = _result.diff;
+            return _result;
+        }
+        const double va = a.stddev * a.stddev / double(a.n);
+        const double vb = b.stddev * b.stddev / double(b.n);
+        const double se = std::sqrt(va + vb);
+        if(se == 0.0) {
+            _result.low = _result.high = _result.diff;
+            return _result;
+        }
+        _result.df = (va + vb) * (va + vb) / (va * va / double(a.n - 1) + vb * vb / double(b.n - 1));
+        const double half = t_quantile(0.5 + confidence / 2.0, _result.df) * se;
+        _result.low = _result.diff - half;
+        _result.high = _result.diff + half;
+        return _result;
+    }
+}
+
+#endif
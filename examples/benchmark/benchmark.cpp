@@ -0,0 +1,958 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmarks for the adaptive kernels.
+ *
+ * Build and run (from the repository root):
+ * @code
+ * g++ -std=c++17 -O3 -mavx2 -pthread -Iinclude examples/benchmark/benchmark.cpp -o adaptive_bench
+ * ./adaptive_bench
+ * @endcode
+ *
+ * Options:
+ * - `--json <file>` also writes every measured library kernel with its run times to
+ *   `file`, the input of the compare tool (`compare.cpp`). Implies `--repeats 10`.
+ * - `--repeats <n>` runs every measurement at least `n` times.
+ * - `--filter <text>` runs only the benchmark groups whose name contains `text`.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <adaptive_algorithm.h>
+#include <adaptive_atomic.h>
+#include <adaptive_checksum.h>
+#include <adaptive_gemm.h>
+#include <adaptive_graph.h>
+#include <adaptive_hash.h>
+#include <adaptive_mod.h>
+#include <adaptive_numa.h>
+#include <adaptive_ntt.h>
+#include <adaptive_pipeline.h>
+#include <adaptive_numeric.h>
+#include <adaptive_quantized.h>
+#include <adaptive_random.h>
+#include <adaptive_stencil.h>
+#include <adaptive_small_matrix.h>
+#include <adaptive_sparse.h>
+#include <adaptive_thread_pool.h>
+
+#include "bench_stats.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    /**
+     * @brief The command line options
+     */
+    struct bench_options {
+        size_t repeats = 0;
+        std::string json;
+        std::string filter;
+    };
+    bench_options& options() {
+        static bench_options _options;
+        return _options;
+    }
+
+    /**
+     * @brief One measured kernel, an entry of the JSON report
+     */
+    struct bench_result {
+        std::string kernel;
+        std::string type;
+        std::string technique;
+        size_t size;            // elements per run
+        size_t threads;
+        double bytes;           // bytes read and written per run
+        std::vector<double> samples;
+        std::vector<std::pair<std::string, double> > counters;
+    };
+    std::vector<bench_result>& results() {
+        static std::vector<bench_result> _results;
+        return _results;
+    }
+    /**
+     * @brief The run times of the last `best_of`, in seconds
+     */
+    std::vector<double>& last_samples() {
+        static std::vector<double> _samples;
+        return _samples;
+    }
+
+    /**
+     * @brief Runs `fn` `repeats` times, at least `--repeats` times, and returns the fastest run in seconds
+     */
+    template <typename TFUNC>
+    double best_of(size_t repeats, TFUNC&& fn) {
+        double _best = 1e30;
+        last_samples().clear();
+        for(size_t i = 0; i < std::max(repeats, options().repeats); ++i) {
+            auto t0 = clock_type::now();
+            fn();
+            const double s = std::chrono::duration<double>(clock_type::now() - t0).count();
+            last_samples().push_back(s);
+            _best = std::min(_best, s);
+        }
+        return _best;
+    }
+
+    template <typename TINT>
+    std::string type_name() {
+        const char* kind = std::is_floating_point<TINT>::value ? "float" : std::is_signed<TINT>::value ? "int" : "uint";
+        return kind + std::to_string(8 * sizeof(TINT));
+    }
+
+    /**
+     * @brief Adds the samples of the last `best_of` to the report
+     *
+     * The first run warms the caches and is dropped when there are three or more. A
+     * measurement whose kernel, type, technique, size and threads are already in the report
+     * is not added again: the Scalar reference of a Scalar build or the threaded run on a
+     * single hardware thread measure the same thing twice.
+     *
+     * @param kernel The name of the kernel, with the variant after a slash
+     * @param size The elements a run processes
+     * @param bytes The bytes a run reads and writes, 0 where bandwidth means nothing
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    bench_result& record(const std::string& kernel, size_t size, double bytes, size_t threads = 1) {
+        bench_result r{ kernel, type_name<TINT>(), adaptive::technt2string(TTECH), size, threads, bytes,
+                        last_samples(), { } };
+        for(bench_result& e : results())
+            if(e.kernel == r.kernel && e.type == r.type && e.technique == r.technique && e.size == r.size && e.threads == r.threads)
+                return e;
+        if(r.samples.size() >= 3) r.samples.erase(r.samples.begin());
+        results().push_back(std::move(r));
+        return results().back();
+    }
+
+    /**
+     * @brief `best_of` and `record` in one, for measurements inside expressions
+     */
+    template <typename TINT, adaptive::techn_t TTECH, typename TFUNC>
+    double measure(const std::string& kernel, size_t size, double bytes, size_t repeats, TFUNC&& fn) {
+        const double _result = best_of(repeats, fn);
+        record<TINT, TTECH>(kernel, size, bytes);
+        return _result;
+    }
+
+    /**
+     * @brief Get whether the benchmark group `name` passes `--filter`
+     */
+    bool selected(const char* name) {
+        return options().filter.empty() || std::strstr(name, options().filter.c_str()) != nullptr;
+    }
+
+    std::string json_string(const std::string& s) {
+        std::string _result = "\"";
+        for(char c : s) {
+            if(c == '"' || c == '\\') _result += '\\';
+            _result += c;
+        }
+        return _result + "\"";
+    }
+
+    /**
+     * @brief Writes the report; the samples are nanoseconds per run
+     */
+    bool write_json(const std::string& path) {
+        std::FILE* f = std::fopen(path.c_str(), "w");
+        if(f == nullptr) return false;
+        char _date[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(_date, sizeof(_date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+#ifdef __VERSION__
+        const char* compiler = __VERSION__;
+#else
+        const char* compiler = "unknown";
+#endif
+        std::fprintf(f, "{\n  \"date\": %s,\n  \"compiler\": %s,\n  \"hardware_threads\": %u,\n  \"results\": [",
+                     json_string(_date).c_str(), json_string(compiler).c_str(), std::thread::hardware_concurrency());
+        for(size_t i = 0; i < results().size(); ++i) {
+            const bench_result& r = results()[i];
+            std::vector<double> ns(r.samples);
+            for(auto& s : ns) s *= 1e9;
+            const adaptive_bench::summary st = adaptive_bench::summarize(ns);
+            std::fprintf(f, "%s\n    {\"kernel\": %s, \"type\": %s, \"technique\": %s, \"size\": %zu, \"threads\": %zu,\n",
+                         i ? "," : "", json_string(r.kernel).c_str(), json_string(r.type).c_str(),
+                         json_string(r.technique).c_str(), r.size, r.threads);
+            std::fprintf(f, "     \"mean_ns\": %.1f, \"stddev_ns\": %.1f, \"median_ns\": %.1f, \"ci95_ns\": [%.1f, %.1f],\n",
+                         st.mean, st.stddev, st.median, st.ci_low, st.ci_high);
+            std::fprintf(f, "     \"ns_per_elem\": %.6g, \"gb_per_s\": %.6g,\n     \"counters\": {",
+                         r.size ? st.median / double(r.size) : 0.0, st.median > 0 ? r.bytes / st.median : 0.0);
+            for(size_t c = 0; c < r.counters.size(); ++c)
+                std::fprintf(f, "%s%s: %.6g", c ? ", " : "", json_string(r.counters[c].first).c_str(), r.counters[c].second);
+            std::fprintf(f, "},\n     \"samples_ns\": [");
+            for(size_t k = 0; k < ns.size(); ++k) std::fprintf(f, "%s%.1f", k ? ", " : "", ns[k]);
+            std::fprintf(f, "]}");
+        }
+        std::fprintf(f, "\n  ]\n}\n");
+        return std::fclose(f) == 0;
+    }
+
+    template <typename TMATRIX>
+    void fill_random(TMATRIX& m, unsigned seed) {
+        std::mt19937 g(seed);
+        for(size_t i = 0; i < m.size(); ++i) m.data()[i] = typename TMATRIX::value_type(g() % 17) - 8;
+    }
+
+    /**
+     * @brief GEMM throughput from 1 to all hardware threads for one shape
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_gemm_scaling(const char* name, size_t M, size_t K, size_t N) {
+        adaptive::adaptive_matrix<TINT, TTECH> a(M, K), b(K, N), c;
+        fill_random(a, 1);
+        fill_random(b, 2);
+
+        const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const double ops = 2.0 * double(M) * double(K) * double(N);
+        double t1 = 0;
+
+        std::printf("gemm %-12s %6zux%-6zux%-6zu %-6s\n", name, M, K, N,
+                    adaptive::technt2string(TTECH).c_str());
+        for(size_t t = 1; t <= max_threads; t = (t < max_threads && t * 2 > max_threads) ? max_threads : t * 2) {
+            adaptive::thread_pool pool(t);
+            double s = best_of(3, [&]() { adaptive::gemm(a, b, c, pool); });
+            record<TINT, TTECH>(std::string("gemm/") + name, M * N, double(M * K + K * N + M * N) * sizeof(TINT), t)
+                .counters.emplace_back("gop_s", ops / s * 1e-9);
+            if(t == 1) t1 = s;
+            std::printf("  threads %3zu  %9.3f ms  %8.2f Gop/s  speedup %5.2fx\n", t, s * 1e3, ops / s * 1e-9, t1 / s);
+        }
+    }
+
+    /**
+     * @brief CSR matrix-vector multiply with and without gathers, serial and banded over all hardware threads
+     *
+     * Each row has `per_row` non zeros in a window of 4096 columns around the diagonal.
+     * The Scalar matrix holds the same data and is the run without gathers.
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_spmv(size_t rows, size_t cols, size_t per_row) {
+        constexpr adaptive::techn_t scalar = adaptive::techn_t::Scalar;
+        std::vector<typename adaptive::adaptive_csr_matrix<TINT, TTECH>::coo_entry> entries;
+        std::vector<typename adaptive::adaptive_csr_matrix<TINT, scalar>::coo_entry> sentries;
+        std::mt19937 g(4);
+        for(size_t r = 0; r < rows; ++r)
+            for(size_t k = 0; k < per_row; ++k) {
+                const size_t c = (r * cols / rows + g() % 4096) % cols;
+                const TINT v = TINT(g() % 15 + 1);
+                entries.push_back({ r, c, v });
+                sentries.push_back({ r, c, v });
+            }
+        const auto a = adaptive::adaptive_csr_matrix<TINT, TTECH>::from_coo(rows, cols, std::move(entries));
+        const auto sa = adaptive::adaptive_csr_matrix<TINT, scalar>::from_coo(rows, cols, std::move(sentries));
+        adaptive::adaptive_vector<TINT, TTECH> x(cols, TINT(1)), y;
+        adaptive::adaptive_vector<TINT, scalar> sx(cols, TINT(1)), sy;
+
+        const size_t nnz = a.nonzeros();
+        const double bytes = double(nnz) * (2 * sizeof(TINT) + sizeof(uint32_t)) + double(rows) * (sizeof(TINT) + sizeof(size_t));
+        const size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const double tg = best_of(5, [&]() { a.multiply(x, y); });
+        record<TINT, TTECH>("spmv/gather", nnz, bytes);
+        const double ts = best_of(5, [&]() { sa.multiply(sx, sy); });
+        record<TINT, scalar>("spmv/scalar", nnz, bytes);
+        const double tgp = best_of(5, [&]() { a.multiply(x, y, threads); });
+        record<TINT, TTECH>("spmv/gather", nnz, bytes, threads);
+        const double tsp = best_of(5, [&]() { sa.multiply(sx, sy, threads); });
+        record<TINT, scalar>("spmv/scalar", nnz, bytes, threads);
+        std::printf("spmv%-2zu %-6s  %zu rows  %zu nnz  serial: gather %6.2f scalar %6.2f  threads %zu: gather %6.2f scalar %6.2f GB/s\n",
+                    sizeof(TINT) * 8, adaptive::technt2string(TTECH).c_str(), rows, nnz, bytes / tg * 1e-9, bytes / ts * 1e-9,
+                    threads, bytes / tgp * 1e-9, bytes / tsp * 1e-9);
+    }
+
+    /**
+     * @brief Quantized u8 x s8 GEMM with int32 and requantized int8 output against an FP32 loop
+     *
+     * The FP32 reference is the plain `i-k-j` loop, which the compiler vectorizes.
+     */
+    template <adaptive::techn_t TTECH>
+    void bench_qgemm(size_t M, size_t K, size_t N) {
+        adaptive::adaptive_matrix<uint8_t, TTECH> a(M, K);
+        adaptive::adaptive_matrix<int8_t, TTECH> b(K, N);
+        adaptive::adaptive_matrix<int32_t, TTECH> c32;
+        adaptive::adaptive_matrix<int8_t, TTECH> c8;
+        std::vector<float> fa(M * K), fb(K * N), fc(M * N);
+        std::mt19937 g(3);
+        for(size_t i = 0; i < a.size(); ++i) fa[i] = float(a.data()[i] = uint8_t(g()));
+        for(size_t i = 0; i < b.size(); ++i) fb[i] = float(b.data()[i] = int8_t(g()));
+
+        const double ops = 2.0 * double(M) * double(K) * double(N);
+        double tpack = best_of(3, [&]() { adaptive::packed_qmatrix p(b, 0); });
+        const adaptive::packed_qmatrix pb(b, 3);
+        double t32 = best_of(3, [&]() { adaptive::qgemm(a, 128, pb, c32); });
+        record<uint8_t, TTECH>("qgemm/int32", M * N, double(M * K + K * N) + 4.0 * M * N).counters.emplace_back("gop_s", ops / t32 * 1e-9);
+        double t8 = best_of(3, [&]() { adaptive::qgemm(a, { 0.02f, 128 }, pb, 0.01f, { 0.5f, 0 }, c8); });
+        record<uint8_t, TTECH>("qgemm/int8", M * N, double(M * K + K * N + M * N)).counters.emplace_back("gop_s", ops / t8 * 1e-9);
+        double tf = best_of(3, [&]() {
+            std::fill(fc.begin(), fc.end(), 0.0f);
+            for(size_t i = 0; i < M; ++i)
+                for(size_t k = 0; k < K; ++k) {
+                    const float av = fa[i * K + k];
+                    for(size_t j = 0; j < N; ++j) fc[i * N + j] += av * fb[k * N + j];
+                }
+        });
+        record<float, adaptive::techn_t::Scalar>("gemm_fp32/ikj", M * N, 4.0 * double(M * K + K * N + M * N))
+            .counters.emplace_back("gop_s", ops / tf * 1e-9);
+        std::printf("qgemm %6zux%-6zux%-6zu %-6s  pack %7.2f ms  int32 %8.2f  int8 %8.2f  fp32 %8.2f Gop/s  (int8 %5.2fx fp32)\n",
+                    M, K, N, adaptive::technt2string(TTECH).c_str(), tpack * 1e3, ops / t32 * 1e-9, ops / t8 * 1e-9,
+                    ops / tf * 1e-9, tf / t8);
+    }
+
+    /**
+     * @brief Layout conversion bandwidth and single-threaded GEMM per operand layout
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_layouts(size_t n) {
+        using row_type = adaptive::adaptive_matrix<TINT, TTECH>;
+        using col_type = adaptive::adaptive_matrix<TINT, TTECH, adaptive::layout_t::ColMajor>;
+        using tiled_type = adaptive::adaptive_matrix<TINT, TTECH, adaptive::layout_t::Tiled>;
+
+        row_type a(n, n), b(n, n), c;
+        fill_random(a, 1);
+        fill_random(b, 2);
+        col_type ac; tiled_type at, bt;
+
+        const double bytes = 2.0 * double(n) * double(n) * sizeof(TINT);
+        std::printf("layout %zux%zu %-6s\n", n, n, adaptive::technt2string(TTECH).c_str());
+        double s = best_of(5, [&]() { adaptive::convert_layout(a, ac); });
+        record<TINT, TTECH>("convert_layout/row-col", n * n, bytes);
+        std::printf("  row -> col    %9.3f ms  %8.2f GB/s\n", s * 1e3, bytes / s * 1e-9);
+        s = best_of(5, [&]() { adaptive::convert_layout(a, at); });
+        record<TINT, TTECH>("convert_layout/row-tiled", n * n, bytes);
+        std::printf("  row -> tiled  %9.3f ms  %8.2f GB/s\n", s * 1e3, bytes / s * 1e-9);
+        s = best_of(5, [&]() { adaptive::convert_layout(at, c); });
+        record<TINT, TTECH>("convert_layout/tiled-row", n * n, bytes);
+        std::printf("  tiled -> row  %9.3f ms  %8.2f GB/s\n", s * 1e3, bytes / s * 1e-9);
+
+        adaptive::convert_layout(b, bt);
+        const double ops = 2.0 * double(n) * double(n) * double(n);
+        s = best_of(3, [&]() { adaptive::gemm(a, b, c); });
+        record<TINT, TTECH>("gemm/row-row", n * n, 0);
+        std::printf("  gemm row   x row    %9.3f ms  %8.2f Gop/s\n", s * 1e3, ops / s * 1e-9);
+        s = best_of(3, [&]() { adaptive::gemm(ac, b, c); });
+        record<TINT, TTECH>("gemm/col-row", n * n, 0);
+        std::printf("  gemm col   x row    %9.3f ms  %8.2f Gop/s\n", s * 1e3, ops / s * 1e-9);
+        s = best_of(3, [&]() { adaptive::gemm(at, bt, c); });
+        record<TINT, TTECH>("gemm/tiled-tiled", n * n, 0);
+        std::printf("  gemm tiled x tiled  %9.3f ms  %8.2f Gop/s\n", s * 1e3, ops / s * 1e-9);
+    }
+
+    /**
+     * @brief Convolution throughput of one filter, single-threaded and on all hardware threads
+     */
+    template <typename TSRC, typename TDST, adaptive::techn_t TTECH, size_t K>
+    void bench_stencil(const char* name, const adaptive::conv_filter<K>& filter, size_t h, size_t w) {
+        adaptive::adaptive_matrix<TSRC, TTECH> src(h, w);
+        adaptive::adaptive_matrix<TDST, TTECH> dst;
+        std::mt19937 g(3);
+        for(size_t i = 0; i < src.size(); ++i) src.data()[i] = TSRC(g());
+
+        adaptive::thread_pool pool(0);
+        const double pixels = double(h) * double(w);
+        const double bytes = pixels * double(sizeof(TSRC) + sizeof(TDST));
+        double s1 = best_of(3, [&]() { adaptive::convolve(src, dst, filter); });
+        record<TSRC, TTECH>(std::string("convolve/") + name, h * w, bytes);
+        double sn = best_of(3, [&]() { adaptive::convolve(src, dst, filter, pool); });
+        record<TSRC, TTECH>(std::string("convolve/") + name, h * w, bytes, pool.size());
+        std::printf("stencil %-12s %zux%zu %-6s  %8.1f Mpix/s  %3zu threads %8.1f Mpix/s\n", name, h, w,
+                    adaptive::technt2string(TTECH).c_str(), pixels / s1 * 1e-6, pool.size(), pixels / sn * 1e-6);
+    }
+
+    /**
+     * @brief Batched 4x4 products, structure-of-arrays batch vs. an array of per-matrix structs
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_small_matrix(size_t count) {
+        using batch_type = adaptive::adaptive_small_matrix_batch<TINT, 4, TTECH>;
+        using aos_type = std::array<TINT, 16>;
+
+        batch_type a(count), b(count), c;
+        std::vector<aos_type> aa(count), ab(count), ac(count);
+        std::mt19937 g(4);
+        for(size_t m = 0; m < count; ++m) {
+            for(size_t p = 0; p < 16; ++p) aa[m][p] = TINT(g() % 100);
+            for(size_t p = 0; p < 16; ++p) ab[m][p] = TINT(g() % 100);
+            a.set(m, aa[m]);
+            b.set(m, ab[m]);
+        }
+
+        double soa = best_of(5, [&]() { batch_type::multiply(a, b, c); });
+        record<TINT, TTECH>("mat4_batch/multiply", count, 48.0 * count * sizeof(TINT));
+        double aos = best_of(5, [&]() {
+            for(size_t m = 0; m < count; ++m)
+                for(size_t i = 0; i < 4; ++i)
+                    for(size_t j = 0; j < 4; ++j) {
+                        TINT s = 0;
+                        for(size_t k = 0; k < 4; ++k) s += aa[m][i * 4 + k] * ab[m][k * 4 + j];
+                        ac[m][i * 4 + j] = s;
+                    }
+        });
+        std::printf("mat4 batch %zu %-6s  soa %8.2f Mmat/s  aos %8.2f Mmat/s\n", count,
+                    adaptive::technt2string(TTECH).c_str(), count / soa * 1e-6, count / aos * 1e-6);
+    }
+
+    /**
+     * @brief Batched `a * b mod m` and `a mod m` against the `%` loop with a runtime modulus
+     */
+    template <adaptive::techn_t TTECH>
+    void bench_mod(uint32_t modulus, size_t n) {
+        // Keeps the compiler from turning the reference `%` into a multiply by a constant.
+        volatile uint32_t opaque = modulus;
+        const uint32_t m = opaque;
+        const adaptive::modulus<uint32_t> mod(m);
+        adaptive::adaptive_vector<uint32_t, TTECH> a(n), b(n), c;
+        std::vector<uint32_t> ref(n);
+        std::mt19937 g(5);
+        for(size_t i = 0; i < n; ++i) { a[i] = g(); b[i] = g() % m; }
+
+        double kmul = best_of(5, [&]() { adaptive::mod_mul(a, b, c, mod); });
+        record<uint32_t, TTECH>("mod_mul/" + std::to_string(m), n, 12.0 * n);
+        double dmul = best_of(5, [&]() {
+            for(size_t i = 0; i < n; ++i) ref[i] = uint32_t(uint64_t(a[i]) * b[i] % m);
+        });
+        double kred = best_of(5, [&]() { adaptive::mod_reduce(a, c, mod); });
+        record<uint32_t, TTECH>("mod_reduce/" + std::to_string(m), n, 8.0 * n);
+        double dred = best_of(5, [&]() {
+            for(size_t i = 0; i < n; ++i) ref[i] = a[i] % m;
+        });
+        std::printf("mod %-10u %-6s  mul %8.2f Gop/s (%% %6.2f)  reduce %8.2f Gop/s (%% %6.2f)\n", m,
+                    adaptive::technt2string(TTECH).c_str(), n / kmul * 1e-9, n / dmul * 1e-9,
+                    n / kred * 1e-9, n / dred * 1e-9);
+    }
+
+    /**
+     * @brief Forward + inverse transform of `n` elements, scalar against the technique
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_ntt(size_t n) {
+        const adaptive::ntt_plan<TINT> plan(n);
+        adaptive::adaptive_vector<TINT, TTECH> v(n);
+        std::mt19937_64 g(6);
+        for(auto& x : v) x = TINT(g() % plan.prime());
+
+        double simd = best_of(5, [&]() { plan.forward(v); plan.inverse(v); });
+        record<TINT, TTECH>("ntt/roundtrip", n, 0);
+        double scalar = best_of(5, [&]() {
+            plan.template forward<adaptive::techn_t::Scalar>(v.data(), n);
+            plan.template inverse<adaptive::techn_t::Scalar>(v.data(), n, false);
+        });
+        record<TINT, adaptive::techn_t::Scalar>("ntt/roundtrip", n, 0);
+        std::printf("ntt%-2zu %-9zu %-6s  %8.3f ms  (Scalar %8.3f ms)\n", sizeof(TINT) * 8, n,
+                    adaptive::technt2string(TTECH).c_str(), simd * 1e3, scalar * 1e3);
+    }
+
+    /**
+     * @brief Product of two `limbs` x 32-bit numbers
+     */
+    template <adaptive::techn_t TTECH>
+    void bench_bignum(size_t limbs) {
+        adaptive::adaptive_vector<uint32_t, TTECH> a(limbs), b(limbs), c;
+        std::mt19937 g(7);
+        for(size_t i = 0; i < limbs; ++i) { a[i] = g(); b[i] = g(); }
+
+        double t = best_of(3, [&]() { adaptive::bignum_multiply(a, b, c); });
+        record<uint32_t, TTECH>("bignum_multiply", limbs, 0);
+        std::printf("bignum %-9zu %-6s  %8.3f ms\n", limbs, adaptive::technt2string(TTECH).c_str(), t * 1e3);
+    }
+
+    /**
+     * @brief Element-wise gcd and lcm of random pairs with a common factor against the `std::gcd` loop
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_gcd(size_t n) {
+        adaptive::adaptive_vector<TINT, TTECH> a(n), b(n), c;
+        std::vector<TINT> ref(n);
+        std::mt19937_64 g(8);
+        for(size_t i = 0; i < n; ++i) {
+            const TINT f = TINT(g() % 1000 + 1);
+            a[i] = TINT(f * TINT(g() >> (74 - 8 * sizeof(TINT))));
+            b[i] = TINT(f * TINT(g() >> (74 - 8 * sizeof(TINT))));
+        }
+
+        double kgcd = best_of(5, [&]() { adaptive::gcd(a, b, c); });
+        record<TINT, TTECH>("gcd", n, 3.0 * n * sizeof(TINT));
+        double sgcd = best_of(5, [&]() {
+            for(size_t i = 0; i < n; ++i) ref[i] = std::gcd(TINT(a[i]), TINT(b[i]));
+        });
+        double klcm = best_of(5, [&]() { adaptive::lcm(a, b, c); });
+        record<TINT, TTECH>("lcm", n, 3.0 * n * sizeof(TINT));
+        double slcm = best_of(5, [&]() {
+            for(size_t i = 0; i < n; ++i) ref[i] = std::lcm(TINT(a[i]), TINT(b[i]));
+        });
+        std::printf("gcd%-2zu %-9zu %-6s  gcd %8.2f Mop/s (std %6.2f)  lcm %8.2f Mop/s (std %6.2f)\n", sizeof(TINT) * 8, n,
+                    adaptive::technt2string(TTECH).c_str(), n / kgcd * 1e-6, n / sgcd * 1e-6,
+                    n / klcm * 1e-6, n / slcm * 1e-6);
+    }
+
+    /**
+     * @brief Element-wise ilog2, ilog10, isqrt and ipow against the scalar kernels
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_intmath(size_t n) {
+        adaptive::adaptive_vector<TINT, TTECH> a(n), c;
+        adaptive::adaptive_vector<TINT, adaptive::techn_t::Scalar> sa(n), sc;
+        std::mt19937_64 g(9);
+        for(size_t i = 0; i < n; ++i) sa[i] = a[i] = TINT(g() >> (g() % (8 * sizeof(TINT))));
+
+        constexpr adaptive::techn_t scalar = adaptive::techn_t::Scalar;
+        const double bytes = 2.0 * n * sizeof(TINT);
+        const double k[4] = {
+            measure<TINT, TTECH>("ilog2", n, bytes, 5, [&]() { adaptive::ilog2(a, c); }),
+            measure<TINT, TTECH>("ilog10", n, bytes, 5, [&]() { adaptive::ilog10(a, c); }),
+            measure<TINT, TTECH>("isqrt", n, bytes, 5, [&]() { adaptive::isqrt(a, c); }),
+            measure<TINT, TTECH>("ipow5", n, bytes, 5, [&]() { adaptive::ipow(a, 5, c); })
+        };
+        const double s[4] = {
+            measure<TINT, scalar>("ilog2", n, bytes, 5, [&]() { adaptive::ilog2(sa, sc); }),
+            measure<TINT, scalar>("ilog10", n, bytes, 5, [&]() { adaptive::ilog10(sa, sc); }),
+            measure<TINT, scalar>("isqrt", n, bytes, 5, [&]() { adaptive::isqrt(sa, sc); }),
+            measure<TINT, scalar>("ipow5", n, bytes, 5, [&]() { adaptive::ipow(sa, 5, sc); })
+        };
+        std::printf("intmath%-2zu %-6s  log2 %7.1f  log10 %7.1f  sqrt %7.1f  pow5 %7.1f Mop/s  (Scalar %7.1f %7.1f %7.1f %7.1f)\n",
+                    sizeof(TINT) * 8, adaptive::technt2string(TTECH).c_str(),
+                    n / k[0] * 1e-6, n / k[1] * 1e-6, n / k[2] * 1e-6, n / k[3] * 1e-6,
+                    n / s[0] * 1e-6, n / s[1] * 1e-6, n / s[2] * 1e-6, n / s[3] * 1e-6);
+    }
+
+    /**
+     * @brief Hash plus partition of `n` keys per hash function, scalar against the technique
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_hash(size_t n, uint32_t partitions) {
+        adaptive::adaptive_vector<TINT, TTECH> keys(n), h;
+        adaptive::adaptive_vector<uint32_t, TTECH> part;
+        adaptive::adaptive_vector<TINT, adaptive::techn_t::Scalar> skeys(n), sh;
+        adaptive::adaptive_vector<uint32_t, adaptive::techn_t::Scalar> spart;
+        std::mt19937_64 g(10);
+        for(size_t i = 0; i < n; ++i) skeys[i] = keys[i] = TINT(g());
+
+        const char* names[4] = { "murmur3", "xxhash", "mulshift", "crc32c" };
+        std::printf("hash%-2zu %-6s ", sizeof(TINT) * 8, adaptive::technt2string(TTECH).c_str());
+        for(int f = 0; f < 4; ++f) {
+            const auto fn = adaptive::hash_function(f);
+            const double bytes = double(n) * (2 * sizeof(TINT) + sizeof(uint32_t));
+            double t = best_of(5, [&]() { adaptive::hash_partition(keys, h, part, partitions, fn); });
+            record<TINT, TTECH>(std::string("hash_partition/") + names[f], n, bytes);
+            double st = best_of(5, [&]() { adaptive::hash_partition(skeys, sh, spart, partitions, fn); });
+            record<TINT, adaptive::techn_t::Scalar>(std::string("hash_partition/") + names[f], n, bytes);
+            std::printf(" %s %7.1f (%6.1f)", names[f], n / t * 1e-6, n / st * 1e-6);
+        }
+        std::printf(" Mkey/s (Scalar)\n");
+    }
+
+    /**
+     * @brief Raw and bounded fill of `n` 32-bit words against std::mt19937 and std::uniform_int_distribution
+     */
+    template <adaptive::techn_t TTECH>
+    void bench_random(size_t n) {
+        adaptive::adaptive_vector<uint32_t, TTECH> v(n);
+        std::vector<uint32_t> ref(n);
+        adaptive::random_generator rng(11);
+        std::mt19937 g(11);
+        std::uniform_int_distribution<uint32_t> dice(1, 6);
+
+        double raw = best_of(5, [&]() { rng.fill(v); });
+        record<uint32_t, TTECH>("random/fill", n, 4.0 * n);
+        double sraw = best_of(5, [&]() { for(auto& e : ref) e = g(); });
+        double bounded = best_of(5, [&]() { rng.fill(v, 1u, 6u); });
+        record<uint32_t, TTECH>("random/fill_bounded", n, 4.0 * n);
+        double sbounded = best_of(5, [&]() { for(auto& e : ref) e = dice(g); });
+        std::printf("random %-9zu %-6s  raw %7.2f GB/s (mt19937 %5.2f)  [1,6] %7.1f Mop/s (std %6.1f)\n", n,
+                    adaptive::technt2string(TTECH).c_str(), n * 4 / raw * 1e-9, n * 4 / sraw * 1e-9,
+                    n / bounded * 1e-6, n / sbounded * 1e-6);
+    }
+
+    /**
+     * @brief CRC32C, Adler-32 and Fletcher-32 of a `bytes` buffer, scalar against the technique
+     */
+    template <adaptive::techn_t TTECH>
+    void bench_checksum(size_t bytes) {
+        adaptive::adaptive_vector<uint8_t, TTECH> buf(bytes);
+        adaptive::random_generator(12).fill(buf);
+        volatile uint32_t sink = 0;
+
+        constexpr adaptive::techn_t scalar = adaptive::techn_t::Scalar;
+        const double k[3] = {
+            measure<uint8_t, TTECH>("crc32c", bytes, bytes, 5, [&]() { sink = adaptive::crc32c(buf); }),
+            measure<uint8_t, TTECH>("adler32", bytes, bytes, 5, [&]() { sink = adaptive::adler32(buf); }),
+            measure<uint8_t, TTECH>("fletcher32", bytes, bytes, 5, [&]() { sink = adaptive::fletcher32(buf); })
+        };
+        const double s[3] = {
+            measure<uint8_t, scalar>("crc32c", bytes, bytes, 5, [&]() { sink = adaptive::crc32c<scalar>(buf.data(), bytes); }),
+            measure<uint8_t, scalar>("adler32", bytes, bytes, 5, [&]() { sink = adaptive::adler32<scalar>(buf.data(), bytes); }),
+            measure<uint8_t, scalar>("fletcher32", bytes, bytes, 5, [&]() { sink = adaptive::fletcher32<scalar>(buf.data(), bytes); })
+        };
+        std::printf("checksum %-9zu %-6s  crc32c %6.2f  adler32 %6.2f  fletcher32 %6.2f GB/s  (Scalar %6.2f %6.2f %6.2f)\n",
+                    bytes, adaptive::technt2string(TTECH).c_str(), bytes / k[0] * 1e-9, bytes / k[1] * 1e-9,
+                    bytes / k[2] * 1e-9, bytes / s[0] * 1e-9, bytes / s[1] * 1e-9, bytes / s[2] * 1e-9);
+    }
+
+    /**
+     * @brief argmin and argmax of `n` elements against a branching scalar loop
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_argext(size_t n) {
+        adaptive::adaptive_vector<TINT, TTECH> v(n);
+        adaptive::random_generator(13).fill(v);
+        volatile size_t sink = 0;
+
+        double tmin = measure<TINT, TTECH>("argmin", n, double(n) * sizeof(TINT), 5, [&]() { sink = adaptive::argmin(v).index; });
+        double tmax = measure<TINT, TTECH>("argmax", n, double(n) * sizeof(TINT), 5, [&]() { sink = adaptive::argmax(v).index; });
+        double tloop = best_of(5, [&]() {
+            size_t best = 0;
+            for(size_t i = 1; i < n; ++i) {
+                if(v[i] < v[best]) best = i;
+            }
+            sink = best;
+        });
+        std::printf("argext%-2zu %-9zu %-6s  argmin %8.1f  argmax %8.1f Melem/s  (loop %7.1f)\n", sizeof(TINT) * 8, n,
+                    adaptive::technt2string(TTECH).c_str(), n / tmin * 1e-6, n / tmax * 1e-6, n / tloop * 1e-6);
+    }
+
+    /**
+     * @brief Element-wise abs, min, clamp and avg against the scalar backend
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_elementwise(size_t n) {
+        adaptive::adaptive_vector<TINT, TTECH> a(n), b(n), c;
+        adaptive::adaptive_vector<TINT, adaptive::techn_t::Scalar> sa(n), sb(n), sc;
+        adaptive::random_generator rng(14);
+        rng.fill(a);
+        rng.fill(b);
+        std::copy(a.begin(), a.end(), sa.begin());
+        std::copy(b.begin(), b.end(), sb.begin());
+        const TINT lo = TINT(std::numeric_limits<TINT>::min() / 2), hi = TINT(std::numeric_limits<TINT>::max() / 2);
+
+        constexpr adaptive::techn_t scalar = adaptive::techn_t::Scalar;
+        const double unary = 2.0 * n * sizeof(TINT), binary = 3.0 * n * sizeof(TINT);
+        const double k[4] = {
+            measure<TINT, TTECH>("abs", n, unary, 5, [&]() { adaptive::abs(a, c); }),
+            measure<TINT, TTECH>("min", n, binary, 5, [&]() { adaptive::min(a, b, c); }),
+            measure<TINT, TTECH>("clamp", n, unary, 5, [&]() { adaptive::clamp(a, lo, hi, c); }),
+            measure<TINT, TTECH>("avg", n, binary, 5, [&]() { adaptive::avg(a, b, c); })
+        };
+        const double s[4] = {
+            measure<TINT, scalar>("abs", n, unary, 5, [&]() { adaptive::abs(sa, sc); }),
+            measure<TINT, scalar>("min", n, binary, 5, [&]() { adaptive::min(sa, sb, sc); }),
+            measure<TINT, scalar>("clamp", n, unary, 5, [&]() { adaptive::clamp(sa, lo, hi, sc); }),
+            measure<TINT, scalar>("avg", n, binary, 5, [&]() { adaptive::avg(sa, sb, sc); })
+        };
+        std::printf("elementwise%-2zu %-6s  abs %7.1f  min %7.1f  clamp %7.1f  avg %7.1f Melem/s  (Scalar %7.1f %7.1f %7.1f %7.1f)\n",
+                    sizeof(TINT) * 8, adaptive::technt2string(TTECH).c_str(),
+                    n / k[0] * 1e-6, n / k[1] * 1e-6, n / k[2] * 1e-6, n / k[3] * 1e-6,
+                    n / s[0] * 1e-6, n / s[1] * 1e-6, n / s[2] * 1e-6, n / s[3] * 1e-6);
+    }
+
+    /**
+     * @brief Increments per second of one shared atomic and of a sharded counter from 1 to 4x the hardware threads
+     */
+    void bench_counter(size_t increments) {
+        const size_t max_threads = 4 * std::max<size_t>(1, std::thread::hardware_concurrency());
+        for(size_t t = 1; t <= max_threads; t *= 2) {
+            auto run = [t, increments](const char* kernel, auto& counter) {
+                const double _result = best_of(3, [&]() {
+                    std::vector<std::thread> threads;
+                    for(size_t i = 0; i < t; ++i)
+                        threads.emplace_back([&]() { for(size_t k = 0; k < increments; ++k) counter += 1; });
+                    for(auto& th : threads) th.join();
+                });
+                record<uint64_t, adaptive::techn_t::Scalar>(kernel, t * increments, 0, t);
+                return _result;
+            };
+            adaptive::adaptive_atomic<uint64_t> shared;
+            adaptive::sharded_counter<uint64_t> sharded;
+            const double ts = run("counter/atomic", shared), tc = run("counter/sharded", sharded);
+            std::printf("counter threads %3zu  atomic %8.1f  sharded %8.1f Minc/s\n", t,
+                        t * increments / ts * 1e-6, t * increments / tc * 1e-6);
+        }
+    }
+
+    /**
+     * @brief Prefix sum bandwidth, std::inclusive_scan, the SIMD kernel and the parallel scan from 1 to all hardware threads
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_scan(size_t n) {
+        adaptive::adaptive_vector<TINT, TTECH> a(n), out(n);
+        for(size_t i = 0; i < n; ++i) a[i] = TINT(i & 7);
+        const double bytes = 2.0 * n * sizeof(TINT);
+        const double tstd = best_of(3, [&]() { std::inclusive_scan(a.begin(), a.end(), out.begin()); });
+        const double tsimd = best_of(3, [&]() { adaptive::inclusive_scan(a, out); });
+        record<TINT, TTECH>("inclusive_scan", n, bytes);
+        std::printf("scan%-2zu %-6s  %zu elements  std %6.2f GB/s  simd %6.2f GB/s\n", sizeof(TINT) * 8,
+                    adaptive::technt2string(TTECH).c_str(), n, bytes / tstd * 1e-9, bytes / tsimd * 1e-9);
+
+        const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for(size_t t = 2; t <= max_threads; t = (t < max_threads && t * 2 > max_threads) ? max_threads : t * 2) {
+            adaptive::thread_pool pool(t);
+            const double tp = best_of(3, [&]() { adaptive::inclusive_scan(a, out, pool); });
+            record<TINT, TTECH>("inclusive_scan", n, bytes, t);
+            std::printf("  threads %3zu  %6.2f GB/s  speedup %5.2fx\n", t, bytes / tp * 1e-9, tsimd / tp);
+        }
+    }
+
+    /**
+     * @brief `clamp(max(a - b, c), 0, 1000)` and `(a - b) + c` op by op against one fused graph
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_graph(size_t n) {
+        using vector_type = adaptive::adaptive_vector<TINT, TTECH>;
+        vector_type a(n), b(n), c(n), t(n), m(n), out1(n), out2(n);
+        for(size_t i = 0; i < n; ++i) { a[i] = TINT(i * 7 % 2001); b[i] = TINT(i % 1000); c[i] = TINT(i % 13); }
+        const double bytes = 5.0 * n * sizeof(TINT);
+
+        const double tops = best_of(3, [&]() {
+            for(size_t i = 0; i < n; ++i) t[i] = TINT(a[i] - b[i]);
+            adaptive::max(t, c, m);
+            adaptive::clamp(m, 0, 1000, out1);
+            for(size_t i = 0; i < n; ++i) out2[i] = TINT(t[i] + c[i]);
+        });
+        adaptive::expr_graph<TINT, TTECH> g;
+        auto ea = g.input(a), eb = g.input(b), ec = g.input(c);
+        g.output(g.clamp(g.max(ea - eb, ec), 0, 1000), out1);
+        g.output((ea - eb) + ec, out2);
+        const double tgraph = best_of(3, [&]() { g.run(); });
+        record<TINT, TTECH>("expr_graph/fused", n, bytes).counters.emplace_back("nodes", double(g.nodes()));
+        std::printf("graph%-2zu %-6s  %zu elements  %zu nodes  op by op %6.2f GB/s  fused %6.2f GB/s\n", sizeof(TINT) * 8,
+                    adaptive::technt2string(TTECH).c_str(), n, g.nodes(), bytes / tops * 1e-9, bytes / tgraph * 1e-9);
+
+        const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for(size_t th = 2; th <= max_threads; th = (th < max_threads && th * 2 > max_threads) ? max_threads : th * 2) {
+            adaptive::thread_pool pool(th);
+            const double tp = best_of(3, [&]() { g.run(pool); });
+            record<TINT, TTECH>("expr_graph/fused", n, bytes, th).counters.emplace_back("nodes", double(g.nodes()));
+            std::printf("  threads %3zu  %6.2f GB/s  speedup %5.2fx\n", th, bytes / tp * 1e-9, tgraph / tp);
+        }
+    }
+
+    /**
+     * @brief Mean and run to run variation of a GEMM for each thread placement
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_affinity(size_t n, size_t runs) {
+        adaptive::adaptive_matrix<TINT, TTECH> a(n, n), b(n, n), c;
+        fill_random(a, 1);
+        fill_random(b, 2);
+
+        const struct { const char* name; adaptive::thread_placement placement; bool avoid_smt; } configs[] = {
+            { "none", adaptive::thread_placement::none, false },
+            { "compact", adaptive::thread_placement::compact, false },
+            { "compact/no-smt", adaptive::thread_placement::compact, true },
+            { "scatter", adaptive::thread_placement::scatter, false },
+        };
+        std::printf("affinity gemm %zux%zu %-6s  %zu runs\n", n, n, adaptive::technt2string(TTECH).c_str(), runs);
+        for(const auto& config : configs) {
+            // On a thread of its own, so pinning the caller does not outlive the measurement.
+            std::thread([&]() {
+                adaptive::thread_affinity affinity;
+                affinity.placement = config.placement;
+                affinity.avoid_smt = config.avoid_smt;
+                adaptive::thread_pool pool(0, affinity);
+                pool.pin_caller();
+
+                std::vector<double> times(runs);
+                adaptive::gemm(a, b, c, pool);
+                // One timed run per sample, best_of would keep the fastest of --repeats runs.
+                for(auto& t : times) {
+                    const auto t0 = clock_type::now();
+                    adaptive::gemm(a, b, c, pool);
+                    t = std::chrono::duration<double>(clock_type::now() - t0).count();
+                }
+                last_samples() = times;
+                record<TINT, TTECH>(std::string("gemm_placement/") + config.name, n * n, 0, pool.size());
+                const double mean = std::accumulate(times.begin(), times.end(), 0.0) / double(runs);
+                double var = 0;
+                for(double t : times) var += (t - mean) * (t - mean);
+                const double cv = std::sqrt(var / double(runs > 1 ? runs - 1 : 1)) / mean;
+                size_t pinned = 0;
+                for(int cpu : pool.placement()) pinned += cpu >= 0;
+                std::printf("  %-15s %3zu/%-3zu pinned  mean %9.3f ms  cv %6.2f %%\n", config.name, pinned, pool.size(),
+                            mean * 1e3, cv * 100.0);
+            }).join();
+        }
+    }
+
+    /**
+     * @brief Nanoseconds per element handed from one thread to another through a ring
+     */
+    template <typename TRING>
+    double ring_handoff(size_t items) {
+        TRING ring(256);
+        const auto t0 = std::chrono::steady_clock::now();
+        std::thread consumer([&]() {
+            adaptive::spin_backoff b;
+            size_t v;
+            for(size_t k = 0; k < items; ) {
+                if(ring.try_pop(v)) { ++k; b.reset(); }
+                else b.pause();
+            }
+        });
+        adaptive::spin_backoff b;
+        for(size_t k = 0; k < items; ) {
+            if(ring.try_push(k)) { ++k; b.reset(); }
+            else b.pause();
+        }
+        consumer.join();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() / items * 1e9;
+    }
+
+    /**
+     * @brief Ring hand-off cost and the chunk rate of a three step pipeline
+     */
+    template <typename TINT, adaptive::techn_t TTECH>
+    void bench_pipeline(size_t chunk_size, size_t chunks) {
+        std::printf("ring spsc %6.1f ns/item  mpmc %6.1f ns/item\n",
+                    ring_handoff<adaptive::spsc_ring<size_t> >(1 << 22), ring_handoff<adaptive::mpmc_ring<size_t> >(1 << 22));
+
+        adaptive::pipeline<TINT, TTECH> p(chunk_size, 16);
+        size_t produced = 0;
+        uint64_t total = 0;
+        p.source([&](auto& c) {
+            std::fill(c.data.begin(), c.data.end(), TINT(produced & 0x7f));
+            c.size = c.capacity();
+            return ++produced <= chunks;
+        });
+        p.stage([](auto& c) { adaptive::clamp(c.data, TINT(8), TINT(100), c.data); });
+        p.sink([&](auto& c) { total += c.data[0]; });
+        const double t = best_of(3, [&]() { produced = 0; p.run(); });
+        record<TINT, TTECH>("pipeline/clamp", chunks * chunk_size, 2.0 * chunks * chunk_size * sizeof(TINT), 3);
+        std::printf("pipeline %-6s  %zu x %zu elements  %8.0f chunks/s  %6.2f GB/s  (%llu)\n", adaptive::technt2string(TTECH).c_str(),
+                    chunks, chunk_size, chunks / t, chunks * chunk_size * sizeof(TINT) / t * 1e-9, (unsigned long long)total);
+    }
+
+    /**
+     * @brief Allocation time and parallel read bandwidth of an array per NUMA policy
+     */
+    template <adaptive::numa_policy TNUMA>
+    void bench_numa_policy(const char* name, size_t n) {
+        using vector_type = std::vector<uint64_t, adaptive::numa_allocator<uint64_t, TNUMA> >;
+        const size_t threads = adaptive::thread_pool::instance().size();
+        std::vector<uint64_t> sums(threads);
+        double talloc = best_of(3, [&]() { vector_type v(n); });
+        vector_type v(n, 1);
+        double tread = best_of(5, [&]() {
+            adaptive::internal::parallel_for(0, n, threads, [&](size_t chunk, size_t begin, size_t end) {
+                sums[chunk] = std::accumulate(v.begin() + begin, v.begin() + end, uint64_t(0));
+            });
+        });
+        record<uint64_t, adaptive::techn_t::Scalar>(std::string("numa_read/") + name, n, double(n) * sizeof(uint64_t), threads);
+        std::printf("numa %-11s %zu nodes  alloc %8.2f ms  read %7.2f GB/s  (sum %llu)\n", name, adaptive::numa_nodes(),
+                    talloc * 1e3, n * sizeof(uint64_t) / tread * 1e-9,
+                    (unsigned long long)std::accumulate(sums.begin(), sums.end(), uint64_t(0)));
+    }
+}
+
+int main(int argc, char** argv) {
+#ifdef __AVX2__
+    constexpr adaptive::techn_t tech = adaptive::techn_t::AVX;
+#else
+    constexpr adaptive::techn_t tech = adaptive::techn_t::Scalar;
+#endif
+    for(int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if(std::strcmp(argv[i], "--json") == 0 && has_value) options().json = argv[++i];
+        else if(std::strcmp(argv[i], "--repeats") == 0 && has_value) options().repeats = std::strtoul(argv[++i], nullptr, 10);
+        else if(std::strcmp(argv[i], "--filter") == 0 && has_value) options().filter = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: %s [--json file] [--repeats n] [--filter group]\n", argv[0]);
+            return 2;
+        }
+    }
+    if(!options().json.empty()) options().repeats = std::max<size_t>(options().repeats, 10);
+
+    if(selected("gemm")) {
+        bench_gemm_scaling<int32_t, tech>("square", 1024, 1024, 1024);
+        bench_gemm_scaling<int32_t, tech>("tall-skinny", 65536, 64, 64);
+        bench_gemm_scaling<int16_t, tech>("square", 1024, 1024, 1024);
+    }
+    if(selected("spmv")) {
+        bench_spmv<int32_t, tech>(1 << 18, 1 << 18, 32);
+        bench_spmv<int64_t, tech>(1 << 18, 1 << 18, 32);
+        bench_spmv<int32_t, tech>(1 << 20, 1 << 20, 4);
+    }
+    if(selected("qgemm")) {
+        bench_qgemm<tech>(512, 512, 512);
+        bench_qgemm<tech>(4096, 256, 64);
+    }
+    if(selected("layout")) bench_layouts<int32_t, tech>(2048);
+    if(selected("stencil")) {
+        bench_stencil<uint8_t, uint8_t, tech>("gaussian3", adaptive::conv_filter<3>::gaussian(), 4096, 4096);
+        bench_stencil<uint8_t, uint8_t, tech>("gaussian5", adaptive::conv_filter<5>::gaussian(), 4096, 4096);
+        bench_stencil<uint8_t, int16_t, tech>("sobel3", adaptive::conv_filter<3>::sobel_x(), 4096, 4096);
+        bench_stencil<uint8_t, uint8_t, tech>("sharpen3", adaptive::conv_filter<3>({ 0, -1, 0, -1, 5, -1, 0, -1, 0 }), 4096, 4096);
+        bench_stencil<int16_t, int16_t, tech>("gaussian5", adaptive::conv_filter<5>::gaussian(), 4096, 4096);
+    }
+    if(selected("small_matrix")) bench_small_matrix<int32_t, tech>(1 << 20);
+    if(selected("mod")) {
+        bench_mod<tech>(998244353, 1 << 22);
+        bench_mod<tech>(1000, 1 << 22);
+    }
+    if(selected("ntt")) {
+        bench_ntt<uint32_t, tech>(1 << 20);
+        bench_ntt<uint64_t, tech>(1 << 20);
+    }
+    if(selected("bignum")) bench_bignum<tech>(1 << 16);
+    if(selected("gcd")) {
+        bench_gcd<uint32_t, tech>(1 << 20);
+        bench_gcd<uint64_t, tech>(1 << 20);
+    }
+    if(selected("intmath")) {
+        bench_intmath<uint32_t, tech>(1 << 22);
+        bench_intmath<uint64_t, tech>(1 << 22);
+    }
+    if(selected("hash")) {
+        bench_hash<uint32_t, tech>(1 << 16, 64);
+        bench_hash<uint64_t, tech>(1 << 16, 64);
+    }
+    if(selected("random")) bench_random<tech>(1 << 16);
+    if(selected("checksum")) {
+        bench_checksum<tech>(1 << 16);
+        bench_checksum<tech>(1 << 24);
+    }
+    if(selected("argext")) {
+        bench_argext<int8_t, tech>(1 << 16);
+        bench_argext<int32_t, tech>(1 << 16);
+        bench_argext<uint64_t, tech>(1 << 16);
+    }
+    if(selected("elementwise")) {
+        bench_elementwise<int8_t, tech>(1 << 16);
+        bench_elementwise<int64_t, tech>(1 << 16);
+    }
+    if(selected("scan")) {
+        bench_scan<uint32_t, tech>(1 << 26);
+        bench_scan<uint64_t, tech>(1 << 26);
+    }
+    if(selected("graph")) bench_graph<int32_t, tech>(1 << 24);
+    if(selected("affinity")) bench_affinity<int32_t, tech>(512, 15);
+    if(selected("counter")) bench_counter(1 << 20);
+    if(selected("pipeline")) bench_pipeline<uint8_t, tech>(1 << 16, 4096);
+    if(selected("numa")) {
+        bench_numa_policy<adaptive::numa_policy::none>("none", 1 << 26);
+        bench_numa_policy<adaptive::numa_policy::interleave>("interleave", 1 << 26);
+        bench_numa_policy<adaptive::numa_policy::first_touch>("first_touch", 1 << 26);
+    }
+
+    if(!options().json.empty() && !write_json(options().json)) {
+        std::fprintf(stderr, "cannot write %s\n", options().json.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file compare.cpp
+ * @brief Compares two JSON reports of the benchmark and flags significant slowdowns.
+ *
+ * Build and run (from the repository root):
+ * @code
+ * g++ -std=c++17 -O2 examples/benchmark/compare.cpp -o adaptive_compare
+ * ./adaptive_bench --json baseline.json            # with the old version
+ * ./adaptive_bench --json current.json             # with the new version
+ * ./adaptive_compare baseline.json current.json [--confidence 0.95] [--threshold 0.03]
+ * @endcode
+ *
+ * The measurements are matched by kernel, type, technique, size and threads. For every
+ * pair the tool computes Welch's confidence interval of the difference of the mean run
+ * times; a kernel is slower only if the whole interval lies above `threshold` times the
+ * baseline mean, so noise and changes below the threshold are not reported. The exit
+ * code is 1 if a kernel got slower, 2 on bad input and 0 otherwise.
+ *
+ * A report holds a few hundred measurements; at 95% each, a handful of unchanged kernels
+ * would be flagged by chance in every comparison. The intervals are Bonferroni corrected
+ * instead: each one is taken at `1 - (1 - confidence) / m` for the `m` compared pairs, so
+ * `confidence` is the probability that no unchanged kernel is flagged at all.
+ *
+ * The model treats the runs of a measurement as independent. Runs in one process are
+ * not quite: clock frequency, page placement and code alignment are shared by all of
+ * them, so the intervals are narrower than the spread between processes, which the
+ * `threshold` has to absorb. Confirm a flagged kernel with a fresh pair of reports.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_stats.h"
+
+namespace {
+    /**
+     * @brief A parsed JSON value, just enough for the benchmark reports
+     */
+    struct json_value {
+        enum class kind { Null, Bool, Number, String, Array, Object };
+
+        kind type = kind::Null;
+        bool boolean = false;
+        double number = 0;
+        std::string string;
+        std::vector<json_value> array;
+        std::vector<std::pair<std::string, json_value> > object;
+
+        const json_value* find(const char* key) const {
+            for(const auto& m : object) if(m.first == key) return &m.second;
+            return nullptr;
+        }
+    };
+
+    /**
+     * @class json_parser
+     * @brief A recursive descent parser over a whole file
+     */
+    class json_parser {
+    public:
+        explicit json_parser(const std::string& text)
+            : m_strText(text), m_szPos(0) { }
+
+        json_value parse() {
+            json_value _result = value();
+            skip();
+            if(m_szPos != m_strText.size()) fail("trailing characters");
+            return _result;
+        }
+
+    protected:
+        [[noreturn]] void fail(const char* what) const {
+            throw std::runtime_error(std::string("json: ") + what + " at offset " + std::to_string(m_szPos));
+        }
+        void skip() {
+            while(m_szPos < m_strText.size() && std::strchr(" \t\r\n", m_strText[m_szPos]) != nullptr) ++m_szPos;
+        }
+        bool consume(char c) {
+            skip();
+            if(m_szPos < m_strText.size() && m_strText[m_szPos] == c) { ++m_szPos; return true; }
+            return false;
+        }
+        void expect(char c) {
+            if(!consume(c)) fail("unexpected character");
+        }
+        bool literal(const char* word) {
+            const size_t n = std::strlen(word);
+            if(m_strText.compare(m_szPos, n, word) != 0) return false;
+            m_szPos += n;
+            return true;
+        }
+
+        std::string string() {
+            expect('"');
+            std::string _result;
+            while(m_szPos < m_strText.size() && m_strText[m_szPos] != '"') {
+                char c = m_strText[m_szPos++];
+                if(c == '\\') {
+                    if(m_szPos >= m_strText.size()) break;
+                    c = m_strText[m_szPos++];
+                    if(c == 'n') c = '\n';
+                    else if(c == 't') c = '\t';
+                    else if(c == 'u') { m_szPos += 4; c = '?'; }
+                }
+                _result += c;
+            }
+            expect('"');
+            return _result;
+        }
+
+        json_value value() {
+            skip();
+            if(m_szPos >= m_strText.size()) fail("unexpected end");
+            json_value _result;
+            const char c = m_strText[m_szPos];
+            if(c == '{') {
+                ++m_szPos;
+                _result.type = json_value::kind::Object;
+                if(consume('}')) return _result;
+                do {
+                    std::string key = string();
+                    expect(':');
+                    _result.object.emplace_back(std::move(key), value());
+                } while(consume(','));
+                expect('}');
+            } else if(c == '[') {
+                ++m_szPos;
+                _result.type = json_value::kind::Array;
+                if(consume(']')) return _result;
+                do _result.array.push_back(value()); while(consume(','));
+                expect(']');
+            } else if(c == '"') {
+                _result.type = json_value::kind::String;
+                _result.string = string();
+            } else if(literal("true")) {
+                _result.type = json_value::kind::Bool;
+                _result.boolean = true;
+            } else if(literal("false")) {
+                _result.type = json_value::kind::Bool;
+            } else if(literal("null")) {
+                _result.type = json_value::kind::Null;
+            } else {
+                char* end = nullptr;
+                _result.type = json_value::kind::Number;
+                _result.number = std::strtod(m_strText.c_str() + m_szPos, &end);
+                if(end == m_strText.c_str() + m_szPos) fail("invalid value");
+                m_szPos = size_t(end - m_strText.c_str());
+            }
+            return _result;
+        }
+
+    protected:
+        const std::string& m_strText;
+        size_t m_szPos;
+    };
+
+    /**
+     * @brief The run times of one measurement of a report
+     */
+    struct measurement {
+        std::string name;
+        std::vector<double> samples;
+    };
+
+    /**
+     * @brief Reads the measurements of a report, keyed by kernel, type, technique, size and threads
+     *
+     * @throw std::runtime_error if two measurements have the same key
+     */
+    std::map<std::string, measurement> load(const char* path) {
+        std::FILE* f = std::fopen(path, "rb");
+        if(f == nullptr) throw std::runtime_error(std::string("cannot open ") + path);
+        std::string _text;
+        char _buffer[1 << 16];
+        size_t n;
+        while((n = std::fread(_buffer, 1, sizeof(_buffer), f)) > 0) _text.append(_buffer, n);
+        std::fclose(f);
+
+        const json_value root = json_parser(_text).parse();
+        const json_value* results = root.find("results");
+        if(results == nullptr || results->type != json_value::kind::Array)
+            throw std::runtime_error(std::string(path) + ": no results array");
+
+        std::map<std::string, measurement> _result;
+        for(const json_value& r : results->array) {
+            const json_value* kernel = r.find("kernel");
+            const json_value* type = r.find("type");
+            const json_value* tech = r.find("technique");
+            const json_value* size = r.find("size");
+            const json_value* threads = r.find("threads");
+            const json_value* samples = r.find("samples_ns");
+            if(kernel == nullptr || type == nullptr || tech == nullptr || size == nullptr || threads == nullptr || samples == nullptr)
+                throw std::runtime_error(std::string(path) + ": incomplete result");
+
+            measurement m;
+            m.name = kernel->string + " " + type->string + " " + tech->string + " n=" +
+                     std::to_string((unsigned long long)size->number) + " t=" + std::to_string((unsigned long long)threads->number);
+            for(const json_value& s : samples->array) m.samples.push_back(s.number);
+            if(_result.count(m.name) != 0) throw std::runtime_error(std::string(path) + ": duplicate measurement " + m.name);
+            _result.emplace(m.name, std::move(m));
+        }
+        return _result;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2] = { nullptr, nullptr };
+    double confidence = 0.95, threshold = 0.03;
+    size_t _files = 0;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--confidence") == 0 && i + 1 < argc) confidence = std::atof(argv[++i]);
+        else if(std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = std::atof(argv[++i]);
+        else if(_files < 2 && argv[i][0] != '-') paths[_files++] = argv[i];
+        else _files = 3;
+    }
+    if(_files != 2 || confidence <= 0.0 || confidence >= 1.0 || threshold < 0.0) {
+        std::fprintf(stderr, "usage: %s baseline.json current.json [--confidence 0.95] [--threshold 0.03]\n", argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, measurement> baseline, current;
+    try {
+        baseline = load(paths[0]);
+        current = load(paths[1]);
+    } catch(const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    size_t tested = 0;
+    for(const auto& b : baseline) {
+        auto it = current.find(b.first);
+        if(it != current.end() && b.second.samples.size() >= 2 && it->second.samples.size() >= 2) ++tested;
+    }
+    const double per_pair = 1.0 - (1.0 - confidence) / double(tested > 0 ? tested : 1);
+
+    size_t slower = 0, faster = 0, compared = 0;
+    std::printf("%-52s %12s %12s %8s  %-19s\n", "measurement", "base ns", "current ns", "change",
+                "interval");
+    for(const auto& b : baseline) {
+        auto it = current.find(b.first);
+        if(it == current.end()) {
+            std::printf("%-52s %12s\n", b.first.c_str(), "missing");
+            continue;
+        }
+        const adaptive_bench::summary sb = adaptive_bench::summarize(b.second.samples, confidence);
+        const adaptive_bench::summary sc = adaptive_bench::summarize(it->second.samples, confidence);
+        const adaptive_bench::difference d = adaptive_bench::welch_interval(sb, sc, per_pair);
+        if(sb.mean <= 0.0) continue;
+        ++compared;
+
+        const char* verdict = "";
+        if(sb.n < 2 || sc.n < 2) verdict = "too few runs";
+        else if(d.low > threshold * sb.mean) { verdict = "SLOWER"; ++slower; }
+        else if(d.high < -threshold * sb.mean) { verdict = "faster"; ++faster; }
+        std::printf("%-52s %12.0f %12.0f %+7.1f%%  [%+6.1f%%, %+6.1f%%]  %s\n", b.first.c_str(), sb.mean, sc.mean,
+                    100.0 * d.diff / sb.mean, 100.0 * d.low / sb.mean, 100.0 * d.high / sb.mean, verdict);
+    }
+    for(const auto& c : current)
+        if(baseline.find(c.first) == baseline.end()) std::printf("%-52s %12s\n", c.first.c_str(), "new");
+
+    std::printf("\n%zu compared, %zu slower, %zu faster at %.0f%% confidence (%.4g%% per pair) and a %.1f%% threshold\n",
+                compared, slower, faster, confidence * 100.0, per_pair * 100.0, threshold * 100.0);
+    return slower != 0 ? 1 : 0;
+}
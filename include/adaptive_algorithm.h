@@ -0,0 +1,71 @@
+/**
+ * @file adaptive_algorithm.h
+ * @brief Header file for reductions over adaptive vectors that report a position.
+ *
+ * This file defines `argmin` and `argmax`, which return the smallest or largest element
+ * of an integer `adaptive_vector` together with its index, like `std::min_element`
+ * and `std::max_element`. The SSE/AVX kernels track an index per lane next to the value
+ * and update both with compare and blend instead of a branch per element; ties go to
+ * the first occurrence on every technique.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_ALGORITHM__
+#define __ADAPTIVE_ALGORITHM__ 1
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adaptive_vector.h>
+
+#include <internal/kernel_argext.h>
+
+namespace adaptive {
+    /**
+     * @brief An extreme element and its index
+     */
+    template <typename TINT>
+    struct arg_result {
+        TINT value;
+        size_t index;
+    };
+
+    /**
+     * @brief The smallest element of `v` and the index of its first occurrence
+     *
+     * @throw std::invalid_argument if `v` is empty
+     *
+     * Example usage:
+     * @code
+     * auto m = adaptive::argmin(distances);
+     * nearest = m.index;
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    arg_result<TINT> argmin(const adaptive_vector<TINT, TTECH>& v) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "argmin: integer type required");
+        if(v.size() == 0) throw std::invalid_argument("argmin: vector is empty");
+        const size_t i = internal::argext_kernel<TINT, TTECH>::template find<false>(v.data(), v.size());
+        return arg_result<TINT>{ v.data()[i], i };
+    }
+    /**
+     * @brief The largest element of `v` and the index of its first occurrence
+     *
+     * @throw std::invalid_argument if `v` is empty
+     */
+    template <typename TINT, techn_t TTECH>
+    arg_result<TINT> argmax(const adaptive_vector<TINT, TTECH>& v) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "argmax: integer type required");
+        if(v.size() == 0) throw std::invalid_argument("argmax: vector is empty");
+        const size_t i = internal::argext_kernel<TINT, TTECH>::template find<true>(v.data(), v.size());
+        return arg_result<TINT>{ v.data()[i], i };
+    }
+}
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * @file adaptive_async.h
+ * @brief Header file for chunked, cancellable batch operations that do not block the caller.
+ *
+ * This file defines two ways to run a large array operation without stalling the thread
+ * of an event loop or coroutine executor. `chunked_job` splits the operation into chunks
+ * and runs one per `step`, so a cooperative scheduler can yield between them:
+ *
+ * @code
+ * adaptive::chunked_job job(v.size(), 1 << 16, [&](size_t b, size_t e) { work(b, e); });
+ * while(job.step()) co_await executor.yield();
+ * @endcode
+ *
+ * With C++20 coroutines, `async_for` and the `async_` versions of the element-wise
+ * kernels return an awaitable that hands the chunks to the `thread_pool` and resumes
+ * the awaiting coroutine on the worker that finishes the last one:
+ *
+ * @code
+ * adaptive::cancel_token cancel;
+ * if(co_await adaptive::async_gcd(num, den, g, cancel) == adaptive::async_status::cancelled) co_return;
+ * @endcode
+ *
+ * Cancelling stops chunks that have not started, a chunk that runs finishes; the output
+ * of a cancelled operation is partly written. The first exception of a chunk is rethrown
+ * by the `co_await` once every chunk is done.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_ASYNC__
+#define __ADAPTIVE_ASYNC__ 1
+
+#include <cstddef>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+#include <adaptive_thread_pool.h>
+#include <adaptive_vector.h>
+
+#include <internal/kernel_gcd.h>
+#include <internal/kernel_intmath.h>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define ADAPTIVE_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef ADAPTIVE_ASYNC_CHUNK
+/**
+ * @brief Default elements per chunk, about a tenth of a millisecond of the element-wise kernels
+ */
+#define ADAPTIVE_ASYNC_CHUNK (size_t(1) << 16)
+#endif
+
+namespace adaptive {
+    /**
+     * @brief How an asynchronous operation ended
+     */
+    enum class async_status {
+        completed,
+        cancelled
+    };
+
+    /**
+     * @class cancel_token
+     * @brief A shared flag that asks operations to stop, copies share the flag
+     */
+    class cancel_token {
+    public:
+        cancel_token()
+            : m_pFlag(std::make_shared<std::atomic<bool> >(false)) { }
+
+        /**
+         * @brief Asks every operation holding this token to stop
+         */
+        void cancel() noexcept { m_pFlag->store(true, std::memory_order_release); }
+        bool cancelled() const noexcept { return m_pFlag->load(std::memory_order_acquire); }
+
+    protected:
+        std::shared_ptr<std::atomic<bool> > m_pFlag;
+    };
+
+    /**
+     * @class chunked_job
+     * @brief Runs `fn(begin, end)` over `[0, size)` one chunk per `step`
+     *
+     * @tparam TFUNC The chunk function
+     */
+    template <typename TFUNC>
+    class chunked_job {
+    public:
+        using this_type = chunked_job<TFUNC>;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructor for a job of `size` elements
+         *
+         * @param size The number of elements
+         * @param chunk The elements per step
+         * @param fn The chunk function
+         * @param token Stops the job before the next chunk when cancelled
+         * @throw std::invalid_argument if `chunk` is 0
+         */
+        chunked_job(size_type size, size_type chunk, TFUNC fn, cancel_token token = cancel_token())
+            : m_fn(std::move(fn)), m_tToken(std::move(token)), m_szSize(size), m_szChunk(chunk), m_szDone(0) {
+            if(chunk == 0) throw std::invalid_argument("chunked_job: chunk must not be 0");
+        }
+
+        /**
+         * @brief Runs the next chunk
+         *
+         * @return True if there is work left, false when the job is done or cancelled
+         */
+        bool step() {
+            if(done()) return false;
+            const size_t end = m_szDone + std::min(m_szChunk, m_szSize - m_szDone);
+            m_fn(m_szDone, end);
+            m_szDone = end;
+            return !done();
+        }
+
+        bool done() const noexcept { return m_szDone == m_szSize || cancelled(); }
+        bool cancelled() const noexcept { return m_szDone != m_szSize && m_tToken.cancelled(); }
+        /**
+         * @brief Get the number of elements processed so far
+         */
+        size_type completed() const noexcept { return m_szDone; }
+        async_status status() const noexcept { return cancelled() ? async_status::cancelled : async_status::completed; }
+
+    protected:
+        TFUNC m_fn;
+        cancel_token m_tToken;
+        size_t m_szSize;
+        size_t m_szChunk;
+        size_t m_szDone;
+    };
+
+#ifdef ADAPTIVE_HAS_COROUTINES
+    /**
+     * @class chunked_awaitable
+     * @brief Awaitable that runs `fn(begin, end)` over the chunks of `[0, size)` on a thread pool
+     *
+     * The awaiting coroutine resumes on the pool thread that ran the last chunk, or
+     * without suspending on a pool without worker threads.
+     *
+     * @tparam TFUNC The chunk function
+     */
+    template <typename TFUNC>
+    class chunked_awaitable {
+    public:
+        using this_type = chunked_awaitable<TFUNC>;
+        using size_type = size_t;
+
+        chunked_awaitable(size_type size, size_type chunk, TFUNC fn, cancel_token token, thread_pool& pool)
+            : m_fn(std::move(fn)), m_tToken(std::move(token)), m_pool(pool), m_szSize(size),
+              m_szChunk(chunk), m_atRemaining(0), m_atCancelled(false) {
+            if(chunk == 0) throw std::invalid_argument("async_for: chunk must not be 0");
+        }
+        chunked_awaitable(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        bool await_ready() noexcept {
+            if(m_tToken.cancelled()) m_atCancelled.store(true, std::memory_order_relaxed);
+            return m_szSize == 0 || m_atCancelled.load(std::memory_order_relaxed);
+        }
+        bool await_suspend(std::coroutine_handle<> caller) {
+            const size_t chunks = (m_szSize + m_szChunk - 1) / m_szChunk;
+            if(m_pool.size() == 1) {
+                for(size_t i = 0; i < chunks; ++i) run_chunk(i);
+                return false;
+            }
+
+            // Once the last chunk is queued the caller may resume and destroy this object.
+            m_hCaller = caller;
+            m_atRemaining.store(chunks, std::memory_order_relaxed);
+            thread_pool& pool = m_pool;
+            for(size_t i = 0; i < chunks; ++i) {
+                pool.submit([this, i]() {
+                    run_chunk(i);
+                    const std::coroutine_handle<> h = m_hCaller;
+                    if(m_atRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) h.resume();
+                });
+            }
+            return true;
+        }
+        async_status await_resume() {
+            if(m_error) std::rethrow_exception(m_error);
+            return m_atCancelled.load(std::memory_order_relaxed) ? async_status::cancelled : async_status::completed;
+        }
+
+    protected:
+        void run_chunk(size_t i) noexcept {
+            if(m_tToken.cancelled()) {
+                m_atCancelled.store(true, std::memory_order_relaxed);
+                return;
+            }
+            const size_t begin = i * m_szChunk;
+            try { m_fn(begin, begin + std::min(m_szChunk, m_szSize - begin)); }
+            catch(...) {
+                std::lock_guard<std::mutex> guard(m_mtxError);
+                if(!m_error) m_error = std::current_exception();
+            }
+        }
+
+    protected:
+        TFUNC m_fn;
+        cancel_token m_tToken;
+        thread_pool& m_pool;
+        size_t m_szSize;
+        size_t m_szChunk;
+        std::coroutine_handle<> m_hCaller;
+        std::atomic<size_t> m_atRemaining;
+        std::atomic<bool> m_atCancelled;
+        std::mutex m_mtxError;
+        std::exception_ptr m_error;
+    };
+
+    /**
+     * @brief Awaitable running `fn(begin, end)` over `[0, size)` in chunks on `pool`
+     *
+     * @param size The number of elements
+     * @param chunk The elements per chunk
+     * @param fn The chunk function, called concurrently for different chunks
+     * @param token Skips the chunks that have not started when cancelled
+     * @param pool The pool to run on
+     * @return An awaitable giving the `async_status`
+     */
+    template <typename TFUNC>
+    chunked_awaitable<typename std::decay<TFUNC>::type> async_for(size_t size, size_t chunk, TFUNC&& fn,
+                                                                 cancel_token token = cancel_token(),
+                                                                 thread_pool& pool = thread_pool::instance()) {
+        return chunked_awaitable<typename std::decay<TFUNC>::type>(size, chunk, std::forward<TFUNC>(fn),
+                                                                   std::move(token), pool);
+    }
+
+    /**
+     * @brief Awaitable `gcd(a, b, out)`, `out` is resized before the first chunk
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    auto async_gcd(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+                   adaptive_vector<TINT, TTECH>& out, cancel_token token = cancel_token(),
+                   thread_pool& pool = thread_pool::instance()) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "async_gcd: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("async_gcd: sizes do not match");
+        out.resize(a.size());
+        const TINT* pa = a.data();
+        const TINT* pb = b.data();
+        TINT* po = out.data();
+        return async_for(a.size(), ADAPTIVE_ASYNC_CHUNK, [pa, pb, po](size_t begin, size_t end) {
+            internal::gcd_kernel<TINT, TTECH>::gcd(pa + begin, pb + begin, po + begin, end - begin);
+        }, std::move(token), pool);
+    }
+    /**
+     * @brief Awaitable `lcm(a, b, out)`, `out` is resized before the first chunk
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    auto async_lcm(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+                   adaptive_vector<TINT, TTECH>& out, cancel_token token = cancel_token(),
+                   thread_pool& pool = thread_pool::instance()) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "async_lcm: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("async_lcm: sizes do not match");
+        out.resize(a.size());
+        const TINT* pa = a.data();
+        const TINT* pb = b.data();
+        TINT* po = out.data();
+        return async_for(a.size(), ADAPTIVE_ASYNC_CHUNK, [pa, pb, po](size_t begin, size_t end) {
+            internal::gcd_kernel<TINT, TTECH>::lcm(pa + begin, pb + begin, po + begin, end - begin);
+        }, std::move(token), pool);
+    }
+    /**
+     * @brief Awaitable `isqrt(a, out)`, `out` is resized before the first chunk
+     */
+    template <typename TINT, techn_t TTECH>
+    auto async_isqrt(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out,
+                     cancel_token token = cancel_token(), thread_pool& pool = thread_pool::instance()) {
+        static_assert(std::is_unsigned<TINT>::value, "async_isqrt: unsigned integer type required");
+        out.resize(a.size());
+        const TINT* pa = a.data();
+        TINT* po = out.data();
+        return async_for(a.size(), ADAPTIVE_ASYNC_CHUNK, [pa, po](size_t begin, size_t end) {
+            internal::intmath_kernel<TINT, TTECH>::isqrt(pa + begin, po + begin, end - begin);
+        }, std::move(token), pool);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file adaptive_atomic.h
+ * @brief Header file for lock-free atomic integers and sharded counters.
+ *
+ * This file defines `adaptive_atomic`, an atomic integer with the `std::atomic` operations
+ * plus `fetch_min` and `fetch_max`, and `sharded_counter`, a counter for many writers.
+ * A single atomic that every thread increments keeps its cache line moving between the
+ * cores and stops scaling after a few threads; the sharded counter gives every hardware
+ * thread its own padded slot, adds to it with a relaxed `fetch_add` and only sums the
+ * slots when the value is read:
+ *
+ * @code
+ * adaptive::sharded_counter<uint64_t> requests;
+ * pool.parallel(n, [&](size_t) { ++requests; });   // no shared cache line
+ * uint64_t total = requests.value();
+ * @endcode
+ *
+ * A thread keeps the slot it was given on its first add, slots are handed out round
+ * robin, so up to `shards()` threads never share one. `value` is exact once the writers
+ * are done; while they run it is a sum of slots read one after another, not a snapshot.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_ATOMIC__
+#define __ADAPTIVE_ATOMIC__ 1
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include <adaptive_thread_pool.h>
+
+#ifndef ADAPTIVE_COUNTER_SHARD_ALIGNMENT
+/**
+ * @brief Bytes per counter slot, two cache lines as the spatial prefetcher pulls lines in pairs
+ */
+#define ADAPTIVE_COUNTER_SHARD_ALIGNMENT 128
+#endif
+
+namespace adaptive {
+    /**
+     * @class adaptive_atomic
+     * @brief A lock-free atomic integer with fetch min and max
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_atomic<int64_t> peak(0);
+     * peak.fetch_max(queue_depth, std::memory_order_relaxed);
+     * @endcode
+     *
+     * @tparam TINT The integer type
+     */
+    template <typename TINT>
+    class adaptive_atomic {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value,
+                      "adaptive_atomic: integer type required");
+    public:
+        using this_type = adaptive_atomic<TINT>;
+        using value_type = TINT;
+
+        static constexpr bool is_always_lock_free = std::atomic<TINT>::is_always_lock_free;
+
+        constexpr adaptive_atomic(value_type v = value_type(0)) noexcept
+            : m_atValue(v) { }
+        adaptive_atomic(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return m_atValue.load(order);
+        }
+        void store(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            m_atValue.store(v, order);
+        }
+        value_type exchange(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.exchange(v, order);
+        }
+
+        /**
+         * @brief Stores `desired` if the value is `expected`, otherwise loads the value into `expected`
+         *
+         * @return True if `desired` was stored
+         */
+        bool compare_exchange_strong(value_type& expected, value_type desired,
+                                     std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.compare_exchange_strong(expected, desired, order, failure_order(order));
+        }
+        /**
+         * @brief Like `compare_exchange_strong` but may fail spuriously, for retry loops
+         */
+        bool compare_exchange_weak(value_type& expected, value_type desired,
+                                   std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.compare_exchange_weak(expected, desired, order, failure_order(order));
+        }
+
+        value_type fetch_add(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.fetch_add(v, order);
+        }
+        value_type fetch_sub(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.fetch_sub(v, order);
+        }
+        value_type fetch_and(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.fetch_and(v, order);
+        }
+        value_type fetch_or(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.fetch_or(v, order);
+        }
+        value_type fetch_xor(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return m_atValue.fetch_xor(v, order);
+        }
+
+        /**
+         * @brief Stores the smaller of the value and `v`, returns the previous value
+         *
+         * Only writes when `v` is smaller, so a minimum that is already reached costs a load.
+         */
+        value_type fetch_min(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            value_type _result = m_atValue.load(std::memory_order_relaxed);
+            while(v < _result && !m_atValue.compare_exchange_weak(_result, v, order, std::memory_order_relaxed)) { }
+            return _result;
+        }
+        /**
+         * @brief Stores the larger of the value and `v`, returns the previous value
+         */
+        value_type fetch_max(value_type v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            value_type _result = m_atValue.load(std::memory_order_relaxed);
+            while(_result < v && !m_atValue.compare_exchange_weak(_result, v, order, std::memory_order_relaxed)) { }
+            return _result;
+        }
+
+        operator value_type () const noexcept { return load(); }
+        value_type operator = (value_type v) noexcept { store(v); return v; }
+        value_type operator ++ () noexcept       { return fetch_add(1) + value_type(1); }
+        value_type operator ++ (int) noexcept    { return fetch_add(1); }
+        value_type operator -- () noexcept       { return fetch_sub(1) - value_type(1); }
+        value_type operator -- (int) noexcept    { return fetch_sub(1); }
+        value_type operator += (value_type v) noexcept { return value_type(fetch_add(v) + v); }
+        value_type operator -= (value_type v) noexcept { return value_type(fetch_sub(v) - v); }
+
+    protected:
+        /**
+         * @brief The strongest order a failed compare exchange may have, it does not write
+         */
+        static constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+            return order == std::memory_order_acq_rel ? std::memory_order_acquire
+                 : order == std::memory_order_release ? std::memory_order_relaxed : order;
+        }
+
+    protected:
+        std::atomic<TINT> m_atValue;
+    };
+
+    /**
+     * @class sharded_counter
+     * @brief A counter with one padded slot per hardware thread, summed on read
+     *
+     * Adds are relaxed: the counter counts, it does not order other memory accesses.
+     *
+     * @tparam TINT The integer type
+     */
+    template <typename TINT>
+    class sharded_counter {
+    public:
+        using this_type = sharded_counter<TINT>;
+        using value_type = TINT;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructor for a counter at 0
+         *
+         * @param shards The number of slots, rounded up to a power of two, 0 selects one per hardware thread
+         */
+        explicit sharded_counter(size_type shards = 0)
+            : m_szMask(0) {
+            size_t n = 1;
+            while(n < internal::resolve_threads(shards)) n *= 2;
+            m_pSlots.reset(new slot[n]);
+            m_szMask = n - 1;
+        }
+        sharded_counter(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        /**
+         * @brief Get the number of slots
+         */
+        size_type shards() const noexcept { return m_szMask + 1; }
+
+        void add(value_type v) noexcept {
+            m_pSlots[thread_slot() & m_szMask].value.fetch_add(v, std::memory_order_relaxed);
+        }
+        void sub(value_type v) noexcept {
+            m_pSlots[thread_slot() & m_szMask].value.fetch_sub(v, std::memory_order_relaxed);
+        }
+        this_type& operator ++ () noexcept                { add(value_type(1)); return *this; }
+        this_type& operator -- () noexcept                { sub(value_type(1)); return *this; }
+        this_type& operator += (value_type v) noexcept    { add(v); return *this; }
+        this_type& operator -= (value_type v) noexcept    { sub(v); return *this; }
+
+        /**
+         * @brief Get the sum of the slots
+         */
+        value_type value() const noexcept {
+            value_type _result = value_type(0);
+            for(size_t i = 0; i <= m_szMask; ++i)
+                _result = value_type(_result + m_pSlots[i].value.load(std::memory_order_relaxed));
+            return _result;
+        }
+        operator value_type () const noexcept { return value(); }
+
+        /**
+         * @brief Sets every slot to 0 and returns the sum they had
+         *
+         * Adds that run concurrently are either in the result or stay in the counter.
+         */
+        value_type take() noexcept {
+            value_type _result = value_type(0);
+            for(size_t i = 0; i <= m_szMask; ++i)
+                _result = value_type(_result + m_pSlots[i].value.exchange(value_type(0), std::memory_order_relaxed));
+            return _result;
+        }
+        void reset() noexcept { take(); }
+
+    protected:
+        struct alignas(ADAPTIVE_COUNTER_SHARD_ALIGNMENT) slot {
+            adaptive_atomic<TINT> value;
+        };
+
+        /**
+         * @brief Get the slot number of the calling thread, handed out round robin on first use
+         */
+        static size_t thread_slot() noexcept {
+            static std::atomic<size_t> _next(0);
+            static thread_local size_t _slot = _next.fetch_add(1, std::memory_order_relaxed);
+            return _slot;
+        }
+
+    protected:
+        std::unique_ptr<slot[]> m_pSlots;
+        size_t m_szMask;
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file adaptive_checksum.h
+ * @brief Header file for CRC32C, Adler-32 and Fletcher-32 checksums of buffers.
+ *
+ * This file defines `crc32c`, `adler32` and `fletcher32` of raw byte buffers and of the
+ * storage of an `adaptive_vector`, whose technique selects the kernel: the scalar
+ * technique runs one `crc32` stream, SSE three interleaved streams and AVX folds large
+ * buffers with PCLMULQDQ (when compiled with it); the sums use 16 or 32-byte SIMD steps.
+ * Every technique gives the same value, and each checksum continues from the value of
+ * the previous part of a message:
+ *
+ * @code
+ * uint32_t c = adaptive::crc32c(header, header_bytes);
+ * c = adaptive::crc32c(payload, payload_bytes, c);     // CRC32C of header and payload
+ * @endcode
+ *
+ * The CRC32C is the one of iSCSI and ext4, `crc32c("123456789") == 0xE3069283`. The
+ * Fletcher-32 of a buffer of odd length pads a zero byte, so only buffers of even length
+ * can be continued.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_CHECKSUM__
+#define __ADAPTIVE_CHECKSUM__ 1
+
+#include <cstdint>
+#include <cstddef>
+
+#include <adaptive_vector.h>
+
+#include <internal/kernel_checksum.h>
+
+namespace adaptive {
+    /**
+     * @brief CRC32C of `bytes` bytes at `data`
+     *
+     * @tparam TTECH The technique of the kernel
+     * @param crc The CRC32C of the preceding bytes, 0 for none
+     */
+    template <techn_t TTECH = internal::detected_techniq_used<uint8_t>()>
+    uint32_t crc32c(const void* data, size_t bytes, uint32_t crc = 0) noexcept {
+        return ~internal::checksum_kernel<TTECH>::crc32c(~crc, static_cast<const unsigned char*>(data), bytes);
+    }
+    /**
+     * @brief CRC32C of the storage of `v`
+     */
+    template <typename TINT, techn_t TTECH>
+    uint32_t crc32c(const adaptive_vector<TINT, TTECH>& v, uint32_t crc = 0) noexcept {
+        return crc32c<TTECH>(v.data(), v.size() * sizeof(TINT), crc);
+    }
+
+    /**
+     * @brief Adler-32 of `bytes` bytes at `data`
+     *
+     * @param adler The Adler-32 of the preceding bytes, 1 for none
+     */
+    template <techn_t TTECH = internal::detected_techniq_used<uint8_t>()>
+    uint32_t adler32(const void* data, size_t bytes, uint32_t adler = 1) noexcept {
+        return internal::checksum_kernel<TTECH>::adler32(adler, static_cast<const unsigned char*>(data), bytes);
+    }
+    /**
+     * @brief Adler-32 of the storage of `v`
+     */
+    template <typename TINT, techn_t TTECH>
+    uint32_t adler32(const adaptive_vector<TINT, TTECH>& v, uint32_t adler = 1) noexcept {
+        return adler32<TTECH>(v.data(), v.size() * sizeof(TINT), adler);
+    }
+
+    /**
+     * @brief Fletcher-32 of the little-endian 16-bit words of `bytes` bytes at `data`
+     *
+     * @param fletcher The Fletcher-32 of the preceding words, 0 for none
+     */
+    template <techn_t TTECH = internal::detected_techniq_used<uint8_t>()>
+    uint32_t fletcher32(const void* data, size_t bytes, uint32_t fletcher = 0) noexcept {
+        return internal::checksum_kernel<TTECH>::fletcher32(fletcher, static_cast<const unsigned char*>(data), bytes);
+    }
+    /**
+     * @brief Fletcher-32 of the storage of `v`
+     */
+    template <typename TINT, techn_t TTECH>
+    uint32_t fletcher32(const adaptive_vector<TINT, TTECH>& v, uint32_t fletcher = 0) noexcept {
+        return fletcher32<TTECH>(v.data(), v.size() * sizeof(TINT), fletcher);
+    }
+}
+
+#endif
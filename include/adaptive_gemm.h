@@ -0,0 +1,250 @@
+/**
+ * @file adaptive_gemm.h
+ * @brief Header file for integer matrix multiplication on adaptive matrices.
+ *
+ * This file defines `gemm`, the blocked `C = A * B` for `adaptive_matrix`, in a
+ * single-threaded and a multi-threaded form. `A` is packed once and shared by all
+ * threads; `C` is cut into macro tiles that the work-stealing `thread_pool` hands out,
+ * and each thread packs the `B` panel of its tile into a private buffer sized to stay
+ * in its L2 (`ADAPTIVE_GEMM_L2_BYTES`). The operands may be views or matrices of any
+ * layout; packing reads them in their own layout, so no conversion is made.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_GEMM__
+#define __ADAPTIVE_GEMM__ 1
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include <adaptive_matrix.h>
+#include <adaptive_thread_pool.h>
+
+#include <internal/kernel_gemm.h>
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Packs `mc` rows x `kc` depth of `a`, starting at `(r0, k0)`, see `gemm_pack_a`
+     */
+    template <size_t MR, typename TINT, techn_t TTECH>
+    void gemm_pack_operand_a(const adaptive_matrix_view<const TINT, TTECH>& a, size_t r0, size_t k0,
+                             size_t mc, size_t kc, TINT* dst) {
+        gemm_pack_a<MR>(&a(r0, k0), a.row_stride(), a.col_stride(), mc, kc, dst);
+    }
+    /**
+     * @brief Packs `kc` depth x `nc` columns of `b`, starting at `(k0, j0)`, see `gemm_pack_b`
+     */
+    template <size_t NR, typename TINT, techn_t TTECH>
+    void gemm_pack_operand_b(const adaptive_matrix_view<const TINT, TTECH>& b, size_t k0, size_t j0,
+                             size_t kc, size_t nc, TINT* dst) {
+        gemm_pack_b<NR>(&b(k0, j0), b.row_stride(), b.col_stride(), kc, nc, dst);
+    }
+
+    /**
+     * @brief Packs rows of a matrix of any layout; tiled matrices are packed tile by tile
+     *
+     * A strip of `MR` rows never crosses a tile row, so each strip is packed in pieces
+     * of one tile of depth straight from the contiguous tile rows.
+     */
+    template <size_t MR, typename TINT, techn_t TTECH, layout_t TLAYOUT>
+    void gemm_pack_operand_a(const adaptive_matrix<TINT, TTECH, TLAYOUT>& a, size_t r0, size_t k0,
+                             size_t mc, size_t kc, TINT* dst) {
+        if constexpr (TLAYOUT == layout_t::Tiled) {
+            constexpr size_t T = internal::layout_traits<TLAYOUT, TINT>::tile;
+            static_assert(T % MR == 0, "gemm: the tile edge must be a multiple of the micro kernel rows");
+
+            for(size_t i = 0; i < mc; i += MR, dst += kc * MR) {
+                const size_t r = r0 + i, m = std::min(MR, mc - i);
+                for(size_t k = 0; k < kc; ) {
+                    const size_t kk = k0 + k, seg = std::min(kc - k, T - kk % T);
+                    gemm_pack_a<MR>(&a(r, kk), ptrdiff_t(T), 1, m, seg, dst + k * MR);
+                    k += seg;
+                }
+            }
+        } else {
+            gemm_pack_operand_a<MR>(a.view(), r0, k0, mc, kc, dst);
+        }
+    }
+    /**
+     * @brief Packs columns of a matrix of any layout; tiled matrices are packed tile by tile
+     */
+    template <size_t NR, typename TINT, techn_t TTECH, layout_t TLAYOUT>
+    void gemm_pack_operand_b(const adaptive_matrix<TINT, TTECH, TLAYOUT>& b, size_t k0, size_t j0,
+                             size_t kc, size_t nc, TINT* dst) {
+        if constexpr (TLAYOUT == layout_t::Tiled) {
+            constexpr size_t T = internal::layout_traits<TLAYOUT, TINT>::tile;
+            static_assert(T % NR == 0, "gemm: the tile edge must be a multiple of the micro kernel columns");
+
+            for(size_t j = 0; j < nc; j += NR, dst += kc * NR) {
+                const size_t c = j0 + j, n = std::min(NR, nc - j);
+                for(size_t k = 0; k < kc; ) {
+                    const size_t kk = k0 + k, seg = std::min(kc - k, T - kk % T);
+                    gemm_pack_b<NR>(&b(kk, c), ptrdiff_t(T), 1, seg, n, dst + k * NR);
+                    k += seg;
+                }
+            }
+        } else {
+            gemm_pack_operand_b<NR>(b.view(), k0, j0, kc, nc, dst);
+        }
+    }
+
+    /**
+     * @brief Shared implementation of the single- and multi-threaded `gemm`
+     *
+     * @param a The left hand side, a const view or a matrix of any layout
+     * @param b The right hand side, a const view or a matrix of any layout
+     * @param concurrency The number of threads `run` executes tasks on
+     * @param run Called as `run(tasks, fn)`, must call `fn(i)` for every task `i`
+     */
+    template <typename TINT, techn_t TTECH, typename TA, typename TB, typename TRUN>
+    void gemm_driver(const TA& a, const TB& b, adaptive_matrix<TINT, TTECH>& c, size_t concurrency, TRUN&& run) {
+        using kernel_type = gemm_kernel<TINT, TTECH>;
+        using buffer_type = std::vector<TINT, aligned_allocator<TINT> >;
+
+        constexpr size_t MR = kernel_type::mr, NR = kernel_type::nr;
+        constexpr size_t KC = ADAPTIVE_GEMM_KC;
+        constexpr size_t NC = std::max<size_t>(NR, (ADAPTIVE_GEMM_L2_BYTES / (KC * sizeof(TINT))) / NR * NR);
+
+        if(a.cols() != b.rows()) throw std::invalid_argument("gemm: inner dimensions do not match");
+
+        const size_t M = a.rows(), K = a.cols(), N = b.cols();
+        c.resize(M, N);
+        c.fill(0);
+        if(M == 0 || N == 0 || K == 0) return;
+
+        const size_t mstrips = (M + MR - 1) / MR;
+        const size_t kblocks = (K + KC - 1) / KC;
+        const size_t nblocks = (N + NC - 1) / NC;
+
+        // A is packed once, [kblock][strip][k][MR], and only read afterwards.
+        buffer_type packed_a(mstrips * MR * K);
+        const size_t pack_tasks = std::min(mstrips, concurrency);
+        run(pack_tasks, [&](size_t t) {
+            const size_t s0 = mstrips * t / pack_tasks, s1 = mstrips * (t + 1) / pack_tasks;
+            for(size_t kb = 0; kb < kblocks; ++kb) {
+                const size_t k0 = kb * KC, kc = std::min(KC, K - k0);
+                const size_t r0 = s0 * MR, r1 = std::min(s1 * MR, M);
+                if(r0 < r1) gemm_pack_operand_a<MR>(a, r0, k0, r1 - r0, kc,
+                                                   packed_a.data() + mstrips * MR * k0 + s0 * MR * kc);
+            }
+        });
+
+        // Enough macro tiles that stealing can even out the load, but each keeps whole B panels.
+        const size_t target = 4 * concurrency;
+        const size_t mchunks = std::min(mstrips, std::max<size_t>(1, (target + nblocks - 1) / nblocks));
+
+        run(nblocks * mchunks, [&](size_t t) {
+            static thread_local buffer_type packed_b;
+            packed_b.resize(KC * ((NC + NR - 1) / NR) * NR);
+
+            const size_t jb = t % nblocks, mi = t / nblocks;
+            const size_t j0 = jb * NC, nc = std::min(NC, N - j0);
+            const size_t s0 = mstrips * mi / mchunks, s1 = mstrips * (mi + 1) / mchunks;
+            const size_t r0 = s0 * MR, r1 = std::min(s1 * MR, M);
+            if(r0 >= r1) return;
+
+            for(size_t kb = 0; kb < kblocks; ++kb) {
+                const size_t k0 = kb * KC, kc = std::min(KC, K - k0);
+                gemm_pack_operand_b<NR>(b, k0, j0, kc, nc, packed_b.data());
+                gemm_macro<kernel_type>(r1 - r0, nc, kc, packed_a.data() + mstrips * MR * k0 + s0 * MR * kc,
+                                        packed_b.data(), c.row(r0) + j0, c.stride());
+            }
+        });
+    }
+}
+
+    /**
+     * @brief Single-threaded blocked matrix multiply `C = A * B` on views
+     *
+     * The operands may be any strided views (sub-blocks, transposed views, ...); they are
+     * read once while packing, so no copy of them is made.
+     *
+     * @param a The `M` x `K` left hand side
+     * @param b The `K` x `N` right hand side
+     * @param c Receives the `M` x `N` product, must not overlap `a` or `b`
+     *
+     * @throw std::invalid_argument if the inner dimensions do not match
+     */
+    template <typename TA, typename TB, techn_t TTECH>
+    void gemm(const adaptive_matrix_view<TA, TTECH>& a, const adaptive_matrix_view<TB, TTECH>& b,
+              adaptive_matrix<typename std::remove_cv<TA>::type, TTECH>& c) {
+        using value_type = typename std::remove_cv<TA>::type;
+        using operand_type = adaptive_matrix_view<const value_type, TTECH>;
+        static_assert(std::is_same<value_type, typename std::remove_cv<TB>::type>::value, "gemm: element types differ");
+        internal::gemm_driver<value_type, TTECH>(operand_type(a), operand_type(b), c, 1, [](size_t tasks, auto&& fn) {
+            for(size_t i = 0; i < tasks; ++i) fn(i);
+        });
+    }
+    /**
+     * @brief Multi-threaded blocked matrix multiply `C = A * B` on views, run on `pool`
+     */
+    template <typename TA, typename TB, techn_t TTECH>
+    void gemm(const adaptive_matrix_view<TA, TTECH>& a, const adaptive_matrix_view<TB, TTECH>& b,
+              adaptive_matrix<typename std::remove_cv<TA>::type, TTECH>& c, thread_pool& pool) {
+        using value_type = typename std::remove_cv<TA>::type;
+        using operand_type = adaptive_matrix_view<const value_type, TTECH>;
+        static_assert(std::is_same<value_type, typename std::remove_cv<TB>::type>::value, "gemm: element types differ");
+        internal::gemm_driver<value_type, TTECH>(operand_type(a), operand_type(b), c, pool.size(), [&pool](size_t tasks, auto&& fn) {
+            pool.parallel(tasks, fn);
+        });
+    }
+
+    /**
+     * @brief Single-threaded blocked matrix multiply `C = A * B`
+     *
+     * `a` and `b` may have any layout, `c` is row-major.
+     *
+     * @param a The `M` x `K` left hand side
+     * @param b The `K` x `N` right hand side
+     * @param c Receives the `M` x `N` product, must not alias `a` or `b`
+     *
+     * @throw std::invalid_argument if the inner dimensions do not match or `c` aliases an operand
+     */
+    template <typename TINT, techn_t TTECH, layout_t TLA, layout_t TLB>
+    void gemm(const adaptive_matrix<TINT, TTECH, TLA>& a, const adaptive_matrix<TINT, TTECH, TLB>& b,
+              adaptive_matrix<TINT, TTECH>& c) {
+        if(static_cast<const void*>(&c) == &a || static_cast<const void*>(&c) == &b)
+            throw std::invalid_argument("gemm: c aliases an operand");
+        internal::gemm_driver<TINT, TTECH>(a, b, c, 1, [](size_t tasks, auto&& fn) {
+            for(size_t i = 0; i < tasks; ++i) fn(i);
+        });
+    }
+    /**
+     * @brief Multi-threaded blocked matrix multiply `C = A * B` on `pool`
+     *
+     * @param a The `M` x `K` left hand side
+     * @param b The `K` x `N` right hand side
+     * @param c Receives the `M` x `N` product, must not alias `a` or `b`
+     * @param pool The pool to run on
+     */
+    template <typename TINT, techn_t TTECH, layout_t TLA, layout_t TLB>
+    void gemm(const adaptive_matrix<TINT, TTECH, TLA>& a, const adaptive_matrix<TINT, TTECH, TLB>& b,
+              adaptive_matrix<TINT, TTECH>& c, thread_pool& pool) {
+        if(static_cast<const void*>(&c) == &a || static_cast<const void*>(&c) == &b)
+            throw std::invalid_argument("gemm: c aliases an operand");
+        internal::gemm_driver<TINT, TTECH>(a, b, c, pool.size(), [&pool](size_t tasks, auto&& fn) {
+            pool.parallel(tasks, fn);
+        });
+    }
+
+    /**
+     * @brief Returns `a * b` as a row-major matrix, computed single-threaded
+     */
+    template <typename TINT, techn_t TTECH, layout_t TLA, layout_t TLB>
+    adaptive_matrix<TINT, TTECH> operator * (const adaptive_matrix<TINT, TTECH, TLA>& a, const adaptive_matrix<TINT, TTECH, TLB>& b) {
+        adaptive_matrix<TINT, TTECH> _result;
+        gemm(a, b, _result);
+        return _result;
+    }
+}
+
+#endif
@@ -0,0 +1,549 @@
+/**
+ * @file adaptive_graph.h
+ * @brief Header file for deferred expression graphs over adaptive vectors.
+ *
+ * This file defines `expr_graph`, which records element-wise expressions over integer
+ * `adaptive_vector`s as a DAG and evaluates all of its outputs at once, and `graph_expr`,
+ * the handle of one node with the arithmetic operators. Evaluating the same expressions
+ * op by op writes every intermediate array to memory and reads it back; the graph
+ * instead runs them chunk by chunk, with the intermediates of a chunk in L1:
+ *
+ * @code
+ * adaptive::expr_graph<int32_t> g;
+ * auto a = g.input(prices), b = g.input(costs);
+ * auto margin = a - b;                       // shared by both outputs
+ * g.output(g.max(margin, 0), profit);
+ * g.output(margin - g.max_of(margin), gap);   // a second pass, after the reduction
+ * g.run(pool);
+ * @endcode
+ *
+ * Building the graph already eliminates common subexpressions (a node with the same
+ * operation and operands is returned instead of added, symmetric operations are keyed
+ * with ordered operands) and folds operations on constants. `run` then compiles it:
+ *
+ * - Every reduction (`sum`, `min_of`, `max_of`) is a barrier, the nodes after it can only
+ *   run once it is complete. The nodes are cut into passes by the number of reductions
+ *   on their longest path; all element-wise nodes of a pass are fused into one loop over
+ *   chunks of `ADAPTIVE_GRAPH_CHUNK` elements.
+ * - An element-wise node that a later pass needs again is recomputed there from the
+ *   inputs rather than stored, arrays are written only to the outputs.
+ * - The chunk buffers are assigned by liveness, a buffer is reused once its last reader
+ *   in the chunk has run.
+ * - Each pass splits the elements into contiguous ranges of whole chunks, run as tasks
+ *   of the thread pool; reductions are merged from per-task partials in order, so the
+ *   result does not depend on the number of threads.
+ *
+ * An output may be one of the inputs as long as no later pass reads that input.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_GRAPH__
+#define __ADAPTIVE_GRAPH__ 1
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <adaptive_thread_pool.h>
+#include <adaptive_vector.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/kernel_graph.h>
+#include <internal/parallel_for.h>
+
+#ifndef ADAPTIVE_GRAPH_CHUNK
+/**
+ * @brief Elements per chunk of a fused pass, the buffers of a chunk should stay in L1
+ */
+#define ADAPTIVE_GRAPH_CHUNK 1024
+#endif
+
+#ifndef ADAPTIVE_GRAPH_TASKS_PER_THREAD
+/**
+ * @brief Tasks per pool thread of a pass, more than one lets the pool balance uneven threads
+ */
+#define ADAPTIVE_GRAPH_TASKS_PER_THREAD 4
+#endif
+
+namespace adaptive {
+    template <typename TINT, techn_t TTECH>
+    class expr_graph;
+
+    /**
+     * @brief The handle of a node of an `expr_graph`
+     *
+     * Only valid while its graph lives; the operators add nodes to that graph.
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class graph_expr {
+    public:
+        using graph_type = expr_graph<TINT, TTECH>;
+
+        graph_expr() noexcept
+            : m_pGraph(nullptr), m_uId(0) { }
+        graph_expr(graph_type* graph, uint32_t id) noexcept
+            : m_pGraph(graph), m_uId(id) { }
+
+        /**
+         * @brief Get the graph of the node
+         *
+         * @throw std::invalid_argument for a default constructed handle
+         */
+        graph_type& graph() const {
+            if(m_pGraph == nullptr) throw std::invalid_argument("graph_expr: empty expression");
+            return *m_pGraph;
+        }
+        uint32_t id() const noexcept { return m_uId; }
+
+    protected:
+        graph_type* m_pGraph;
+        uint32_t m_uId;
+    };
+
+    /**
+     * @class expr_graph
+     * @brief A DAG of element-wise operations and reductions over integer vectors of one size
+     *
+     * @tparam TINT The element type
+     * @tparam TTECH The technique of the vectors and the kernels
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class expr_graph {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "expr_graph: integer type required");
+    public:
+        using this_type = expr_graph<TINT, TTECH>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using vector_type = adaptive_vector<TINT, TTECH>;
+        using expr_type = graph_expr<TINT, TTECH>;
+        using scalar_type = typename std::common_type<TINT>::type;
+
+        expr_graph()
+            : m_szSize(0), m_bSized(false), m_bCompiled(false) { }
+        expr_graph(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        /**
+         * @brief Adds `v` as an input, read when the graph runs
+         *
+         * @throw std::invalid_argument if `v` has another size than the inputs before
+         */
+        expr_type input(const vector_type& v) {
+            if(m_bSized && v.size() != m_szSize) throw std::invalid_argument("expr_graph::input: sizes do not match");
+            m_szSize = v.size();
+            m_bSized = true;
+            return add_node(graph_op::Input, nullptr, nullptr, TINT(0), TINT(0), &v);
+        }
+        /**
+         * @brief Adds a scalar, which broadcasts to every element
+         */
+        expr_type constant(scalar_type v) {
+            return add_node(graph_op::Constant, nullptr, nullptr, TINT(v), TINT(0), nullptr);
+        }
+
+        /**
+         * @brief Adds the unary operation `op`, for the operations without a method
+         */
+        expr_type unary(graph_op op, const expr_type& a) {
+            if(internal::graph_op_arity(op) != 1 || op == graph_op::Clamp)
+                throw std::invalid_argument("expr_graph::unary: not a unary operation");
+            return add_node(op, &a, nullptr, TINT(0), TINT(0), nullptr);
+        }
+        /**
+         * @brief Adds the binary operation `op`, for the operations without a method
+         */
+        expr_type binary(graph_op op, const expr_type& a, const expr_type& b) {
+            if(internal::graph_op_arity(op) != 2) throw std::invalid_argument("expr_graph::binary: not a binary operation");
+            return add_node(op, &a, &b, TINT(0), TINT(0), nullptr);
+        }
+
+        expr_type abs(const expr_type& a)                          { return unary(graph_op::Abs, a); }
+        expr_type sign(const expr_type& a)                         { return unary(graph_op::Sign, a); }
+        expr_type min(const expr_type& a, const expr_type& b)      { return binary(graph_op::Min, a, b); }
+        expr_type min(const expr_type& a, scalar_type b)           { return binary(graph_op::Min, a, constant(b)); }
+        expr_type max(const expr_type& a, const expr_type& b)      { return binary(graph_op::Max, a, b); }
+        expr_type max(const expr_type& a, scalar_type b)           { return binary(graph_op::Max, a, constant(b)); }
+        expr_type avg(const expr_type& a, const expr_type& b)      { return binary(graph_op::Avg, a, b); }
+        /**
+         * @brief Adds `a` limited to `[lo, hi]`
+         *
+         * @throw std::invalid_argument if `lo > hi`
+         */
+        expr_type clamp(const expr_type& a, scalar_type lo, scalar_type hi) {
+            if(lo > hi) throw std::invalid_argument("expr_graph::clamp: lo must not be above hi");
+            return add_node(graph_op::Clamp, &a, nullptr, TINT(lo), TINT(hi), nullptr);
+        }
+        /**
+         * @brief Adds the wrapping sum of the array `a`, a scalar
+         */
+        expr_type sum(const expr_type& a)                          { return unary(graph_op::Sum, a); }
+        /**
+         * @brief Adds the smallest element of the array `a`, a scalar; the graph throws when it runs on empty vectors
+         */
+        expr_type min_of(const expr_type& a)                       { return unary(graph_op::MinOf, a); }
+        expr_type max_of(const expr_type& a)                       { return unary(graph_op::MaxOf, a); }
+
+        /**
+         * @brief Writes `e` to `out` when the graph runs, `out` is resized to the inputs
+         */
+        void output(const expr_type& e, vector_type& out) {
+            check_operand(e);
+            m_vOutputs.push_back(output_info{ e.id(), &out });
+            m_bCompiled = false;
+        }
+
+        /**
+         * @brief Get the number of nodes, after the common subexpressions are merged
+         */
+        size_type nodes() const noexcept { return m_vNodes.size(); }
+        /**
+         * @brief Get the number of passes over the elements a run makes
+         */
+        size_type passes() {
+            compile();
+            return m_vPasses.size();
+        }
+
+        /**
+         * @brief Evaluates every output on the calling thread
+         *
+         * @throw std::invalid_argument if an input changed its size, an output is an input
+         * that a later pass reads, or a `min_of` / `max_of` runs on empty vectors
+         */
+        void run() { execute(nullptr); }
+        /**
+         * @brief Evaluates every output with the passes split over `pool`
+         */
+        void run(thread_pool& pool) { execute(&pool); }
+
+    protected:
+        struct node {
+            graph_op op;
+            uint32_t a, b;
+            TINT lo, hi;
+            const vector_type* input;
+            bool scalar;
+            uint32_t level;
+        };
+        struct output_info {
+            uint32_t node;
+            vector_type* target;
+        };
+        /**
+         * @brief The fused loop of one pass
+         */
+        struct pass_plan {
+            std::vector<uint32_t> scalars;      // scalar operands, a buffer each, filled once per task
+            std::vector<uint32_t> steps;        // the element-wise nodes in evaluation order
+            std::vector<uint32_t> reductions;   // the reductions that complete in this pass
+            std::vector<size_t> outputs;        // the array outputs written in this pass
+            std::vector<int32_t> slot;          // the buffer of every node, -1 for the inputs
+            size_t slots = 0;
+        };
+        using key_type = std::tuple<uint8_t, uint32_t, uint32_t, uint64_t, uint64_t, const void*>;
+        using kernel = internal::graph_kernel<TINT, TTECH>;
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+
+        void check_operand(const expr_type& e) const {
+            if(&e.graph() != this || e.id() >= m_vNodes.size()) throw std::invalid_argument("expr_graph: operand of another graph");
+        }
+
+        expr_type add_node(graph_op op, const expr_type* a, const expr_type* b, TINT lo, TINT hi, const vector_type* input) {
+            uint32_t ia = 0, ib = 0;
+            if(a != nullptr) { check_operand(*a); ia = a->id(); }
+            if(b != nullptr) { check_operand(*b); ib = b->id(); }
+            if(internal::graph_op_commutative(op) && ib < ia) std::swap(ia, ib);
+
+            const bool reduction = internal::graph_op_reduction(op);
+            if(reduction && m_vNodes[ia].scalar) throw std::invalid_argument("expr_graph: reduction of a scalar");
+
+            // Constant folding, the operation on length-1 arrays.
+            const int arity = internal::graph_op_arity(op);
+            if(arity > 0 && !reduction && m_vNodes[ia].op == graph_op::Constant &&
+               (arity == 1 || m_vNodes[ib].op == graph_op::Constant)) {
+                TINT _folded = TINT(0);
+                kernel::apply(op, &m_vNodes[ia].lo, &m_vNodes[arity == 2 ? ib : ia].lo, &_folded, 1, lo, hi);
+                return constant(_folded);
+            }
+
+            const key_type key(uint8_t(op), ia, ib, uint64_t(unsigned_type(lo)), uint64_t(unsigned_type(hi)), input);
+            auto it = m_mapNodes.find(key);
+            if(it != m_mapNodes.end()) return expr_type(this, it->second);
+
+            node n{ op, ia, ib, lo, hi, input, false, 0 };
+            if(op == graph_op::Constant) {
+                n.scalar = true;
+            } else if(arity > 0) {
+                n.scalar = reduction || (m_vNodes[ia].scalar && (arity == 1 || m_vNodes[ib].scalar));
+                n.level = std::max(m_vNodes[ia].level, arity == 2 ? m_vNodes[ib].level : 0u) + (reduction ? 1u : 0u);
+            }
+            const uint32_t id = uint32_t(m_vNodes.size());
+            m_vNodes.push_back(n);
+            m_mapNodes.emplace(key, id);
+            m_bCompiled = false;
+            return expr_type(this, id);
+        }
+
+        /**
+         * @brief Cuts the nodes the outputs need into passes and assigns the chunk buffers
+         */
+        void compile() {
+            if(m_bCompiled) return;
+            const size_t count = m_vNodes.size();
+
+            std::vector<char> _needed(count, 0);
+            std::vector<uint32_t> _stack;
+            for(const auto& o : m_vOutputs) _stack.push_back(o.node);
+            while(!_stack.empty()) {
+                const uint32_t i = _stack.back();
+                _stack.pop_back();
+                if(_needed[i]) continue;
+                _needed[i] = 1;
+                const int arity = internal::graph_op_arity(m_vNodes[i].op);
+                if(arity > 0) _stack.push_back(m_vNodes[i].a);
+                if(arity > 1) _stack.push_back(m_vNodes[i].b);
+            }
+
+            // A scalar of level L is known after pass L - 1, an array of level L is computed in pass L.
+            size_t _passes = 0;
+            for(const auto& o : m_vOutputs) {
+                const node& n = m_vNodes[o.node];
+                _passes = std::max<size_t>(_passes, n.scalar ? n.level : n.level + 1);
+            }
+            m_vPasses.assign(_passes, pass_plan());
+
+            for(size_t p = 0; p < _passes; ++p) {
+                pass_plan& plan = m_vPasses[p];
+                std::vector<char> _in(count, 0);
+                _stack.clear();
+                for(size_t o = 0; o < m_vOutputs.size(); ++o) {
+                    const node& n = m_vNodes[m_vOutputs[o].node];
+                    if(!n.scalar && n.level == p) {
+                        plan.outputs.push_back(o);
+                        _stack.push_back(m_vOutputs[o].node);
+                    }
+                }
+                for(uint32_t i = 0; i < count; ++i) {
+                    if(_needed[i] && internal::graph_op_reduction(m_vNodes[i].op) && m_vNodes[i].level == p + 1) {
+                        plan.reductions.push_back(i);
+                        _stack.push_back(m_vNodes[i].a);
+                    }
+                }
+                while(!_stack.empty()) {
+                    const uint32_t i = _stack.back();
+                    _stack.pop_back();
+                    if(_in[i]) continue;
+                    _in[i] = 1;
+                    if(m_vNodes[i].scalar) continue;
+                    const int arity = internal::graph_op_arity(m_vNodes[i].op);
+                    if(arity > 0) _stack.push_back(m_vNodes[i].a);
+                    if(arity > 1) _stack.push_back(m_vNodes[i].b);
+                }
+
+                // Node ids are a topological order; the last step reading each node.
+                const size_t end = size_t(-1);
+                std::vector<size_t> _last(count, 0);
+                for(uint32_t i = 0; i < count; ++i) {
+                    if(!_in[i]) continue;
+                    if(m_vNodes[i].scalar) plan.scalars.push_back(i);
+                    else if(m_vNodes[i].op != graph_op::Input) plan.steps.push_back(i);
+                }
+                for(size_t s = 0; s < plan.steps.size(); ++s) {
+                    const node& n = m_vNodes[plan.steps[s]];
+                    const int arity = internal::graph_op_arity(n.op);
+                    if(arity > 0) _last[n.a] = s;
+                    if(arity > 1) _last[n.b] = s;
+                }
+                for(size_t o : plan.outputs) _last[m_vOutputs[o].node] = end;
+                for(uint32_t r : plan.reductions) _last[m_vNodes[r].a] = end;
+
+                plan.slot.assign(count, -1);
+                for(uint32_t i : plan.scalars) plan.slot[i] = int32_t(plan.slots++);
+                std::vector<int32_t> _free;
+                for(size_t s = 0; s < plan.steps.size(); ++s) {
+                    const node& n = m_vNodes[plan.steps[s]];
+                    const int arity = internal::graph_op_arity(n.op);
+                    // Operands read last here give their buffer to the result, the kernels allow aliasing.
+                    for(int k = 0; k < arity; ++k) {
+                        const uint32_t o = k == 0 ? n.a : n.b;
+                        if(k == 1 && n.b == n.a) break;
+                        if(_last[o] == s && !m_vNodes[o].scalar && m_vNodes[o].op != graph_op::Input) _free.push_back(plan.slot[o]);
+                    }
+                    if(_free.empty()) plan.slot[plan.steps[s]] = int32_t(plan.slots++);
+                    else { plan.slot[plan.steps[s]] = _free.back(); _free.pop_back(); }
+                }
+            }
+            m_bCompiled = true;
+        }
+
+        /**
+         * @brief Throws if an output overwrites an input that a later pass reads
+         */
+        void check_aliasing() const {
+            for(size_t p = 0; p < m_vPasses.size(); ++p) {
+                for(const auto& o : m_vOutputs) {
+                    const node& n = m_vNodes[o.node];
+                    const size_t written = n.scalar ? m_vPasses.size() : n.level;
+                    if(written >= p) continue;
+                    for(uint32_t i = 0; i < m_vNodes.size(); ++i) {
+                        if(m_vPasses[p].slot[i] == -1 && m_vNodes[i].op == graph_op::Input && m_vNodes[i].input == o.target &&
+                           is_read(p, i))
+                            throw std::invalid_argument("expr_graph::run: an output overwrites an input of a later pass");
+                    }
+                }
+            }
+        }
+        bool is_read(size_t p, uint32_t input) const {
+            const pass_plan& plan = m_vPasses[p];
+            for(uint32_t s : plan.steps) {
+                const node& n = m_vNodes[s];
+                if(n.a == input || (internal::graph_op_arity(n.op) == 2 && n.b == input)) return true;
+            }
+            for(uint32_t r : plan.reductions) if(m_vNodes[r].a == input) return true;
+            for(size_t o : plan.outputs) if(m_vOutputs[o].node == input) return true;
+            return false;
+        }
+
+        void execute(thread_pool* pool) {
+            compile();
+            for(const node& n : m_vNodes)
+                if(n.op == graph_op::Input && n.input->size() != m_szSize) throw std::invalid_argument("expr_graph::run: sizes do not match");
+            check_aliasing();
+            const size_t n = m_szSize;
+            for(const auto& p : m_vPasses)
+                for(uint32_t r : p.reductions)
+                    if(n == 0 && m_vNodes[r].op != graph_op::Sum) throw std::invalid_argument("expr_graph::run: min_of or max_of of empty vectors");
+
+            m_vValues.assign(m_vNodes.size(), TINT(0));
+            for(uint32_t i = 0; i < m_vNodes.size(); ++i)
+                if(m_vNodes[i].op == graph_op::Constant) m_vValues[i] = m_vNodes[i].lo;
+            std::vector<TINT*> _targets(m_vOutputs.size());
+            for(size_t o = 0; o < m_vOutputs.size(); ++o) {
+                m_vOutputs[o].target->resize(n);
+                _targets[o] = m_vOutputs[o].target->data();
+            }
+
+            for(size_t p = 0; p < m_vPasses.size(); ++p) {
+                run_pass(m_vPasses[p], _targets, pool);
+                eval_scalars(p + 1);
+            }
+            for(size_t o = 0; o < m_vOutputs.size(); ++o) {
+                const uint32_t i = m_vOutputs[o].node;
+                if(m_vNodes[i].scalar) std::fill(_targets[o], _targets[o] + n, m_vValues[i]);
+            }
+        }
+
+        /**
+         * @brief Computes the scalars that depend on the reductions of level `level`
+         */
+        void eval_scalars(uint32_t level) {
+            for(uint32_t i = 0; i < m_vNodes.size(); ++i) {
+                const node& n = m_vNodes[i];
+                if(!n.scalar || n.level != level || n.op == graph_op::Constant || internal::graph_op_reduction(n.op)) continue;
+                const uint32_t b = internal::graph_op_arity(n.op) == 2 ? n.b : n.a;
+                kernel::apply(n.op, &m_vValues[n.a], &m_vValues[b], &m_vValues[i], 1, n.lo, n.hi);
+            }
+        }
+
+        void run_pass(const pass_plan& plan, const std::vector<TINT*>& targets, thread_pool* pool) {
+            const size_t n = m_szSize, chunk = ADAPTIVE_GRAPH_CHUNK;
+            const size_t chunks = (n + chunk - 1) / chunk;
+            if(chunks == 0) {
+                for(uint32_t r : plan.reductions) m_vValues[r] = TINT(0);
+                return;
+            }
+            const size_t threads = pool != nullptr ? pool->size() : 1;
+            const size_t tasks = std::max<size_t>(1, std::min(chunks, threads == 1 ? 1 : threads * ADAPTIVE_GRAPH_TASKS_PER_THREAD));
+            std::vector<size_t> bounds(tasks + 1);
+            for(size_t t = 0; t <= tasks; ++t) bounds[t] = std::min(n, chunks * t / tasks * chunk);
+
+            const size_t reductions = plan.reductions.size();
+            std::vector<TINT> partials(tasks * reductions);
+            auto work = [&](size_t t, size_t begin, size_t end) {
+                std::vector<TINT, aligned_allocator<TINT> > _scratch(plan.slots * chunk);
+                for(uint32_t i : plan.scalars)
+                    std::fill_n(_scratch.data() + size_t(plan.slot[i]) * chunk, chunk, m_vValues[i]);
+
+                for(size_t off = begin; off < end; off += chunk) {
+                    const size_t len = std::min(chunk, end - off);
+                    auto at = [&](uint32_t i) -> TINT* {
+                        return plan.slot[i] >= 0 ? _scratch.data() + size_t(plan.slot[i]) * chunk
+                                                 : const_cast<TINT*>(m_vNodes[i].input->data()) + off;
+                    };
+                    for(uint32_t s : plan.steps) {
+                        const node& nd = m_vNodes[s];
+                        const uint32_t b = internal::graph_op_arity(nd.op) == 2 ? nd.b : nd.a;
+                        kernel::apply(nd.op, at(nd.a), at(b), at(s), len, nd.lo, nd.hi);
+                    }
+                    for(size_t r = 0; r < reductions; ++r) {
+                        const node& nd = m_vNodes[plan.reductions[r]];
+                        const TINT v = kernel::reduce(nd.op, at(nd.a), len);
+                        TINT& acc = partials[t * reductions + r];
+                        acc = off == begin ? v : kernel::combine(nd.op, acc, v);
+                    }
+                    for(size_t o : plan.outputs)
+                        std::memcpy(targets[o] + off, at(m_vOutputs[o].node), len * sizeof(TINT));
+                }
+            };
+            if(tasks == 1) work(0, 0, n);
+            else internal::parallel_for_bounds(bounds, work, *pool);
+
+            for(size_t r = 0; r < reductions; ++r) {
+                const graph_op op = m_vNodes[plan.reductions[r]].op;
+                TINT _result = partials[r];
+                for(size_t t = 1; t < tasks; ++t) _result = kernel::combine(op, _result, partials[t * reductions + r]);
+                m_vValues[plan.reductions[r]] = _result;
+            }
+        }
+
+    protected:
+        std::vector<node> m_vNodes;
+        std::map<key_type, uint32_t> m_mapNodes;
+        std::vector<output_info> m_vOutputs;
+        std::vector<pass_plan> m_vPasses;
+        std::vector<TINT> m_vValues;
+        size_t m_szSize;
+        bool m_bSized;
+        bool m_bCompiled;
+    };
+
+#define ADAPTIVE_GRAPH_OPERATOR(SYMBOL, OP)                                                                             \
+    template <typename TINT, techn_t TTECH>                                                                             \
+    graph_expr<TINT, TTECH> operator SYMBOL (const graph_expr<TINT, TTECH>& a, const graph_expr<TINT, TTECH>& b) {      \
+        return a.graph().binary(graph_op::OP, a, b);                                                                    \
+    }                                                                                                                   \
+    template <typename TINT, techn_t TTECH>                                                                             \
+    graph_expr<TINT, TTECH> operator SYMBOL (const graph_expr<TINT, TTECH>& a, typename std::common_type<TINT>::type b) { \
+        return a.graph().binary(graph_op::OP, a, a.graph().constant(b));                                                \
+    }                                                                                                                   \
+    template <typename TINT, techn_t TTECH>                                                                             \
+    graph_expr<TINT, TTECH> operator SYMBOL (typename std::common_type<TINT>::type a, const graph_expr<TINT, TTECH>& b) { \
+        return b.graph().binary(graph_op::OP, b.graph().constant(a), b);                                                \
+    }
+
+    ADAPTIVE_GRAPH_OPERATOR(+, Add)
+    ADAPTIVE_GRAPH_OPERATOR(-, Sub)
+    ADAPTIVE_GRAPH_OPERATOR(*, Mul)
+    ADAPTIVE_GRAPH_OPERATOR(&, And)
+    ADAPTIVE_GRAPH_OPERATOR(|, Or)
+    ADAPTIVE_GRAPH_OPERATOR(^, Xor)
+#undef ADAPTIVE_GRAPH_OPERATOR
+
+    template <typename TINT, techn_t TTECH>
+    graph_expr<TINT, TTECH> operator - (const graph_expr<TINT, TTECH>& a) {
+        return a.graph().unary(graph_op::Neg, a);
+    }
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file adaptive_layout.h
+ * @brief Header file for the storage layouts of adaptive matrices.
+ *
+ * This file defines the `layout_type` enumeration, the storage order an
+ * `adaptive_matrix` keeps its elements in, and the internal `layout_traits` that map
+ * an element `(r, c)` to its offset in the storage. Row-major suits row walks and
+ * GEMV-like kernels, column-major suits column scans, and the tiled layout keeps
+ * square tiles of at most one page (`ADAPTIVE_MATRIX_TILE_BYTES`) contiguous, which
+ * keeps blocked kernels like GEMM and transpose inside a few TLB entries.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_LAYOUT__
+#define __ADAPTIVE_LAYOUT__ 1
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Upper bound for the bytes of one tile of the tiled layout.
+ */
+#ifndef ADAPTIVE_MATRIX_TILE_BYTES
+#define ADAPTIVE_MATRIX_TILE_BYTES 4096
+#endif
+
+namespace adaptive {
+    /**
+     * @brief The storage order of a matrix
+     */
+    enum class layout_type {
+        RowMajor = 0,
+        ColMajor = 1,
+        Tiled = 2,
+    };
+    using layout_t = layout_type;
+
+    /**
+     * @brief Converts a `layout_t` enum value into its string representation.
+     */
+    inline std::string layout2string(const layout_t layout) {
+        switch (layout) {
+        case layout_t::ColMajor: return "ColMajor";
+        case layout_t::Tiled: return "Tiled";
+        default: return "RowMajor";
+        }
+    }
+
+namespace internal {
+    /**
+     * @brief Side length of a tile: the largest power of two whose square fits `ADAPTIVE_MATRIX_TILE_BYTES`.
+     */
+    template <typename TINT>
+    constexpr size_t matrix_tile_edge() {
+        size_t _edge = 1;
+        while((2 * _edge) * (2 * _edge) * sizeof(TINT) <= ADAPTIVE_MATRIX_TILE_BYTES) _edge *= 2;
+        return _edge;
+    }
+
+    /**
+     * @class layout_traits
+     * @brief Row-major storage, element `(r, c)` at `r * cols + c`.
+     *
+     * @tparam TLAYOUT The layout.
+     * @tparam TINT The element type.
+     */
+    template <layout_t TLAYOUT, typename TINT>
+    struct layout_traits {
+        static size_t storage_size(size_t rows, size_t cols) noexcept { return rows * cols; }
+        static size_t leading(size_t /*rows*/, size_t cols) noexcept  { return cols; }
+        static size_t offset(size_t r, size_t c, size_t /*rows*/, size_t cols) noexcept {
+            return r * cols + c;
+        }
+    };
+
+    /**
+     * @brief Column-major storage, element `(r, c)` at `c * rows + r`.
+     */
+    template <typename TINT>
+    struct layout_traits<layout_t::ColMajor, TINT> {
+        static size_t storage_size(size_t rows, size_t cols) noexcept { return rows * cols; }
+        static size_t leading(size_t rows, size_t /*cols*/) noexcept  { return rows; }
+        static size_t offset(size_t r, size_t c, size_t rows, size_t /*cols*/) noexcept {
+            return c * rows + r;
+        }
+    };
+
+    /**
+     * @brief Tiled storage: `tile` x `tile` blocks in row-major order, each block row-major.
+     *
+     * The last tile row and column are padded to full tiles; the padding is never read.
+     */
+    template <typename TINT>
+    struct layout_traits<layout_t::Tiled, TINT> {
+        static constexpr size_t tile = matrix_tile_edge<TINT>();
+
+        static size_t tiles(size_t n) noexcept { return (n + tile - 1) / tile; }
+        static size_t storage_size(size_t rows, size_t cols) noexcept {
+            return tiles(rows) * tiles(cols) * tile * tile;
+        }
+        static size_t leading(size_t /*rows*/, size_t /*cols*/) noexcept { return tile; }
+        static size_t offset(size_t r, size_t c, size_t /*rows*/, size_t cols) noexcept {
+            return ((r / tile) * tiles(cols) + c / tile) * tile * tile + (r % tile) * tile + c % tile;
+        }
+    };
+}
+}
+
+#endif
@@ -1 +1,430 @@
- 
\ No newline at end of file
+/**
+ * @file adaptive_matrix.h
+ * @brief Header file for adaptive integer matrices with customizable techniques.
+ *
+ * This file defines the `adaptive_matrix` class template, a dense matrix of integers
+ * whose bulk operations are delegated to the kernels of the selected technique
+ * (scalar, SSE, AVX, ...), the same way `adaptive_number` delegates its arithmetic to
+ * the technique backends. The storage layout (row-major, column-major or tiled) is a
+ * template parameter as well; operations dispatch on it and `convert_layout` moves
+ * between layouts with the SIMD copy and transpose kernels.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_MATRIX__
+#define __ADAPTIVE_MATRIX__ 1
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+#include <adaptive_integer.h>
+#include <adaptive_layout.h>
+#include <adaptive_view.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/kernel_transpose.h>
+
+namespace adaptive {
+    /**
+     * @brief A template class that implements a dense integer matrix with customizable technique
+     *
+     * @tparam TINT The base integer type of the elements
+     * @tparam TTECH The technique type for the matrix kernels
+     * @tparam TLAYOUT The storage layout of the elements
+     *
+     * The elements are stored in one cache line aligned block in the order given by
+     * `TLAYOUT`. Element access is plain, bulk operations like `transpose` are dispatched
+     * to the kernels of `TTECH` for that layout; nothing converts the layout implicitly.
+     * Row- and column-major matrices can be looked at through strided views, tiled
+     * matrices tile by tile through `tile_view`.
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_matrix<int32_t, adaptive::techn_t::AVX> m(1024, 768);
+     * m(0, 1) = 42;
+     * auto t = m.transpose();   // t(1, 0) == 42
+     * adaptive::adaptive_matrix<int32_t, adaptive::techn_t::AVX, adaptive::layout_t::Tiled> tm(m);
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE, layout_t TLAYOUT = layout_t::RowMajor >
+    class adaptive_matrix {
+    public:
+        using number_type = adaptive_number<TINT, TTECH>;
+        using backend_type = typename number_type::backend_type;
+        using this_type = adaptive_matrix<TINT, TTECH, TLAYOUT>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = this_type*;
+        using reference = this_type&;
+        using const_pointer = const this_type*;
+        using const_refernce = const this_type&;
+        using const_type = const this_type;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+        using transpose_type = internal::transpose_kernel<TINT, TTECH>;
+        using layout_traits = internal::layout_traits<TLAYOUT, TINT>;
+        using view_type = adaptive_matrix_view<TINT, TTECH>;
+        using const_view_type = adaptive_matrix_view<const TINT, TTECH>;
+
+        static constexpr layout_t layout = TLAYOUT;
+        static constexpr bool is_tiled = TLAYOUT == layout_t::Tiled;
+
+        /**
+         * @brief Default constructor, creates an empty 0x0 matrix
+         */
+        adaptive_matrix() noexcept
+            : m_szRows(0), m_szCols(0) { }
+        /**
+         * @brief Constructor for a matrix with the given shape
+         *
+         * @param rows The number of rows
+         * @param cols The number of columns
+         * @param value The initial value of every element
+         */
+        adaptive_matrix(size_type rows, size_type cols, value_type value = 0)
+            : m_szRows(rows), m_szCols(cols), m_vData(layout_traits::storage_size(rows, cols), value) { }
+        /**
+         * @brief Constructor that materializes a view
+         *
+         * @param view The view to copy, any strides
+         */
+        explicit adaptive_matrix(const const_view_type& view)
+            : m_szRows(view.rows()), m_szCols(view.cols()), m_vData(layout_traits::storage_size(view.rows(), view.cols())) {
+            assign(view);
+        }
+        /**
+         * @brief Constructor that converts a matrix of another layout, see `convert_layout`
+         */
+        template <layout_t TOTHER, typename = typename std::enable_if<TOTHER != TLAYOUT>::type>
+        explicit adaptive_matrix(const adaptive_matrix<TINT, TTECH, TOTHER>& other)
+            : m_szRows(0), m_szCols(0) {
+            convert_layout(other, *this);
+        }
+
+        adaptive_matrix(const_refernce other) = default;
+        adaptive_matrix(this_type&& other) noexcept
+            : m_szRows(other.m_szRows), m_szCols(other.m_szCols), m_vData(std::move(other.m_vData)) {
+            other.m_szRows = other.m_szCols = 0;
+        }
+        virtual ~adaptive_matrix() = default;
+
+        this_type& operator = (const_refernce other) = default;
+        this_type& operator = (this_type&& other) noexcept {
+            m_szRows = other.m_szRows; m_szCols = other.m_szCols;
+            m_vData = std::move(other.m_vData);
+            other.m_szRows = other.m_szCols = 0;
+            return *this;
+        }
+
+        /**
+         * @brief Get the number of rows
+         */
+        size_type rows() const noexcept      { return m_szRows; }
+        /**
+         * @brief Get the number of columns
+         */
+        size_type cols() const noexcept      { return m_szCols; }
+        /**
+         * @brief Get the number of elements
+         */
+        size_type size() const noexcept      { return m_szRows * m_szCols; }
+        /**
+         * @brief Get the leading dimension of the storage
+         *
+         * The distance in elements between two rows (row-major), two columns
+         * (column-major) or two rows of a tile (tiled).
+         */
+        size_type stride() const noexcept    { return layout_traits::leading(m_szRows, m_szCols); }
+        /**
+         * @brief Get the technique used by this matrix
+         */
+        techn_t get_techniq() const noexcept { return TTECH; }
+        /**
+         * @brief Get the storage layout of this matrix
+         */
+        layout_t get_layout() const noexcept { return TLAYOUT; }
+
+        value_type* data() noexcept             { return m_vData.data(); }
+        const value_type* data() const noexcept { return m_vData.data(); }
+
+        /**
+         * @brief Pointer to the contiguous row `r`, row-major matrices only
+         */
+        value_type* row(size_type r) noexcept {
+            static_assert(TLAYOUT == layout_t::RowMajor, "adaptive_matrix::row: rows are only contiguous in a row-major matrix");
+            return m_vData.data() + r * m_szCols;
+        }
+        const value_type* row(size_type r) const noexcept {
+            static_assert(TLAYOUT == layout_t::RowMajor, "adaptive_matrix::row: rows are only contiguous in a row-major matrix");
+            return m_vData.data() + r * m_szCols;
+        }
+
+        value_type& operator () (size_type r, size_type c) noexcept {
+            return m_vData[layout_traits::offset(r, c, m_szRows, m_szCols)];
+        }
+        const value_type& operator () (size_type r, size_type c) const noexcept {
+            return m_vData[layout_traits::offset(r, c, m_szRows, m_szCols)];
+        }
+
+        /**
+         * @brief Bounds checked element access
+         *
+         * @throw std::out_of_range if `r` or `c` is outside of the matrix
+         */
+        value_type& at(size_type r, size_type c) {
+            check_index(r, c); return (*this)(r, c);
+        }
+        const value_type& at(size_type r, size_type c) const {
+            check_index(r, c); return (*this)(r, c);
+        }
+
+        /**
+         * @brief Set every element to `value`
+         */
+        void fill(value_type value) {
+            std::fill(m_vData.begin(), m_vData.end(), value);
+        }
+
+        /**
+         * @brief Returns a view of the whole matrix, row- and column-major matrices only
+         */
+        view_type view() noexcept             { return make_view<view_type>(data()); }
+        const_view_type view() const noexcept { return make_view<const_view_type>(data()); }
+        /**
+         * @brief Returns a view of the `rows` x `cols` block starting at `(r0, c0)`, no copy
+         *
+         * @throw std::out_of_range if the block leaves the matrix
+         */
+        view_type submatrix(size_type r0, size_type c0, size_type rows, size_type cols) {
+            return view().submatrix(r0, c0, rows, cols);
+        }
+        const_view_type submatrix(size_type r0, size_type c0, size_type rows, size_type cols) const {
+            return view().submatrix(r0, c0, rows, cols);
+        }
+        /**
+         * @brief Returns a view of row `r`, no copy
+         */
+        typename view_type::vector_view_type row_view(size_type r) noexcept                   { return view().row(r); }
+        typename const_view_type::vector_view_type row_view(size_type r) const noexcept       { return view().row(r); }
+        /**
+         * @brief Returns a view of column `c`, no copy
+         */
+        typename view_type::vector_view_type col_view(size_type c) noexcept                   { return view().col(c); }
+        typename const_view_type::vector_view_type col_view(size_type c) const noexcept       { return view().col(c); }
+
+        /**
+         * @brief Get the number of tile rows of a tiled matrix
+         */
+        size_type tile_rows() const noexcept { return (m_szRows + tile_edge() - 1) / tile_edge(); }
+        /**
+         * @brief Get the number of tile columns of a tiled matrix
+         */
+        size_type tile_cols() const noexcept { return (m_szCols + tile_edge() - 1) / tile_edge(); }
+        /**
+         * @brief Returns a view of tile `(ti, tj)`, clipped to the matrix, tiled matrices only
+         */
+        view_type tile_view(size_type ti, size_type tj) noexcept             { return make_tile_view<view_type>(data(), ti, tj); }
+        const_view_type tile_view(size_type ti, size_type tj) const noexcept { return make_tile_view<const_view_type>(data(), ti, tj); }
+
+        /**
+         * @brief Writes the transpose of this matrix into `dst`
+         *
+         * `dst` is reshaped to cols() x rows(). The transpose is done in registers tile by
+         * tile and the tiles are visited in cache-oblivious order; a tiled matrix is
+         * transposed tile by tile into the mirrored tile.
+         *
+         * @param dst The destination matrix, must not be this matrix
+         */
+        void transpose(this_type& dst) const {
+            if(&dst == this) throw std::invalid_argument("adaptive_matrix::transpose: dst aliases source");
+
+            dst.resize(m_szCols, m_szRows);
+            if constexpr (is_tiled) {
+                for(size_type ti = 0; ti < tile_rows(); ++ti)
+                    for(size_type tj = 0; tj < tile_cols(); ++tj)
+                        view_copy(tile_view(ti, tj).transposed(), dst.tile_view(tj, ti));
+            } else {
+                view_copy(view().transposed(), dst.view());
+            }
+        }
+        /**
+         * @brief Returns the transpose of this matrix
+         */
+        this_type transpose() const {
+            this_type _result;
+            transpose(_result);
+            return _result;
+        }
+        /**
+         * @brief Transposes this matrix in place
+         *
+         * Square matrices are transposed without any extra storage. For every other
+         * shape a transposed copy is built and swapped in.
+         */
+        void transpose_inplace() {
+            if(m_szRows == m_szCols) {
+                if constexpr (is_tiled) {
+                    // Diagonal tiles in place, every other tile swapped with its mirror.
+                    const size_type T = tile_edge(), n = tile_rows();
+                    for(size_type ti = 0; ti < n; ++ti) {
+                        internal::transpose_inplace_recursive<transpose_type>(tile_data(ti, ti), T, T);
+                        for(size_type tj = ti + 1; tj < n; ++tj)
+                            internal::transpose_swap_recursive<transpose_type>(tile_data(ti, tj), tile_data(tj, ti), T, T, T);
+                    }
+                } else {
+                    internal::transpose_inplace_recursive<transpose_type>(data(), stride(), m_szRows);
+                }
+            } else {
+                this_type _tmp;
+                transpose(_tmp);
+                *this = std::move(_tmp);
+            }
+        }
+
+        /**
+         * @brief Changes the shape of the matrix, the content is unspecified afterwards
+         */
+        void resize(size_type rows, size_type cols) {
+            m_szRows = rows; m_szCols = cols;
+            m_vData.resize(layout_traits::storage_size(rows, cols));
+        }
+
+        bool operator == (const_refernce o) const noexcept {
+            if(m_szRows != o.m_szRows || m_szCols != o.m_szCols) return false;
+            if constexpr (is_tiled) {
+                // The padding of the edge tiles is unspecified, compare the clipped tiles only.
+                for(size_type ti = 0; ti < tile_rows(); ++ti)
+                    for(size_type tj = 0; tj < tile_cols(); ++tj) {
+                        const_view_type a = tile_view(ti, tj), b = o.tile_view(ti, tj);
+                        for(size_type r = 0; r < a.rows(); ++r)
+                            if(!std::equal(&a(r, 0), &a(r, 0) + a.cols(), &b(r, 0))) return false;
+                    }
+                return true;
+            } else {
+                return m_vData == o.m_vData;
+            }
+        }
+        bool operator != (const_refernce o) const noexcept {
+            return !(*this == o);
+        }
+
+    protected:
+        void check_index(size_type r, size_type c) const {
+            if(r >= m_szRows || c >= m_szCols) throw std::out_of_range("adaptive_matrix: index out of range");
+        }
+
+        static constexpr size_type tile_edge() noexcept {
+            if constexpr (is_tiled) return layout_traits::tile;
+            else return 1;
+        }
+        value_type* tile_data(size_type ti, size_type tj) noexcept {
+            return data() + (ti * tile_cols() + tj) * tile_edge() * tile_edge();
+        }
+
+        template <typename TVIEW, typename TPTR>
+        TVIEW make_view(TPTR p) const noexcept {
+            static_assert(!is_tiled, "adaptive_matrix::view: a tiled matrix has no single strided view, use tile_view");
+            if constexpr (TLAYOUT == layout_t::ColMajor) return TVIEW(p, m_szRows, m_szCols, 1, difference_type(m_szRows));
+            else return TVIEW(p, m_szRows, m_szCols, difference_type(m_szCols), 1);
+        }
+        template <typename TVIEW, typename TPTR>
+        TVIEW make_tile_view(TPTR p, size_type ti, size_type tj) const noexcept {
+            static_assert(is_tiled, "adaptive_matrix::tile_view: not a tiled matrix");
+            const size_type T = tile_edge();
+            return TVIEW(p + (ti * tile_cols() + tj) * T * T,
+                         std::min(T, m_szRows - ti * T), std::min(T, m_szCols - tj * T), difference_type(T), 1);
+        }
+
+        /**
+         * @brief Copies `src` into this matrix, which must already have its shape
+         */
+        void assign(const const_view_type& src) {
+            if constexpr (is_tiled) {
+                const size_type T = tile_edge();
+                for(size_type ti = 0; ti < tile_rows(); ++ti)
+                    for(size_type tj = 0; tj < tile_cols(); ++tj) {
+                        view_type dst = tile_view(ti, tj);
+                        view_copy(src.submatrix(ti * T, tj * T, dst.rows(), dst.cols()), dst);
+                    }
+            } else {
+                view_copy(src, view());
+            }
+        }
+
+        template <typename, techn_t, layout_t> friend class adaptive_matrix;
+        template <typename TI, techn_t TT, layout_t TS, layout_t TD>
+        friend void convert_layout(const adaptive_matrix<TI, TT, TS>&, adaptive_matrix<TI, TT, TD>&);
+
+    protected:
+        /**
+         * @brief The number of rows
+         */
+        size_type m_szRows;
+        /**
+         * @brief The number of columns
+         */
+        size_type m_szCols;
+        /**
+         * @brief The elements, in `TLAYOUT` order
+         */
+        storage_type m_vData;
+    };
+
+    /**
+     * @brief Copies `src` into `dst`, converting the storage layout
+     *
+     * `dst` is reshaped to the shape of `src`. Row-major <-> column-major runs the
+     * cache-oblivious transpose kernel; to and from the tiled layout every tile is one
+     * block copy of rows (row-major side) or one tile transpose (column-major side).
+     *
+     * @throw std::invalid_argument if `dst` is `src`
+     */
+    template <typename TINT, techn_t TTECH, layout_t TSRC, layout_t TDST>
+    void convert_layout(const adaptive_matrix<TINT, TTECH, TSRC>& src, adaptive_matrix<TINT, TTECH, TDST>& dst) {
+        if(static_cast<const void*>(&src) == static_cast<const void*>(&dst))
+            throw std::invalid_argument("convert_layout: dst aliases source");
+
+        dst.resize(src.rows(), src.cols());
+        if constexpr (TSRC == TDST) {
+            dst.m_vData = src.m_vData;
+        } else if constexpr (TSRC == layout_t::Tiled) {
+            const size_t T = src.tile_edge();
+            for(size_t ti = 0; ti < src.tile_rows(); ++ti)
+                for(size_t tj = 0; tj < src.tile_cols(); ++tj) {
+                    auto tile = src.tile_view(ti, tj);
+                    view_copy(tile, dst.view().submatrix(ti * T, tj * T, tile.rows(), tile.cols()));
+                }
+        } else {
+            dst.assign(src.view());
+        }
+    }
+
+    template <techn_t TTECH = internal::detected_techniq_used<int8_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using int8_matrix_t = adaptive_matrix<int8_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<int16_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using int16_matrix_t = adaptive_matrix<int16_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<int32_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using int32_matrix_t = adaptive_matrix<int32_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<int64_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using int64_matrix_t = adaptive_matrix<int64_t, TTECH, TLAYOUT>;
+
+    template <techn_t TTECH = internal::detected_techniq_used<uint8_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using uint8_matrix_t = adaptive_matrix<uint8_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint16_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using uint16_matrix_t = adaptive_matrix<uint16_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint32_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using uint32_matrix_t = adaptive_matrix<uint32_t, TTECH, TLAYOUT>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint64_t>(), layout_t TLAYOUT = layout_t::RowMajor >
+    using uint64_matrix_t = adaptive_matrix<uint64_t, TTECH, TLAYOUT>;
+}
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file adaptive_mod.h
+ * @brief Header file for modular integers and batched modular arithmetic.
+ *
+ * This file defines `adaptive_mod`, an unsigned integer in `[0, M)` whose add, sub, mul
+ * and pow wrap around the modulus `M`, and the batch functions `mod_reduce`, `mod_add`,
+ * `mod_sub` and `mod_mul` over uint32 `adaptive_vector`s. The modulus is either a template
+ * argument or, for `adaptive_mod<TINT>`, given at runtime as a `modulus`. Either way
+ * the reciprocal is computed once and every reduction is a Barrett multiply-shift
+ * instead of a hardware divide; the SSE/AVX batch kernels use Montgomery reduction on
+ * `_mm_mul_epu32` for odd moduli below 2^31.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_MOD__
+#define __ADAPTIVE_MOD__ 1
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adaptive_vector.h>
+
+#include <internal/kernel_mod.h>
+
+namespace adaptive {
+    /**
+     * @brief A runtime modulus with its precomputed reciprocal, at least 2
+     *
+     * @tparam TINT The unsigned type of the modulus
+     */
+    template <typename TINT>
+    using modulus = internal::barrett_reducer<TINT>;
+
+namespace internal {
+    /**
+     * @brief Holds the modulus of `adaptive_mod`: a compile time constant, no storage
+     */
+    template <typename TINT, TINT M, bool TDYNAMIC = (M == 0)>
+    struct mod_base {
+        static_assert(M >= 2, "adaptive_mod: modulus must be at least 2");
+        static constexpr modulus<TINT> s_reducer{ M };
+
+        mod_base() noexcept = default;
+        const modulus<TINT>& reducer() const noexcept { return s_reducer; }
+    };
+    /**
+     * @brief Holds the modulus of `adaptive_mod`: given at runtime, stored in every value
+     */
+    template <typename TINT, TINT M>
+    struct mod_base<TINT, M, true> {
+        explicit mod_base(const modulus<TINT>& m) noexcept : m_rReducer(m) { }
+        const modulus<TINT>& reducer() const noexcept { return m_rReducer; }
+
+    protected:
+        modulus<TINT> m_rReducer;
+    };
+}
+
+    /**
+     * @brief An unsigned integer modulo `M`
+     *
+     * All operations keep the value in `[0, M)`, reductions use the precomputed Barrett
+     * reciprocal of the modulus instead of a divide. With `M == 0` the modulus is given
+     * at construction and both operands of a binary operation must share it.
+     *
+     * @tparam TINT The unsigned integer type of the value and the modulus
+     * @tparam M The modulus, 0 for a runtime modulus
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_mod<uint32_t, 998244353> a(3);
+     * auto b = a.pow(1000000) * a + 1;
+     *
+     * adaptive::modulus<uint64_t> shards(1000003);
+     * adaptive::adaptive_mod<uint64_t> h(0x9E3779B97F4A7C15ull, shards);
+     * @endcode
+     */
+    template <typename TINT, TINT M = 0>
+    class adaptive_mod : protected internal::mod_base<TINT, M> {
+        static_assert(std::is_unsigned<TINT>::value, "adaptive_mod: unsigned integer type required");
+        using base_type = internal::mod_base<TINT, M>;
+    public:
+        using this_type = adaptive_mod<TINT, M>;
+        using value_type = TINT;
+        using modulus_type = modulus<TINT>;
+        using const_refernce = const this_type&;
+
+        static constexpr bool is_dynamic = (M == 0);
+
+        /**
+         * @brief Constructor for zero, compile time modulus only
+         */
+        template <TINT TM = M, typename = typename std::enable_if<TM != 0>::type>
+        adaptive_mod() noexcept
+            : base_type(), m_tiValue(0) { }
+        /**
+         * @brief Constructor for `v mod M`, compile time modulus only
+         */
+        template <TINT TM = M, typename = typename std::enable_if<TM != 0>::type>
+        explicit adaptive_mod(value_type v) noexcept
+            : base_type(), m_tiValue(base_type::reducer().reduce(v)) { }
+        /**
+         * @brief Constructor for `v mod m`, runtime modulus only
+         */
+        template <TINT TM = M, typename = typename std::enable_if<TM == 0>::type>
+        adaptive_mod(value_type v, const modulus_type& m) noexcept
+            : base_type(m), m_tiValue(m.reduce(v)) { }
+
+        /**
+         * @brief Get the value in `[0, modulus())`
+         */
+        value_type value() const noexcept            { return m_tiValue; }
+        explicit operator value_type() const noexcept { return m_tiValue; }
+        value_type get_modulus() const noexcept      { return base_type::reducer().modulus(); }
+
+        /**
+         * @brief `this^e`, `0^0` is 1
+         */
+        this_type pow(uint64_t e) const noexcept {
+            return make(base_type::reducer().pow(m_tiValue, e));
+        }
+
+        this_type operator + (const_refernce o) const { check(o); return make(base_type::reducer().add(m_tiValue, o.m_tiValue)); }
+        this_type operator - (const_refernce o) const { check(o); return make(base_type::reducer().sub(m_tiValue, o.m_tiValue)); }
+        this_type operator * (const_refernce o) const { check(o); return make(base_type::reducer().mul(m_tiValue, o.m_tiValue)); }
+        this_type operator - () const noexcept        { return make(base_type::reducer().neg(m_tiValue)); }
+
+        /**
+         * @brief Operations with a plain integer, which is reduced first
+         */
+        this_type operator + (value_type v) const noexcept { return make(base_type::reducer().add(m_tiValue, base_type::reducer().reduce(v))); }
+        this_type operator - (value_type v) const noexcept { return make(base_type::reducer().sub(m_tiValue, base_type::reducer().reduce(v))); }
+        this_type operator * (value_type v) const noexcept { return make(base_type::reducer().mul(m_tiValue, base_type::reducer().reduce(v))); }
+
+        this_type& operator += (const_refernce o) { return *this = *this + o; }
+        this_type& operator -= (const_refernce o) { return *this = *this - o; }
+        this_type& operator *= (const_refernce o) { return *this = *this * o; }
+        this_type& operator += (value_type v) noexcept { return *this = *this + v; }
+        this_type& operator -= (value_type v) noexcept { return *this = *this - v; }
+        this_type& operator *= (value_type v) noexcept { return *this = *this * v; }
+
+        /**
+         * @brief Equality, values with different runtime moduli are never equal
+         */
+        bool operator == (const_refernce o) const noexcept {
+            return m_tiValue == o.m_tiValue && get_modulus() == o.get_modulus();
+        }
+        bool operator != (const_refernce o) const noexcept { return !(*this == o); }
+
+    protected:
+        /**
+         * @brief Wraps an already reduced value with the modulus of this value
+         */
+        this_type make(value_type reduced) const noexcept {
+            this_type _result(*this);
+            _result.m_tiValue = reduced;
+            return _result;
+        }
+        /**
+         * @throw std::invalid_argument if the runtime moduli of both operands differ
+         */
+        void check(const_refernce o) const {
+            if constexpr (is_dynamic) {
+                if(get_modulus() != o.get_modulus()) throw std::invalid_argument("adaptive_mod: operands have different moduli");
+            } else {
+                (void)o;
+            }
+        }
+
+    protected:
+        /**
+         * @brief The value, always below the modulus
+         */
+        value_type m_tiValue;
+    };
+
+    template <uint32_t M = 0>
+    using mod32_t = adaptive_mod<uint32_t, M>;
+    template <uint64_t M = 0>
+    using mod64_t = adaptive_mod<uint64_t, M>;
+
+    /**
+     * @brief `out[i] = a[i] mod m` for any `a[i]`, the divide free replacement of `%`
+     *
+     * @param a The values
+     * @param out Receives the residues, resized to `a.size()`, may be `a`
+     * @param m The modulus
+     */
+    template <techn_t TTECH>
+    void mod_reduce(const adaptive_vector<uint32_t, TTECH>& a, adaptive_vector<uint32_t, TTECH>& out,
+                    const modulus<uint32_t>& m) {
+        out.resize(a.size());
+        internal::mod_kernel<TTECH>::reduce(a.data(), out.data(), a.size(), m);
+    }
+    /**
+     * @brief `out[i] = (a[i] + b[i]) mod m`, the inputs must be below `m`
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <techn_t TTECH>
+    void mod_add(const adaptive_vector<uint32_t, TTECH>& a, const adaptive_vector<uint32_t, TTECH>& b,
+                 adaptive_vector<uint32_t, TTECH>& out, const modulus<uint32_t>& m) {
+        if(a.size() != b.size()) throw std::invalid_argument("mod_add: sizes do not match");
+        out.resize(a.size());
+        internal::mod_kernel<TTECH>::add(a.data(), b.data(), out.data(), a.size(), m);
+    }
+    /**
+     * @brief `out[i] = (a[i] - b[i]) mod m`, the inputs must be below `m`
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <techn_t TTECH>
+    void mod_sub(const adaptive_vector<uint32_t, TTECH>& a, const adaptive_vector<uint32_t, TTECH>& b,
+                 adaptive_vector<uint32_t, TTECH>& out, const modulus<uint32_t>& m) {
+        if(a.size() != b.size()) throw std::invalid_argument("mod_sub: sizes do not match");
+        out.resize(a.size());
+        internal::mod_kernel<TTECH>::sub(a.data(), b.data(), out.data(), a.size(), m);
+    }
+    /**
+     * @brief `out[i] = a[i] * b[i] mod m` for any `a[i]`, `b[i]` must be below `m`
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <techn_t TTECH>
+    void mod_mul(const adaptive_vector<uint32_t, TTECH>& a, const adaptive_vector<uint32_t, TTECH>& b,
+                 adaptive_vector<uint32_t, TTECH>& out, const modulus<uint32_t>& m) {
+        if(a.size() != b.size()) throw std::invalid_argument("mod_mul: sizes do not match");
+        out.resize(a.size());
+        internal::mod_kernel<TTECH>::mul(a.data(), b.data(), out.data(), a.size(), m);
+    }
+    /**
+     * @brief `out[i] = a[i] * c mod m` for any `a[i]` and `c`
+     */
+    template <techn_t TTECH>
+    void mod_mul(const adaptive_vector<uint32_t, TTECH>& a, uint32_t c,
+                 adaptive_vector<uint32_t, TTECH>& out, const modulus<uint32_t>& m) {
+        out.resize(a.size());
+        internal::mod_kernel<TTECH>::scale(a.data(), m.reduce(c), out.data(), a.size(), m);
+    }
+}
+
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file adaptive_ntt.h
+ * @brief Header file for the number-theoretic transform, polynomial and big number multiplication.
+ *
+ * This file defines `ntt_plan`, the twiddle tables of a power of two transform modulo an
+ * NTT-friendly prime, and on top of it `ntt_convolve`, the linear convolution of two
+ * `adaptive_vector`s modulo the prime, and `bignum_multiply`, the exact product of two
+ * unsigned big numbers. Both replace the quadratic schoolbook product by three
+ * transforms and a pointwise product, `O(n log n)`; inputs too short to pay for the
+ * transforms still take the schoolbook path.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_NTT__
+#define __ADAPTIVE_NTT__ 1
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include <adaptive_mod.h>
+#include <adaptive_vector.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/kernel_ntt.h>
+
+/**
+ * @brief Shorter operand length up to which convolutions and big number products stay schoolbook.
+ */
+#ifndef ADAPTIVE_NTT_NAIVE_MAX
+#define ADAPTIVE_NTT_NAIVE_MAX 32
+#endif
+
+namespace adaptive {
+    /**
+     * @brief Precomputed twiddle tables for transforms of up to `max_size` elements modulo a prime
+     *
+     * The prime must be odd with `max_size` dividing `prime - 1`, 32-bit primes must be below
+     * 2^30. The defaults are 998244353 = 119 * 2^23 + 1 for uint32_t (up to 2^23 elements) and
+     * 2^64 - 2^32 + 1 for uint64_t (up to 2^32 elements). A plan for `max_size` serves every
+     * smaller power of two as well.
+     *
+     * `forward` leaves the spectrum in bit-reversed order and `inverse` expects it that way,
+     * which is all a convolution needs and saves the permutation passes.
+     *
+     * @tparam TINT uint32_t or uint64_t
+     *
+     * Example usage:
+     * @code
+     * adaptive::ntt_plan<uint32_t> plan(1 << 20);
+     * plan.forward(v);                // v.size() a power of two, values below the prime
+     * plan.inverse(v);                // v is back
+     * @endcode
+     */
+    template <typename TINT>
+    class ntt_plan {
+        static_assert(std::is_same<TINT, uint32_t>::value || std::is_same<TINT, uint64_t>::value,
+                      "ntt_plan: uint32_t or uint64_t");
+    public:
+        using this_type = ntt_plan<TINT>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using field_type = internal::ntt_field<TINT>;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+
+        static constexpr value_type default_prime = sizeof(TINT) == 4 ? value_type(998244353u) : value_type(0xFFFFFFFF00000001ull);
+        static constexpr value_type default_generator = sizeof(TINT) == 4 ? 3 : 7;
+
+        /**
+         * @brief Constructor, computes the twiddle tables
+         *
+         * @param max_size The largest transform length, a power of two
+         * @param prime The prime modulus
+         * @param generator A primitive root modulo `prime`
+         *
+         * @throw std::invalid_argument if `max_size` is no power of two, the prime is unsuitable or the
+         * generator does not yield a root of unity of order `max_size`
+         */
+        explicit ntt_plan(size_type max_size, value_type prime = default_prime, value_type generator = default_generator)
+            : m_szMax(max_size), m_fField(check_prime(prime)), m_vTwiddles(max_size), m_vInvTwiddles(max_size) {
+            if(max_size == 0 || (max_size & (max_size - 1)) != 0) throw std::invalid_argument("ntt_plan: size must be a power of two");
+            if((prime - 1) % max_size != 0) throw std::invalid_argument("ntt_plan: size does not divide prime - 1");
+
+            const modulus<value_type> red(prime);
+            const value_type w = red.pow(red.reduce(generator), (prime - 1) / max_size);
+            if(max_size > 1 && red.pow(w, max_size / 2) != prime - 1)
+                throw std::invalid_argument("ntt_plan: generator is not a primitive root");
+
+            fill_twiddles(red, w, m_vTwiddles);
+            fill_twiddles(red, red.pow(w, max_size - 1), m_vInvTwiddles);
+        }
+
+        /**
+         * @brief Get the largest supported transform length
+         */
+        size_type max_size() const noexcept      { return m_szMax; }
+        value_type prime() const noexcept        { return m_fField.p; }
+        const field_type& field() const noexcept { return m_fField; }
+
+        /**
+         * @brief In-place forward transform, the result is in bit-reversed order
+         *
+         * @param a The values, all below the prime, a power of two of them
+         *
+         * @throw std::invalid_argument if the size is no power of two or exceeds `max_size()`
+         */
+        template <techn_t TTECH>
+        void forward(adaptive_vector<value_type, TTECH>& a) const {
+            forward<TTECH>(a.data(), a.size());
+        }
+        /**
+         * @brief In-place inverse transform of a bit-reversed spectrum, scaled by `1/n`
+         *
+         * @throw std::invalid_argument if the size is no power of two or exceeds `max_size()`
+         */
+        template <techn_t TTECH>
+        void inverse(adaptive_vector<value_type, TTECH>& a) const {
+            inverse<TTECH>(a.data(), a.size(), false);
+        }
+
+        template <techn_t TTECH>
+        void forward(value_type* a, size_type n) const {
+            check_size(n);
+            internal::ntt_kernel<TINT, TTECH>::forward(m_fField, a, n, m_vTwiddles.data());
+        }
+        /**
+         * @brief Inverse transform, with `after_product` the `R^-1` of one Montgomery
+         * pointwise product is undone as well
+         */
+        template <techn_t TTECH>
+        void inverse(value_type* a, size_type n, bool after_product) const {
+            check_size(n);
+            const modulus<value_type> red(m_fField.p);
+            value_type scale = m_fField.to_mont(red.pow(red.reduce(value_type(n)), m_fField.p - 2));
+            if(after_product) scale = m_fField.to_mont(scale);
+            internal::ntt_kernel<TINT, TTECH>::inverse(m_fField, a, n, m_vInvTwiddles.data(), scale);
+        }
+        /**
+         * @brief Pointwise product of two spectra into `a`, times `R^-1`, see `inverse`
+         */
+        template <techn_t TTECH>
+        void multiply(value_type* a, const value_type* b, size_type n) const {
+            internal::ntt_kernel<TINT, TTECH>::pointwise(m_fField, a, b, n, 0);
+        }
+
+    protected:
+        static value_type check_prime(value_type prime) {
+            if(prime < 3 || (prime & 1) == 0) throw std::invalid_argument("ntt_plan: prime must be odd");
+            if(sizeof(TINT) == 4 && prime >= (value_type(1) << 30)) throw std::invalid_argument("ntt_plan: 32-bit prime must be below 2^30");
+            return prime;
+        }
+        void check_size(size_type n) const {
+            if(n == 0 || (n & (n - 1)) != 0 || n > m_szMax) throw std::invalid_argument("ntt_plan: invalid transform size");
+        }
+        /**
+         * @brief `tw[h + j] = w_(2h)^j * R` for every half size `h`, `w` of order `max_size`
+         */
+        void fill_twiddles(const modulus<value_type>& red, value_type w, storage_type& tw) const {
+            for(size_type h = m_szMax / 2; h >= 1; h /= 2) {
+                value_type _x = 1;
+                for(size_type j = 0; j < h; ++j) {
+                    tw[h + j] = m_fField.to_mont(_x);
+                    _x = red.mul(_x, w);
+                }
+                w = red.mul(w, w);
+            }
+        }
+
+    protected:
+        size_type m_szMax;
+        field_type m_fField;
+        /**
+         * @brief The twiddles of the forward and the inverse transform, see `internal::ntt_kernel`
+         */
+        storage_type m_vTwiddles;
+        storage_type m_vInvTwiddles;
+    };
+
+namespace internal {
+    /**
+     * @brief Schoolbook linear convolution modulo the prime of `red`
+     */
+    template <typename TINT, techn_t TTECH>
+    void ntt_convolve_naive(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+                            adaptive_vector<TINT, TTECH>& out, const barrett_reducer<TINT>& red) {
+        adaptive_vector<TINT, TTECH> _result(a.size() + b.size() - 1);
+        for(size_t i = 0; i < a.size(); ++i) {
+            const TINT ai = red.reduce(a[i]);
+            for(size_t j = 0; j < b.size(); ++j)
+                _result[i + j] = red.add(_result[i + j], red.mul(ai, red.reduce(b[j])));
+        }
+        out = std::move(_result);
+    }
+}
+
+    /**
+     * @brief Linear convolution modulo the prime of `plan`, `out[k] = sum a[i] * b[k - i]`
+     *
+     * @param a The first coefficients, taken modulo the prime
+     * @param b The second coefficients, taken modulo the prime
+     * @param out Receives `a.size() + b.size() - 1` coefficients (none if an input is empty), may alias an input
+     * @param plan A plan covering the next power of two of the output size
+     *
+     * @throw std::invalid_argument if the plan is too small
+     */
+    template <typename TINT, techn_t TTECH>
+    void ntt_convolve(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+                      adaptive_vector<TINT, TTECH>& out, const ntt_plan<TINT>& plan) {
+        if(a.empty() || b.empty()) { out.resize(0); return; }
+
+        const modulus<TINT> red(plan.prime());
+        if(std::min(a.size(), b.size()) <= ADAPTIVE_NTT_NAIVE_MAX) {
+            internal::ntt_convolve_naive(a, b, out, red);
+            return;
+        }
+
+        const size_t len = a.size() + b.size() - 1;
+        size_t n = 1;
+        while(n < len) n *= 2;
+        adaptive_vector<TINT, TTECH> fa(n), fb(n);
+        std::transform(a.begin(), a.end(), fa.begin(), [&red](TINT v) { return red.reduce(v); });
+        std::transform(b.begin(), b.end(), fb.begin(), [&red](TINT v) { return red.reduce(v); });
+
+        plan.template forward<TTECH>(fa.data(), n);
+        plan.template forward<TTECH>(fb.data(), n);
+        plan.template multiply<TTECH>(fa.data(), fb.data(), n);
+        plan.template inverse<TTECH>(fa.data(), n, true);
+        fa.resize(len);
+        out = std::move(fa);
+    }
+    /**
+     * @brief Linear convolution modulo `prime`, with a plan made for this size
+     *
+     * @throw std::invalid_argument if the prime or generator are unsuitable for the size
+     */
+    template <typename TINT, techn_t TTECH>
+    void ntt_convolve(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+                      adaptive_vector<TINT, TTECH>& out,
+                      typename ntt_plan<TINT>::value_type prime = ntt_plan<TINT>::default_prime,
+                      typename ntt_plan<TINT>::value_type generator = ntt_plan<TINT>::default_generator) {
+        if(a.empty() || b.empty()) { out.resize(0); return; }
+        if(std::min(a.size(), b.size()) <= ADAPTIVE_NTT_NAIVE_MAX) {
+            internal::ntt_convolve_naive(a, b, out, modulus<TINT>(prime));
+            return;
+        }
+        size_t n = 1;
+        while(n < a.size() + b.size() - 1) n *= 2;
+        ntt_convolve(a, b, out, ntt_plan<TINT>(n, prime, generator));
+    }
+
+    /**
+     * @brief Exact product of two unsigned big numbers
+     *
+     * The numbers are little-endian arrays of 32-bit limbs. Long products are split into
+     * 16-bit digits and convolved modulo 2^64 - 2^32 + 1, which holds every digit sum exactly,
+     * then the carries are propagated.
+     *
+     * @param a The first factor
+     * @param b The second factor
+     * @param out Receives the product without leading zero limbs (empty for zero), may alias an input
+     *
+     * Example usage:
+     * @code
+     * adaptive::uint32_vector_t<> x(100000, 0xFFFFFFFFu), y(100000, 7), z;
+     * adaptive::bignum_multiply(x, y, z);
+     * @endcode
+     */
+    template <techn_t TTECH>
+    void bignum_multiply(const adaptive_vector<uint32_t, TTECH>& a, const adaptive_vector<uint32_t, TTECH>& b,
+                         adaptive_vector<uint32_t, TTECH>& out) {
+        adaptive_vector<uint32_t, TTECH> _result(a.size() + b.size());
+
+        if(std::min(a.size(), b.size()) <= ADAPTIVE_NTT_NAIVE_MAX) {
+            for(size_t i = 0; i < a.size(); ++i) {
+                uint64_t carry = 0;
+                for(size_t j = 0; j < b.size(); ++j) {
+                    const uint64_t t = uint64_t(a[i]) * b[j] + _result[i + j] + carry;
+                    _result[i + j] = uint32_t(t);
+                    carry = t >> 32;
+                }
+                _result[i + b.size()] = uint32_t(carry);
+            }
+        } else {
+            const size_t len = 2 * (a.size() + b.size()) - 1;
+            size_t n = 1;
+            while(n < len) n *= 2;
+
+            const ntt_plan<uint64_t> plan(n);
+            adaptive_vector<uint64_t, TTECH> da(n), db(n);
+            for(size_t i = 0; i < a.size(); ++i) { da[2 * i] = a[i] & 0xFFFFu; da[2 * i + 1] = a[i] >> 16; }
+            for(size_t i = 0; i < b.size(); ++i) { db[2 * i] = b[i] & 0xFFFFu; db[2 * i + 1] = b[i] >> 16; }
+
+            plan.template forward<TTECH>(da.data(), n);
+            plan.template forward<TTECH>(db.data(), n);
+            plan.template multiply<TTECH>(da.data(), db.data(), n);
+            plan.template inverse<TTECH>(da.data(), n, true);
+
+            // The digit sums stay below 2^63, the carry below 2^48.
+            uint64_t carry = 0;
+            for(size_t i = 0; i < _result.size(); ++i) {
+                const uint64_t lo = da[2 * i] + carry;
+                const uint64_t hi = da[2 * i + 1] + (lo >> 16);
+                _result[i] = uint32_t(lo & 0xFFFFu) | uint32_t(hi << 16);
+                carry = hi >> 16;
+            }
+        }
+
+        size_t _size = _result.size();
+        while(_size > 0 && _result[_size - 1] == 0) --_size;
+        _result.resize(_size);
+        out = std::move(_result);
+    }
+}
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file adaptive_numa.h
+ * @brief Header file for placing adaptive vectors on the NUMA nodes of the machine.
+ *
+ * On a machine with several sockets the pages of a vector live on the node of the thread
+ * that wrote them first, usually the one that constructed the vector, and the parallel
+ * kernels running on the other sockets read them at remote memory speed. `numa_place`
+ * moves the pages of an existing vector: interleaved over all nodes for data every
+ * thread reads, or chunk by chunk to the node of the pool thread that processes that
+ * chunk in `parallel_for`, the partition the parallel kernels use:
+ *
+ * @code
+ * adaptive::adaptive_vector<uint32_t> v(1 << 28);
+ * adaptive::numa_place(v, adaptive::numa_policy::first_touch);
+ * @endcode
+ *
+ * New containers get the placement from `numa_allocator` instead. Both use `mbind`
+ * without libnuma and do nothing on machines with a single node. The placement lives
+ * here and not in `aligned_allocator`, so the containers do not depend on the pool.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_NUMA__
+#define __ADAPTIVE_NUMA__ 1
+
+#include <cstddef>
+#include <new>
+
+#include <adaptive_thread_pool.h>
+#include <adaptive_vector.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/numa.h>
+
+namespace adaptive {
+    /**
+     * @brief Get the number of NUMA nodes of the machine, 1 where they are not known
+     */
+    inline size_t numa_nodes() noexcept {
+        return internal::numa_node_count();
+    }
+
+    /**
+     * @class numa_allocator
+     * @brief An `aligned_allocator` that places the pages of each allocation with `TNUMA`
+     *
+     * The storage is page aligned. `numa_policy::first_touch` zeroes the chunks of the
+     * `parallel_for` partition of `thread_pool::instance()` on the threads that get them.
+     *
+     * @tparam T The element type to allocate.
+     * @tparam TNUMA The placement of the pages on the NUMA nodes.
+     * @tparam TALIGN The minimal alignment in bytes.
+     *
+     * Example usage:
+     * @code
+     * // A lookup table every thread reads, spread over the sockets
+     * std::vector<uint32_t, adaptive::numa_allocator<uint32_t, adaptive::numa_policy::interleave> > table(n);
+     * @endcode
+     */
+    template <typename T, numa_policy TNUMA, size_t TALIGN = ADAPTIVE_DEFAULT_ALIGNMENT>
+    class numa_allocator {
+    public:
+        using this_type = numa_allocator<T, TNUMA, TALIGN>;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        template <typename U>
+        struct rebind { using other = numa_allocator<U, TNUMA, TALIGN>; };
+
+        numa_allocator() noexcept = default;
+
+        template <typename U>
+        numa_allocator(const numa_allocator<U, TNUMA, TALIGN>&) noexcept { }
+
+        /**
+         * @brief Allocates page aligned storage for `n` elements and places its pages.
+         */
+        value_type* allocate(size_type n) {
+            value_type* _result = static_cast<value_type*>(::operator new(n * sizeof(value_type), std::align_val_t(alignment)));
+            if constexpr (TNUMA == numa_policy::interleave) internal::numa_interleave(_result, n * sizeof(value_type));
+            else if constexpr (TNUMA == numa_policy::first_touch) internal::numa_first_touch(_result, n, sizeof(value_type), true, false);
+            return _result;
+        }
+        /**
+         * @brief Releases storage that was obtained with `allocate`.
+         */
+        void deallocate(value_type* p, size_type n) noexcept {
+            (void)n;
+            ::operator delete(p, std::align_val_t(alignment));
+        }
+
+        template <typename U>
+        bool operator == (const numa_allocator<U, TNUMA, TALIGN>&) const noexcept { return true; }
+        template <typename U>
+        bool operator != (const numa_allocator<U, TNUMA, TALIGN>&) const noexcept { return false; }
+
+    protected:
+        /**
+         * @brief The alignment of the storage, whole pages for the NUMA policies
+         */
+        static constexpr size_t alignment = (TNUMA == numa_policy::none || TALIGN >= 4096) ? TALIGN : 4096;
+    };
+
+    /**
+     * @brief Moves the pages of `v` to the nodes `policy` selects
+     *
+     * Partly used pages at both ends stay where they are. For `numa_policy::first_touch`
+     * a chunk goes to the node of the thread that got it from `pool`. Unpinned threads may
+     * be moved to another node later; construct the pool with a `thread_affinity` placement
+     * so every chunk stays next to the thread that processes it.
+     *
+     * @param v The vector
+     * @param policy The placement, `numa_policy::none` leaves the pages as they are
+     * @param pool The pool whose partition `first_touch` follows
+     * @return True if pages were placed, false on single node machines
+     */
+    template <typename TINT, techn_t TTECH>
+    bool numa_place(adaptive_vector<TINT, TTECH>& v, numa_policy policy, thread_pool& pool = thread_pool::instance()) {
+        if(numa_nodes() < 2 || v.empty()) return false;
+        switch(policy) {
+            case numa_policy::interleave:
+                return internal::numa_interleave(v.data(), v.size() * sizeof(TINT), true);
+            case numa_policy::first_touch:
+                internal::numa_first_touch(v.data(), v.size(), sizeof(TINT), false, true, pool);
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file adaptive_numeric.h
+ * @brief Header file for element-wise integer math over adaptive vectors.
+ *
+ * This file defines batch versions of the `<numeric>` integer functions: `gcd` and
+ * `lcm` of two `adaptive_vector`s, element by element. They run Stein's binary GCD,
+ * which needs no divide, on every SIMD lane at once (32-bit and 64-bit lanes on AVX)
+ * and scalar with `tzcnt` otherwise.
+ *
+ * For unsigned vectors it also has the integer functions of bucketing and size class
+ * code, `ilog2`, `ilog10`, `isqrt` and `ipow` (with overflow detection), with SSE/AVX
+ * kernels for 32-bit and AVX kernels for 64-bit elements.
+ *
+ * The element-wise `abs`, `min`, `max`, `clamp`, `sign` and rounding `avg` of every
+ * integer type run the batch functions of the technique backend of the vector.
+ *
+ * `inclusive_scan` and `exclusive_scan` are prefix sums with SIMD kernels; the versions
+ * that take a `thread_pool` scan in two passes, each chunk first sums its part, the sums
+ * are scanned, then every chunk scans its part from its offset.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_NUMERIC__
+#define __ADAPTIVE_NUMERIC__ 1
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+#include <adaptive_thread_pool.h>
+#include <adaptive_vector.h>
+
+#include <internal/kernel_gcd.h>
+#include <internal/kernel_intmath.h>
+#include <internal/kernel_scan.h>
+#include <internal/parallel_for.h>
+
+#ifndef ADAPTIVE_SCAN_MIN_CHUNK
+/**
+ * @brief Fewest elements per chunk of a parallel scan, below the work is not worth a thread
+ */
+#define ADAPTIVE_SCAN_MIN_CHUNK (size_t(1) << 16)
+#endif
+
+namespace adaptive {
+    /**
+     * @brief `out[i] = gcd(a[i], b[i])`, non-negative, `gcd(0, 0) = 0`
+     *
+     * @param a The first operands
+     * @param b The second operands
+     * @param out Receives the divisors, resized to `a.size()`, may be `a` or `b`
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     *
+     * Example usage:
+     * @code
+     * adaptive::gcd(num, den, g);   // normalize num / den
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    void gcd(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+             adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "gcd: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("gcd: sizes do not match");
+        out.resize(a.size());
+        internal::gcd_kernel<TINT, TTECH>::gcd(a.data(), b.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = lcm(a[i], b[i])`, non-negative, 0 if either operand is 0
+     *
+     * Wraps if the multiple does not fit `TINT`.
+     *
+     * @param a The first operands
+     * @param b The second operands
+     * @param out Receives the multiples, resized to `a.size()`, may be `a` or `b`
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    void lcm(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+             adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "lcm: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("lcm: sizes do not match");
+        out.resize(a.size());
+        internal::gcd_kernel<TINT, TTECH>::lcm(a.data(), b.data(), out.data(), a.size());
+    }
+
+    /**
+     * @brief `out[i] = floor(log2(a[i]))`, 0 for `a[i] == 0`
+     *
+     * @param a The values
+     * @param out Receives the logarithms, resized to `a.size()`, may be `a`
+     */
+    template <typename TINT, techn_t TTECH>
+    void ilog2(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_unsigned<TINT>::value, "ilog2: unsigned integer type required");
+        out.resize(a.size());
+        internal::intmath_kernel<TINT, TTECH>::ilog2(a.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = floor(log10(a[i]))`, 0 for `a[i] == 0`
+     *
+     * @param a The values
+     * @param out Receives the logarithms, resized to `a.size()`, may be `a`
+     */
+    template <typename TINT, techn_t TTECH>
+    void ilog10(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_unsigned<TINT>::value, "ilog10: unsigned integer type required");
+        out.resize(a.size());
+        internal::intmath_kernel<TINT, TTECH>::ilog10(a.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = floor(sqrt(a[i]))`, exact for every value
+     *
+     * @param a The values
+     * @param out Receives the roots, resized to `a.size()`, may be `a`
+     */
+    template <typename TINT, techn_t TTECH>
+    void isqrt(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_unsigned<TINT>::value, "isqrt: unsigned integer type required");
+        out.resize(a.size());
+        internal::intmath_kernel<TINT, TTECH>::isqrt(a.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = a[i]^e` by squaring, `0^0 = 1`
+     *
+     * A power that does not fit `TINT` is saturated to its maximum.
+     *
+     * @param a The bases
+     * @param e The exponent
+     * @param out Receives the powers, resized to `a.size()`, may be `a`
+     * @return The number of saturated elements, 0 if every power is exact
+     *
+     * Example usage:
+     * @code
+     * if(adaptive::ipow(sizes, 3, volumes) != 0) throw std::overflow_error("volume too large");
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    size_t ipow(const adaptive_vector<TINT, TTECH>& a, uint32_t e, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_unsigned<TINT>::value, "ipow: unsigned integer type required");
+        out.resize(a.size());
+        return internal::intmath_kernel<TINT, TTECH>::ipow(a.data(), e, out.data(), a.size());
+    }
+
+    /**
+     * @brief `out[i] = |a[i]|`, the most negative value of a signed type stays itself
+     *
+     * @param a The values
+     * @param out Receives the absolute values, resized to `a.size()`, may be `a`
+     */
+    template <typename TINT, techn_t TTECH>
+    void abs(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "abs: integer type required");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::abs(a.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = min(a[i], b[i])`
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    void min(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+             adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "min: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("min: sizes do not match");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::min(a.data(), b.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = max(a[i], b[i])`
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    void max(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+             adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "max: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("max: sizes do not match");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::max(a.data(), b.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = a[i]` limited to `[lo, hi]`
+     *
+     * @throw std::invalid_argument if `lo > hi`
+     *
+     * Example usage:
+     * @code
+     * adaptive::clamp(samples, int16_t(-4096), int16_t(4095), samples);
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    void clamp(const adaptive_vector<TINT, TTECH>& a, typename std::common_type<TINT>::type lo,
+               typename std::common_type<TINT>::type hi, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "clamp: integer type required");
+        if(lo > hi) throw std::invalid_argument("clamp: lo must not be above hi");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::clamp(a.data(), lo, hi, out.data(), a.size());
+    }
+    /**
+     * @brief `out[i]` is -1, 0 or 1 by the sign of `a[i]`, 0 or 1 for unsigned types
+     */
+    template <typename TINT, techn_t TTECH>
+    void sign(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "sign: integer type required");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::sign(a.data(), out.data(), a.size());
+    }
+    /**
+     * @brief `out[i] = (a[i] + b[i] + 1) >> 1` without overflow, the `pavg` rounding
+     *
+     * @throw std::invalid_argument if the sizes of `a` and `b` differ
+     */
+    template <typename TINT, techn_t TTECH>
+    void avg(const adaptive_vector<TINT, TTECH>& a, const adaptive_vector<TINT, TTECH>& b,
+             adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "avg: integer type required");
+        if(a.size() != b.size()) throw std::invalid_argument("avg: sizes do not match");
+        out.resize(a.size());
+        adaptive_vector<TINT, TTECH>::backend_type::avg(a.data(), b.data(), out.data(), a.size());
+    }
+
+namespace internal {
+    /**
+     * @brief The reduce-then-scan prefix sum of `in[0, n)` on `pool`
+     *
+     * The chunk boundaries are on cache lines, so no two threads write to the same line.
+     * The last chunk's sum is not needed and not computed.
+     *
+     * @return `init` plus the sum of `in[0, n)`
+     */
+    template <bool TEXCL, typename TINT, techn_t TTECH>
+    TINT parallel_scan(const TINT* in, TINT* out, size_t n, TINT init, thread_pool& pool) {
+        using kernel = scan_kernel<TINT, TTECH>;
+        const size_t chunks = std::min(pool.size(), n / ADAPTIVE_SCAN_MIN_CHUNK);
+        if(chunks <= 1) return kernel::template scan<TEXCL>(in, out, n, init);
+
+        const size_t line = std::max<size_t>(1, ADAPTIVE_DEFAULT_ALIGNMENT / sizeof(TINT));
+        std::vector<size_t> bounds(chunks + 1);
+        for(size_t i = 0; i < chunks; ++i) bounds[i] = n / chunks * i / line * line;
+        bounds[chunks] = n;
+
+        std::vector<TINT> offsets(chunks);
+        parallel_for_bounds(bounds, [&](size_t c, size_t begin, size_t end) {
+            if(c + 1 < chunks) offsets[c] = kernel::reduce(in + begin, end - begin);
+        }, pool);
+        offsets[chunks - 1] = scan_kernel<TINT, techn_type::Scalar>::template scan<true>(offsets.data(), offsets.data(),
+                                                                                          chunks - 1, init);
+        TINT _result = init;
+        parallel_for_bounds(bounds, [&](size_t c, size_t begin, size_t end) {
+            const TINT total = kernel::template scan<TEXCL>(in + begin, out + begin, end - begin, offsets[c]);
+            if(c + 1 == chunks) _result = total;
+        }, pool);
+        return _result;
+    }
+}
+
+    /**
+     * @brief `out[i] = a[0] + ... + a[i]`, wrapping like unsigned arithmetic
+     *
+     * @param a The values
+     * @param out Receives the prefix sums, resized to `a.size()`, may be `a`
+     * @return The sum of all elements
+     *
+     * Example usage:
+     * @code
+     * adaptive::inclusive_scan(counts, ends);   // ends[i] is one past the last slot of bucket i
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    TINT inclusive_scan(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "inclusive_scan: integer type required");
+        out.resize(a.size());
+        return internal::scan_kernel<TINT, TTECH>::template scan<false>(a.data(), out.data(), a.size(), TINT(0));
+    }
+    /**
+     * @brief Multi-threaded `inclusive_scan` on `pool`
+     *
+     * Arrays below two chunks of `ADAPTIVE_SCAN_MIN_CHUNK` elements are scanned by the caller.
+     */
+    template <typename TINT, techn_t TTECH>
+    TINT inclusive_scan(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out, thread_pool& pool) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "inclusive_scan: integer type required");
+        out.resize(a.size());
+        return internal::parallel_scan<false, TINT, TTECH>(a.data(), out.data(), a.size(), TINT(0), pool);
+    }
+    /**
+     * @brief `out[i] = init + a[0] + ... + a[i - 1]`, wrapping like unsigned arithmetic
+     *
+     * @param a The values
+     * @param out Receives the prefix sums, resized to `a.size()`, may be `a`
+     * @param init The first prefix sum
+     * @return `init` plus the sum of all elements
+     *
+     * Example usage:
+     * @code
+     * size_t total = adaptive::exclusive_scan(counts, offsets, 0u, pool);   // write positions of the partitions
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH>
+    TINT exclusive_scan(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out,
+                        typename std::common_type<TINT>::type init = 0) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "exclusive_scan: integer type required");
+        out.resize(a.size());
+        return internal::scan_kernel<TINT, TTECH>::template scan<true>(a.data(), out.data(), a.size(), init);
+    }
+    /**
+     * @brief Multi-threaded `exclusive_scan` on `pool`
+     */
+    template <typename TINT, techn_t TTECH>
+    TINT exclusive_scan(const adaptive_vector<TINT, TTECH>& a, adaptive_vector<TINT, TTECH>& out,
+                        typename std::common_type<TINT>::type init, thread_pool& pool) {
+        static_assert(std::is_integral<TINT>::value && !std::is_same<TINT, bool>::value, "exclusive_scan: integer type required");
+        out.resize(a.size());
+        return internal::parallel_scan<true, TINT, TTECH>(a.data(), out.data(), a.size(), init, pool);
+    }
+}
+
+#endif
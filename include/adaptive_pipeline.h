@@ -0,0 +1,366 @@
+/**
+ * @file adaptive_pipeline.h
+ * @brief Header file for pipelines of stages that hand pooled adaptive chunks between threads.
+ *
+ * This file defines `chunk_pool`, a fixed set of equally sized `adaptive_vector` chunks,
+ * and `pipeline`, which runs a source, any number of stages and a sink on threads of
+ * their own and passes the chunks from one to the next through lock-free rings, so that
+ * I/O, decoding and compute overlap. Only pointers to the chunks move through the
+ * rings: every chunk is allocated when the pipeline is built and goes back to the pool
+ * after the sink, nothing is allocated per hand-off.
+ *
+ * @code
+ * adaptive::pipeline<uint8_t> p(1 << 16, 32);            // 32 chunks of 64 KiB
+ * p.source([&](auto& c) { c.size = read(in, c.data.data(), c.capacity()); return c.size != 0; });
+ * p.stage([](auto& c) { decode(c); }, 4);                // on 4 threads
+ * p.sink([&](auto& c) { write(out, c.data.data(), c.size); });
+ * p.run();
+ * @endcode
+ *
+ * Two ends of a ring with one thread each use an `spsc_ring`, all others an `mpmc_ring`.
+ * A stage on several threads may pass the chunks on out of order, `pipeline_chunk::sequence`
+ * numbers them in the order of the source.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_PIPELINE__
+#define __ADAPTIVE_PIPELINE__ 1
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <adaptive_ring.h>
+#include <adaptive_vector.h>
+
+namespace adaptive {
+    /**
+     * @brief A chunk of a pipeline, fixed storage and the number of valid elements
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    struct pipeline_chunk {
+        using vector_type = adaptive_vector<TINT, TTECH>;
+
+        /**
+         * @brief The storage, `capacity()` elements, never resized by the pipeline
+         */
+        vector_type data;
+        /**
+         * @brief The number of valid elements at the front of `data`
+         */
+        size_t size = 0;
+        /**
+         * @brief The position of the chunk in the order of the source
+         */
+        uint64_t sequence = 0;
+
+        explicit pipeline_chunk(size_t capacity)
+            : data(capacity) { }
+
+        size_t capacity() const noexcept { return data.size(); }
+    };
+
+    /**
+     * @class chunk_pool
+     * @brief A fixed set of chunks handed out and returned without allocation
+     *
+     * @tparam TINT The element type
+     * @tparam TTECH The technique type of the chunks
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class chunk_pool {
+    public:
+        using this_type = chunk_pool<TINT, TTECH>;
+        using chunk_type = pipeline_chunk<TINT, TTECH>;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructor for `chunks` chunks of `chunk_size` elements
+         *
+         * @throw std::invalid_argument if `chunks` or `chunk_size` is 0
+         */
+        chunk_pool(size_type chunk_size, size_type chunks)
+            : m_rFree(checked_chunks(chunks)) {
+            if(chunk_size == 0) throw std::invalid_argument("chunk_pool: chunk size must not be 0");
+            m_vChunks.reserve(chunks);
+            for(size_t i = 0; i < chunks; ++i) {
+                m_vChunks.emplace_back(new chunk_type(chunk_size));
+                chunk_type* c = m_vChunks.back().get();
+                m_rFree.try_push(c);
+            }
+        }
+        chunk_pool(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        /**
+         * @brief Get the number of chunks of the pool
+         */
+        size_type size() const noexcept { return m_vChunks.size(); }
+
+        /**
+         * @brief Takes a free chunk
+         *
+         * @return The chunk, `nullptr` if all are in use
+         */
+        chunk_type* try_acquire() noexcept {
+            chunk_type* _result = nullptr;
+            m_rFree.try_pop(_result);
+            return _result;
+        }
+        /**
+         * @brief Returns a chunk of this pool, from any thread
+         */
+        void release(chunk_type* c) noexcept {
+            m_rFree.try_push(c);
+        }
+        /**
+         * @brief Returns every chunk, only while no thread holds one
+         */
+        void reclaim() noexcept {
+            chunk_type* c;
+            while(m_rFree.try_pop(c)) { }
+            for(auto& p : m_vChunks) {
+                c = p.get();
+                m_rFree.try_push(c);
+            }
+        }
+
+    protected:
+        static size_t checked_chunks(size_t chunks) {
+            if(chunks == 0) throw std::invalid_argument("chunk_pool: chunks must not be 0");
+            return chunks;
+        }
+
+    protected:
+        std::vector<std::unique_ptr<chunk_type> > m_vChunks;
+        mpmc_ring<chunk_type*> m_rFree;
+    };
+
+    /**
+     * @class pipeline
+     * @brief A chain of source, stages and sink on their own threads, connected by rings of chunks
+     *
+     * @tparam TINT The element type of the chunks
+     * @tparam TTECH The technique type of the chunks
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class pipeline {
+    public:
+        using this_type = pipeline<TINT, TTECH>;
+        using chunk_type = pipeline_chunk<TINT, TTECH>;
+        using size_type = size_t;
+        /**
+         * @brief Fills a chunk, returns false when there is nothing more, that chunk is dropped
+         */
+        using source_type = std::function<bool(chunk_type&)>;
+        using stage_type = std::function<void(chunk_type&)>;
+
+        /**
+         * @brief Constructor for a pipeline of `chunks` chunks of `chunk_size` elements
+         *
+         * The number of chunks bounds how many are in flight at once; about two per
+         * thread of the pipeline keeps every thread busy.
+         *
+         * @throw std::invalid_argument if `chunks` or `chunk_size` is 0
+         */
+        pipeline(size_type chunk_size, size_type chunks)
+            : m_pool(chunk_size, chunks), m_atStop(false) { }
+        pipeline(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        /**
+         * @brief Sets the function that fills the chunks, run on one thread
+         */
+        this_type& source(source_type fn) {
+            m_fnSource = std::move(fn);
+            return *this;
+        }
+        /**
+         * @brief Appends a stage that works on every chunk
+         *
+         * @param fn The stage function, called concurrently for different chunks if `threads > 1`
+         * @param threads The number of threads of the stage
+         * @throw std::invalid_argument if `threads` is 0
+         */
+        this_type& stage(stage_type fn, size_type threads = 1) {
+            if(threads == 0) throw std::invalid_argument("pipeline::stage: threads must not be 0");
+            m_vStages.push_back(stage_info{ std::move(fn), threads });
+            return *this;
+        }
+        /**
+         * @brief Sets the function that consumes the chunks before they go back to the pool
+         */
+        this_type& sink(stage_type fn, size_type threads = 1) {
+            if(threads == 0) throw std::invalid_argument("pipeline::sink: threads must not be 0");
+            m_sink = stage_info{ std::move(fn), threads };
+            return *this;
+        }
+
+        /**
+         * @brief Runs the pipeline until the source is exhausted and the sink has every chunk
+         *
+         * If a function throws, every thread stops after its current chunk and the first
+         * exception is rethrown here.
+         *
+         * @throw std::invalid_argument if the source or the sink is missing
+         */
+        void run() {
+            if(!m_fnSource || !m_sink.fn) throw std::invalid_argument("pipeline::run: source and sink required");
+
+            // Link k feeds stage k, the last one feeds the sink.
+            std::vector<const stage_info*> _consumers;
+            for(const auto& s : m_vStages) _consumers.push_back(&s);
+            _consumers.push_back(&m_sink);
+            std::vector<std::unique_ptr<link> > _links;
+            size_t _producers = 1;
+            for(const stage_info* s : _consumers) {
+                _links.emplace_back(new link(m_pool.size(), _producers, s->threads));
+                _producers = s->threads;
+            }
+
+            m_atStop.store(false, std::memory_order_relaxed);
+            m_error = nullptr;
+            std::vector<std::thread> _threads;
+            try {
+                _threads.emplace_back([this, &_links]() { guarded([&]() { run_source(*_links[0]); }); });
+                for(size_t k = 0; k < _consumers.size(); ++k) {
+                    link* out = k + 1 < _links.size() ? _links[k + 1].get() : nullptr;
+                    for(size_t t = 0; t < _consumers[k]->threads; ++t) {
+                        _threads.emplace_back([this, &_links, &_consumers, k, out]() {
+                            guarded([&]() { run_stage(*_consumers[k], *_links[k], out); });
+                            if(out != nullptr) out->producer_done();
+                        });
+                    }
+                }
+            } catch(...) {
+                m_atStop.store(true, std::memory_order_release);
+                for(auto& l : _links) l->close();
+                for(auto& t : _threads) t.join();
+                m_pool.reclaim();
+                throw;
+            }
+            for(auto& t : _threads) t.join();
+            m_pool.reclaim();
+            if(m_error) std::rethrow_exception(m_error);
+        }
+
+    protected:
+        struct stage_info {
+            stage_type fn;
+            size_t threads = 1;
+        };
+
+        /**
+         * @brief The ring between two steps, closed when its last producer is done
+         */
+        struct link {
+            std::unique_ptr<spsc_ring<chunk_type*> > spsc;
+            std::unique_ptr<mpmc_ring<chunk_type*> > mpmc;
+            std::atomic<size_t> producers;
+            std::atomic<bool> closed;
+
+            link(size_t capacity, size_t producer_threads, size_t consumer_threads)
+                : producers(producer_threads), closed(false) {
+                if(producer_threads == 1 && consumer_threads == 1) spsc.reset(new spsc_ring<chunk_type*>(capacity));
+                else mpmc.reset(new mpmc_ring<chunk_type*>(capacity));
+            }
+            bool try_push(chunk_type*& c) { return spsc ? spsc->try_push(c) : mpmc->try_push(c); }
+            bool try_pop(chunk_type*& c)  { return spsc ? spsc->try_pop(c) : mpmc->try_pop(c); }
+            void producer_done() {
+                if(producers.fetch_sub(1, std::memory_order_acq_rel) == 1) close();
+            }
+            void close() { closed.store(true, std::memory_order_release); }
+        };
+
+        template <typename TFUNC>
+        void guarded(TFUNC&& fn) noexcept {
+            try { fn(); }
+            catch(...) {
+                std::lock_guard<std::mutex> guard(m_mtxError);
+                if(!m_error) m_error = std::current_exception();
+                m_atStop.store(true, std::memory_order_release);
+            }
+        }
+        bool stopped() const noexcept { return m_atStop.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Pushes `c` to `out`, waiting while it is full
+         *
+         * The rings hold every chunk of the pool, so they are only full for a moment.
+         */
+        void push(link& out, chunk_type* c) {
+            spin_backoff _backoff;
+            while(!out.try_push(c)) _backoff.pause();
+        }
+        /**
+         * @brief Pops a chunk from `in`, waiting while it is empty and open
+         *
+         * @return False once `in` is closed and empty or the pipeline stops
+         */
+        bool pop(link& in, chunk_type*& c) {
+            spin_backoff _backoff;
+            while(!in.try_pop(c)) {
+                if(stopped()) return false;
+                if(in.closed.load(std::memory_order_acquire)) return in.try_pop(c);
+                _backoff.pause();
+            }
+            return true;
+        }
+
+        void run_source(link& out) {
+            uint64_t _sequence = 0;
+            spin_backoff _backoff;
+            while(!stopped()) {
+                chunk_type* c = m_pool.try_acquire();
+                if(c == nullptr) {
+                    _backoff.pause();
+                    continue;
+                }
+                _backoff.reset();
+                c->size = 0;
+                c->sequence = _sequence++;
+                bool more = false;
+                try { more = m_fnSource(*c); }
+                catch(...) { m_pool.release(c); throw; }
+                if(!more) {
+                    m_pool.release(c);
+                    break;
+                }
+                push(out, c);
+            }
+            out.producer_done();
+        }
+        void run_stage(const stage_info& s, link& in, link* out) {
+            chunk_type* c;
+            while(pop(in, c)) {
+                try { s.fn(*c); }
+                catch(...) { m_pool.release(c); throw; }
+                if(out != nullptr) push(*out, c);
+                else m_pool.release(c);
+            }
+        }
+
+    protected:
+        chunk_pool<TINT, TTECH> m_pool;
+        source_type m_fnSource;
+        std::vector<stage_info> m_vStages;
+        stage_info m_sink;
+        std::atomic<bool> m_atStop;
+        std::mutex m_mtxError;
+        std::exception_ptr m_error;
+    };
+}
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file adaptive_quantized.h
+ * @brief Header file for quantized int8 matrix multiplication on adaptive matrices.
+ *
+ * This file defines `packed_qmatrix`, a signed 8-bit right hand side packed once into
+ * panels, and the `qgemm` functions that multiply an unsigned 8-bit `adaptive_matrix`
+ * with it, accumulating in int32. Zero points of both operands are folded in with row
+ * and column sums, so the inner loop is a pure u8 x s8 dot product. The result can be
+ * kept as int32 or requantized to int8.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_QUANTIZED__
+#define __ADAPTIVE_QUANTIZED__ 1
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#include <adaptive_matrix.h>
+
+#include <internal/kernel_qgemm.h>
+
+namespace adaptive {
+    /**
+     * @brief Affine quantization parameters: `real = scale * (q - zero_point)`
+     */
+    struct quantization_params {
+        float scale = 1.0f;
+        int32_t zero_point = 0;
+    };
+
+    /**
+     * @brief A signed 8-bit matrix packed for `qgemm`
+     *
+     * The matrix is packed once into panels of eight columns with four consecutive `k`
+     * per column, the layout the `pmaddwd` and `vpdpbusd` kernels load directly. The
+     * column sums needed for the zero point correction are computed while packing.
+     */
+    class packed_qmatrix {
+    public:
+        using this_type = packed_qmatrix;
+        using value_type = int8_t;
+        using size_type = size_t;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+
+        packed_qmatrix() noexcept
+            : m_szRows(0), m_szCols(0), m_iZeroPoint(0) { }
+        /**
+         * @brief Packs the `K` x `N` matrix `b`
+         *
+         * @param b The right hand side
+         * @param zero_point The zero point of `b`
+         */
+        template <techn_t TTECH>
+        explicit packed_qmatrix(const adaptive_matrix<int8_t, TTECH>& b, int32_t zero_point = 0)
+            : m_szRows(b.rows()), m_szCols(b.cols()), m_iZeroPoint(zero_point),
+              m_vPanels(panels() * panel_size()), m_vColSums(b.cols()) {
+            internal::qgemm_pack_b(b.data(), b.stride(), m_szRows, m_szCols, m_vPanels.data(), m_vColSums.data());
+        }
+
+        /**
+         * @brief Get the depth `K` of the packed matrix
+         */
+        size_type rows() const noexcept       { return m_szRows; }
+        /**
+         * @brief Get the number of output columns `N`
+         */
+        size_type cols() const noexcept       { return m_szCols; }
+        int32_t zero_point() const noexcept   { return m_iZeroPoint; }
+        /**
+         * @brief Get the number of panels of `internal::qgemm_nr` columns
+         */
+        size_type panels() const noexcept     { return (m_szCols + internal::qgemm_nr - 1) / internal::qgemm_nr; }
+        /**
+         * @brief Get the size of one panel in bytes
+         */
+        size_type panel_size() const noexcept { return ((m_szRows + 3) / 4) * internal::qgemm_nr * 4; }
+
+        const value_type* panel(size_type p) const noexcept { return m_vPanels.data() + p * panel_size(); }
+        const int32_t* col_sums() const noexcept            { return m_vColSums.data(); }
+
+    protected:
+        size_type m_szRows;
+        size_type m_szCols;
+        int32_t m_iZeroPoint;
+        storage_type m_vPanels;
+        std::vector<int32_t> m_vColSums;
+    };
+
+namespace internal {
+    /**
+     * @brief Runs the micro kernel over all panels and writes zero point corrected int32 rows.
+     *
+     * Calls `out(row, values)` once per finished row of `N` values.
+     */
+    template <techn_t TTECH, typename TOUT>
+    void qgemm_driver(const uint8_t* a, size_t lda, size_t M, int32_t a_zero_point,
+                      const packed_qmatrix& b, TOUT&& out) {
+        using kernel_type = qgemm_kernel<TTECH>;
+
+        const size_t K = b.rows(), N = b.cols();
+        const int32_t bz = b.zero_point();
+        const int32_t kzz = int32_t(K) * a_zero_point * bz;
+        std::vector<int32_t> block(qgemm_mr * N);
+        int32_t acc[qgemm_mr * qgemm_nr];
+
+        for(size_t i = 0; i < M; i += qgemm_mr) {
+            const size_t mr = std::min(qgemm_mr, M - i);
+            const uint8_t* ablk = a + i * lda;
+
+            for(size_t p = 0; p < b.panels(); ++p) {
+                const size_t nc = std::min(qgemm_nr, N - p * qgemm_nr);
+                kernel_type::compute(ablk, lda, mr, K, b.panel(p), acc);
+                for(size_t r = 0; r < mr; ++r)
+                    std::copy(acc + r * qgemm_nr, acc + r * qgemm_nr + nc, block.data() + r * N + p * qgemm_nr);
+            }
+            for(size_t r = 0; r < mr; ++r) {
+                int32_t* crow = block.data() + r * N;
+                int32_t rowsum = 0;
+
+                if(bz != 0) {
+                    const uint8_t* arow = ablk + r * lda;
+                    for(size_t k = 0; k < K; ++k) rowsum += arow[k];
+                }
+                for(size_t j = 0; j < N; ++j)
+                    crow[j] += kzz - a_zero_point * b.col_sums()[j] - bz * rowsum;
+                out(i + r, crow);
+            }
+        }
+    }
+}
+
+    /**
+     * @brief Quantized matrix multiply `C = (A - za) * (B - zb)` with int32 output
+     *
+     * @param a The `M` x `K` unsigned left hand side
+     * @param a_zero_point The zero point `za` of `a`
+     * @param b The packed `K` x `N` signed right hand side with zero point `zb`
+     * @param c Receives the `M` x `N` int32 result
+     *
+     * @throw std::invalid_argument if the inner dimensions do not match
+     */
+    template <techn_t TTECH>
+    void qgemm(const adaptive_matrix<uint8_t, TTECH>& a, int32_t a_zero_point,
+               const packed_qmatrix& b, adaptive_matrix<int32_t, TTECH>& c) {
+        if(a.cols() != b.rows()) throw std::invalid_argument("qgemm: inner dimensions do not match");
+
+        c.resize(a.rows(), b.cols());
+        internal::qgemm_driver<TTECH>(a.data(), a.stride(), a.rows(), a_zero_point, b,
+            [&c](size_t r, const int32_t* values) { std::copy(values, values + c.cols(), c.row(r)); });
+    }
+
+    /**
+     * @brief Quantized matrix multiply with requantization to int8
+     *
+     * The int32 result of each row block is scaled by `a_scale * b_scale / out.scale`,
+     * shifted by `out.zero_point` and saturated to int8 while it is still in cache.
+     *
+     * @param a The `M` x `K` unsigned left hand side
+     * @param a_params Quantization parameters of `a`
+     * @param b The packed right hand side
+     * @param b_scale The scale of `b`, its zero point is stored in `b`
+     * @param out Quantization parameters of the output
+     * @param c Receives the `M` x `N` int8 result
+     */
+    template <techn_t TTECH>
+    void qgemm(const adaptive_matrix<uint8_t, TTECH>& a, quantization_params a_params,
+               const packed_qmatrix& b, float b_scale,
+               quantization_params out, adaptive_matrix<int8_t, TTECH>& c) {
+        if(a.cols() != b.rows()) throw std::invalid_argument("qgemm: inner dimensions do not match");
+
+        const float scale = a_params.scale * b_scale / out.scale;
+        c.resize(a.rows(), b.cols());
+        internal::qgemm_driver<TTECH>(a.data(), a.stride(), a.rows(), a_params.zero_point, b,
+            [&c, &out, scale](size_t r, const int32_t* values) {
+                internal::qgemm_requantize<TTECH>(values, c.cols(), scale, out.zero_point, c.row(r));
+            });
+    }
+}
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @file adaptive_random.h
+ * @brief Header file for a vectorized random number generator that fills adaptive arrays.
+ *
+ * This file defines `random_generator`, eight interleaved xoshiro256** generators that
+ * fill `adaptive_vector`s (or any integer storage) with uniformly random integers using
+ * the SIMD registers of the technique. Bounded ranges use Lemire's multiply-and-reject
+ * method, which has no bias and no divide per element. `jump` moves all generators
+ * 2^192 steps ahead, so copies handed to other threads never overlap:
+ *
+ * @code
+ * adaptive::random_generator rng(42);
+ * adaptive::adaptive_vector<uint32_t, adaptive::techn_t::AVX> v(1 << 24);
+ * rng.fill(v);                      // raw bits
+ * rng.fill(v, 1u, 6u);              // dice, 1 to 6 inclusive
+ *
+ * auto other = rng.split();         // an independent stream for another thread
+ * @endcode
+ *
+ * The stream depends only on the seed and the number of bytes drawn so far, not on the
+ * technique or on how fills are sliced; narrow element types take the bytes of the
+ * 64-bit words in order. A bounded fill of elements up to 32 bits consumes 32 bits per
+ * element, plus one side stream word per rejected element.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_RANDOM__
+#define __ADAPTIVE_RANDOM__ 1
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adaptive_vector.h>
+
+#include <internal/kernel_mod.h>
+#include <internal/kernel_random.h>
+
+#ifndef ADAPTIVE_RANDOM_CHUNK
+/**
+ * @brief Elements per chunk of a bounded fill, raw words and their mapping stay in L1
+ */
+#define ADAPTIVE_RANDOM_CHUNK 2048
+#endif
+
+namespace adaptive {
+    /**
+     * @brief A multi-lane xoshiro256** generator that fills integer arrays
+     *
+     * Also a standard uniform random bit generator of 64-bit words, for use with the
+     * `<random>` distributions.
+     */
+    class random_generator {
+    public:
+        using this_type = random_generator;
+        using result_type = uint64_t;
+        using const_refernce = const this_type&;
+
+        static constexpr size_t lanes = internal::xoshiro_lanes;
+
+        /**
+         * @brief Constructor, expands `seed` with splitmix64 and spaces the lanes 2^128 steps apart
+         */
+        explicit random_generator(uint64_t seed = 0x2545F4914F6CDD1Dull) noexcept
+            : m_uState(), m_uSide(), m_uPending(), m_szPending(0) {
+            uint64_t _x = seed, _s[4];
+            for(auto& w : _s) w = internal::splitmix64(_x);
+            for(size_t l = 0; l < lanes; ++l) {
+                for(int k = 0; k < 4; ++k) m_uState[k][l] = _s[k];
+                internal::xoshiro_jump(_s, internal::xoshiro_jump_poly);
+            }
+            for(int k = 0; k < 4; ++k) m_uSide[k] = _s[k];
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        /**
+         * @brief The next 64-bit word of the stream
+         */
+        result_type operator () () noexcept {
+            result_type _result;
+            unsigned char* dst = reinterpret_cast<unsigned char*>(&_result);
+            size_t bytes = sizeof(_result);
+            take_pending(dst, bytes);
+            if(bytes != 0) {
+                refill<techn_type::Scalar>();
+                take_pending(dst, bytes);
+            }
+            return _result;
+        }
+
+        /**
+         * @brief Moves every lane 2^192 steps ahead, the words up to there are never drawn
+         */
+        void jump() noexcept {
+            uint64_t _s[4];
+            for(size_t l = 0; l < lanes; ++l) {
+                for(int k = 0; k < 4; ++k) _s[k] = m_uState[k][l];
+                internal::xoshiro_jump(_s, internal::xoshiro_long_jump_poly);
+                for(int k = 0; k < 4; ++k) m_uState[k][l] = _s[k];
+            }
+            internal::xoshiro_jump(m_uSide, internal::xoshiro_long_jump_poly);
+            m_szPending = 0;
+        }
+        /**
+         * @brief Returns a copy of this generator and jumps this one, for handing a stream to a thread
+         */
+        this_type split() noexcept {
+            this_type _result(*this);
+            jump();
+            return _result;
+        }
+
+        /**
+         * @brief Fills `n` elements at `p` with uniformly random bits
+         *
+         * @tparam TTECH The technique of the kernel
+         */
+        template <techn_t TTECH, typename TINT>
+        void fill(TINT* p, size_t n) {
+            static_assert(std::is_integral<TINT>::value, "random_generator::fill: integer type required");
+            unsigned char* dst = reinterpret_cast<unsigned char*>(p);
+            size_t bytes = n * sizeof(TINT);
+            take_pending(dst, bytes);
+
+            const size_t steps = bytes / step_bytes;
+            internal::random_kernel<TTECH>::generate(m_uState, dst, steps);
+            dst += steps * step_bytes;
+            bytes -= steps * step_bytes;
+            if(bytes != 0) {
+                refill<TTECH>();
+                take_pending(dst, bytes);
+            }
+        }
+        /**
+         * @brief Fills `v` with uniformly random bits
+         */
+        template <typename TINT, techn_t TTECH>
+        void fill(adaptive_vector<TINT, TTECH>& v) {
+            fill<TTECH>(v.data(), v.size());
+        }
+        /**
+         * @brief Fills `n` elements at `p` uniformly from `[lo, hi]`, both inclusive
+         *
+         * @throw std::invalid_argument if `lo > hi`
+         */
+        template <techn_t TTECH, typename TINT>
+        void fill(TINT* p, size_t n, typename std::common_type<TINT>::type lo, typename std::common_type<TINT>::type hi) {
+            static_assert(std::is_integral<TINT>::value, "random_generator::fill: integer type required");
+            using unsigned_type = typename std::make_unsigned<TINT>::type;
+            if(lo > hi) throw std::invalid_argument("random_generator::fill: lo must not be above hi");
+
+            // The range size wraps to 0 only for the full 64-bit range.
+            const uint64_t range = uint64_t(unsigned_type(unsigned_type(hi) - unsigned_type(lo))) + 1;
+            if(range == 0 || (sizeof(TINT) == 4 && range == (uint64_t(1) << 32))) {
+                fill<TTECH>(p, n);
+                return;
+            }
+            auto redraw = [this]() { return internal::xoshiro_next(m_uSide); };
+            if constexpr (sizeof(TINT) <= 4) {
+                const uint32_t s = uint32_t(range), t = uint32_t(0u - s) % s;
+                uint32_t _chunk[ADAPTIVE_RANDOM_CHUNK];
+                for(size_t i = 0; i < n; i += ADAPTIVE_RANDOM_CHUNK) {
+                    const size_t m = std::min<size_t>(ADAPTIVE_RANDOM_CHUNK, n - i);
+                    fill<TTECH>(_chunk, m);
+                    internal::random_kernel<TTECH>::lemire32(_chunk, m, s, t, redraw);
+                    for(size_t j = 0; j < m; ++j) p[i + j] = TINT(unsigned_type(_chunk[j] + unsigned_type(lo)));
+                }
+            } else {
+                const uint64_t t = (0 - range) % range;
+                for(size_t i = 0; i < n; i += ADAPTIVE_RANDOM_CHUNK) {
+                    const size_t m = std::min<size_t>(ADAPTIVE_RANDOM_CHUNK, n - i);
+                    unsigned_type* q = reinterpret_cast<unsigned_type*>(p + i);
+                    fill<TTECH>(q, m);
+                    for(size_t j = 0; j < m; ++j) {
+                        uint64_t _hi, _lo = internal::mul_wide_u64(q[j], range, _hi);
+                        while(_lo < t) _lo = internal::mul_wide_u64(redraw(), range, _hi);
+                        q[j] = unsigned_type(_hi + uint64_t(lo));
+                    }
+                }
+            }
+        }
+        /**
+         * @brief Fills `v` uniformly from `[lo, hi]`, both inclusive
+         *
+         * @throw std::invalid_argument if `lo > hi`
+         */
+        template <typename TINT, techn_t TTECH>
+        void fill(adaptive_vector<TINT, TTECH>& v, typename std::common_type<TINT>::type lo,
+                  typename std::common_type<TINT>::type hi) {
+            fill<TTECH>(v.data(), v.size(), lo, hi);
+        }
+
+    protected:
+        static constexpr size_t step_bytes = lanes * sizeof(uint64_t);
+
+        /**
+         * @brief Draws the next step of every lane into the pending words
+         */
+        template <techn_t TTECH>
+        void refill() noexcept {
+            internal::random_kernel<TTECH>::generate(m_uState, m_uPending, 1);
+            m_szPending = step_bytes;
+        }
+        /**
+         * @brief Copies pending bytes to `dst` until `bytes` or the pending bytes run out
+         */
+        void take_pending(unsigned char*& dst, size_t& bytes) noexcept {
+            const size_t k = std::min(bytes, m_szPending);
+            std::memcpy(dst, reinterpret_cast<const unsigned char*>(m_uPending) + step_bytes - m_szPending, k);
+            m_szPending -= k;
+            dst += k;
+            bytes -= k;
+        }
+
+    protected:
+        /**
+         * @brief Word `k` of the xoshiro256** state of every lane, row by row
+         */
+        alignas(64) uint64_t m_uState[4][lanes];
+        /**
+         * @brief The generator of the rejected elements of bounded fills
+         */
+        uint64_t m_uSide[4];
+        /**
+         * @brief The last step, of which the final `m_szPending` bytes were not handed out yet
+         */
+        uint64_t m_uPending[lanes];
+        size_t m_szPending;
+    };
+}
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ * @file adaptive_ring.h
+ * @brief Header file for bounded lock-free ring buffers between threads.
+ *
+ * This file defines `spsc_ring`, a ring for one producer and one consumer thread, and
+ * `mpmc_ring`, a ring for any number of both. Neither allocates after construction or
+ * takes a lock; a hand-off costs a few atomic operations on cache lines that only the
+ * two sides share:
+ *
+ * - `spsc_ring` keeps the producer and the consumer index on cache lines of their own
+ *   and each side caches the index of the other, so it only reads the other cache line
+ *   when the ring looks full or empty.
+ * - `mpmc_ring` is the bounded queue of Dmitry Vyukov: every cell carries a sequence
+ *   number that tells producers and consumers whose turn it is, so they only contend on
+ *   the index they advance with a compare exchange.
+ *
+ * `try_push` and `try_pop` never wait; the callers decide how to wait, see `spin_backoff`.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_RING__
+#define __ADAPTIVE_RING__ 1
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <internal/aligned_allocator.h>
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Get the smallest power of two not below `n`
+     */
+    inline size_t ring_capacity(size_t n) {
+        if(n == 0) throw std::invalid_argument("ring: capacity must not be 0");
+        size_t _result = 1;
+        while(_result < n) _result *= 2;
+        return _result;
+    }
+}
+
+    /**
+     * @class spin_backoff
+     * @brief Waits for another thread, spinning with `pause` first and yielding the CPU later
+     */
+    class spin_backoff {
+    public:
+        spin_backoff() noexcept
+            : m_uCount(0) { }
+
+        void pause() noexcept {
+            if(m_uCount < spin_limit) {
+                for(unsigned i = 0; i < (1u << (m_uCount / 8)); ++i) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+                    __builtin_ia32_pause();
+#endif
+                }
+                ++m_uCount;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        void reset() noexcept { m_uCount = 0; }
+
+    protected:
+        static constexpr unsigned spin_limit = 48;
+        unsigned m_uCount;
+    };
+
+    /**
+     * @class spsc_ring
+     * @brief A bounded lock-free ring for one producer and one consumer thread
+     *
+     * Example usage:
+     * @code
+     * adaptive::spsc_ring<block*> ring(64);
+     * while(!ring.try_push(b)) backoff.pause();     // producer thread
+     * block* b; if(ring.try_pop(b)) consume(b);      // consumer thread
+     * @endcode
+     *
+     * @tparam T The element type, default constructible and movable
+     */
+    template <typename T>
+    class spsc_ring {
+    public:
+        using this_type = spsc_ring<T>;
+        using value_type = T;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructor for a ring of at least `capacity` elements, rounded up to a power of two
+         *
+         * @throw std::invalid_argument if `capacity` is 0
+         */
+        explicit spsc_ring(size_type capacity)
+            : m_szMask(internal::ring_capacity(capacity) - 1), m_pBuffer(new value_type[m_szMask + 1]),
+              m_atHead(0), m_szTailCache(0), m_atTail(0), m_szHeadCache(0) { }
+        spsc_ring(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        size_type capacity() const noexcept { return m_szMask + 1; }
+
+        /**
+         * @brief Moves `v` into the ring, only from the producer thread
+         *
+         * @return False if the ring is full, `v` is left untouched then
+         */
+        bool try_push(value_type& v) {
+            const size_t t = m_atTail.load(std::memory_order_relaxed);
+            if(t - m_szHeadCache > m_szMask) {
+                m_szHeadCache = m_atHead.load(std::memory_order_acquire);
+                if(t - m_szHeadCache > m_szMask) return false;
+            }
+            m_pBuffer[t & m_szMask] = std::move(v);
+            m_atTail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+        bool try_push(value_type&& v) { return try_push(v); }
+        /**
+         * @brief Moves the oldest element to `v`, only from the consumer thread
+         *
+         * @return False if the ring is empty
+         */
+        bool try_pop(value_type& v) {
+            const size_t h = m_atHead.load(std::memory_order_relaxed);
+            if(h == m_szTailCache) {
+                m_szTailCache = m_atTail.load(std::memory_order_acquire);
+                if(h == m_szTailCache) return false;
+            }
+            v = std::move(m_pBuffer[h & m_szMask]);
+            m_atHead.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Get the number of elements, exact only while neither side runs
+         */
+        size_type size() const noexcept {
+            return m_atTail.load(std::memory_order_acquire) - m_atHead.load(std::memory_order_acquire);
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+    protected:
+        const size_t m_szMask;
+        std::unique_ptr<value_type[]> m_pBuffer;
+
+        // The consumer line: its index and its copy of the producer index.
+        alignas(ADAPTIVE_DEFAULT_ALIGNMENT) std::atomic<size_t> m_atHead;
+        size_t m_szTailCache;
+        // The producer line.
+        alignas(ADAPTIVE_DEFAULT_ALIGNMENT) std::atomic<size_t> m_atTail;
+        size_t m_szHeadCache;
+    };
+
+    /**
+     * @class mpmc_ring
+     * @brief A bounded lock-free ring for any number of producer and consumer threads
+     *
+     * The cells are a cache line each, so threads working on neighbouring cells do not
+     * share one. Elements popped by different consumers may be consumed in any order.
+     *
+     * @tparam T The element type, default constructible and movable
+     */
+    template <typename T>
+    class mpmc_ring {
+    public:
+        using this_type = mpmc_ring<T>;
+        using value_type = T;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructor for a ring of at least `capacity` elements, rounded up to a power of two
+         *
+         * The capacity is at least 2: with a single cell the sequence of a full cell equals
+         * the one a producer waits for, so a second push would overwrite the first.
+         *
+         * @throw std::invalid_argument if `capacity` is 0
+         */
+        explicit mpmc_ring(size_type capacity)
+            : m_szMask(internal::ring_capacity(capacity == 1 ? 2 : capacity) - 1), m_pCells(new cell[m_szMask + 1]),
+              m_atHead(0), m_atTail(0) {
+            for(size_t i = 0; i <= m_szMask; ++i) m_pCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mpmc_ring(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        size_type capacity() const noexcept { return m_szMask + 1; }
+
+        /**
+         * @brief Moves `v` into the ring
+         *
+         * @return False if the ring is full, `v` is left untouched then
+         */
+        bool try_push(value_type& v) {
+            size_t t = m_atTail.load(std::memory_order_relaxed);
+            cell* c;
+            while(true) {
+                c = &m_pCells[t & m_szMask];
+                const ptrdiff_t d = ptrdiff_t(c->sequence.load(std::memory_order_acquire) - t);
+                if(d == 0) {
+                    if(m_atTail.compare_exchange_weak(t, t + 1, std::memory_order_relaxed)) break;
+                } else if(d < 0) {
+                    return false;
+                } else {
+                    t = m_atTail.load(std::memory_order_relaxed);
+                }
+            }
+            c->value = std::move(v);
+            c->sequence.store(t + 1, std::memory_order_release);
+            return true;
+        }
+        bool try_push(value_type&& v) { return try_push(v); }
+        /**
+         * @brief Moves the element of the next cell to `v`
+         *
+         * @return False if the ring is empty
+         */
+        bool try_pop(value_type& v) {
+            size_t h = m_atHead.load(std::memory_order_relaxed);
+            cell* c;
+            while(true) {
+                c = &m_pCells[h & m_szMask];
+                const ptrdiff_t d = ptrdiff_t(c->sequence.load(std::memory_order_acquire) - (h + 1));
+                if(d == 0) {
+                    if(m_atHead.compare_exchange_weak(h, h + 1, std::memory_order_relaxed)) break;
+                } else if(d < 0) {
+                    return false;
+                } else {
+                    h = m_atHead.load(std::memory_order_relaxed);
+                }
+            }
+            v = std::move(c->value);
+            c->sequence.store(h + m_szMask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Get the number of elements, exact only while no thread pushes or pops
+         */
+        size_type size() const noexcept {
+            return m_atTail.load(std::memory_order_acquire) - m_atHead.load(std::memory_order_acquire);
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+    protected:
+        struct alignas(ADAPTIVE_DEFAULT_ALIGNMENT) cell {
+            std::atomic<size_t> sequence;
+            value_type value;
+        };
+
+        const size_t m_szMask;
+        std::unique_ptr<cell[]> m_pCells;
+        alignas(ADAPTIVE_DEFAULT_ALIGNMENT) std::atomic<size_t> m_atHead;
+        alignas(ADAPTIVE_DEFAULT_ALIGNMENT) std::atomic<size_t> m_atTail;
+    };
+}
+
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file adaptive_small_matrix.h
+ * @brief Header file for batches of small integer matrices in structure-of-arrays layout.
+ *
+ * This file defines `adaptive_small_matrix_batch`, many independent 3x3 or 4x4
+ * matrices, and `adaptive_small_vector_batch`, as many vectors of 3 or 4 elements.
+ * Storing every element position as its own plane lets each SIMD lane work on a
+ * different matrix, so a batch of transforms runs at full vector width where an array
+ * of per-matrix structs would need shuffles for every product and cannot fill a
+ * register with a 3x3 matrix.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_SMALL_MATRIX__
+#define __ADAPTIVE_SMALL_MATRIX__ 1
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include <adaptive_integer.h>
+#include <adaptive_vector.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/kernel_small_matrix.h>
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Plane stride for `count` elements: rounded up to whole cache lines
+     */
+    template <typename TINT>
+    constexpr size_t small_batch_stride(size_t count) {
+        constexpr size_t line = ADAPTIVE_DEFAULT_ALIGNMENT / sizeof(TINT);
+        return (count + line - 1) / line * line;
+    }
+}
+
+    /**
+     * @brief A batch of `count` vectors of `TN` integers, one plane per element
+     *
+     * @tparam TINT The base integer type of the elements
+     * @tparam TN The vector size, 3 or 4
+     * @tparam TTECH The technique type for the kernels working on this batch
+     */
+    template <typename TINT, size_t TN, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_small_vector_batch {
+        static_assert(TN == 3 || TN == 4, "adaptive_small_vector_batch: size 3 or 4");
+    public:
+        using this_type = adaptive_small_vector_batch<TINT, TN, TTECH>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using element_type = std::array<TINT, TN>;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+
+        static constexpr size_t dim = TN;
+
+        adaptive_small_vector_batch() noexcept
+            : m_szCount(0), m_szStride(0) { }
+        /**
+         * @brief Constructor for `count` zero vectors
+         */
+        explicit adaptive_small_vector_batch(size_type count)
+            : m_szCount(count), m_szStride(internal::small_batch_stride<TINT>(count)), m_vData(TN * m_szStride) { }
+
+        /**
+         * @brief Get the number of vectors
+         */
+        size_type size() const noexcept      { return m_szCount; }
+        /**
+         * @brief Get the distance in elements between two planes
+         */
+        size_type stride() const noexcept    { return m_szStride; }
+        techn_t get_techniq() const noexcept { return TTECH; }
+
+        value_type* data() noexcept             { return m_vData.data(); }
+        const value_type* data() const noexcept { return m_vData.data(); }
+        /**
+         * @brief Get the plane of element `i`, `size()` contiguous values
+         */
+        value_type* plane(size_type i) noexcept             { return m_vData.data() + i * m_szStride; }
+        const value_type* plane(size_type i) const noexcept { return m_vData.data() + i * m_szStride; }
+
+        value_type& operator () (size_type m, size_type i) noexcept             { return plane(i)[m]; }
+        const value_type& operator () (size_type m, size_type i) const noexcept { return plane(i)[m]; }
+
+        /**
+         * @brief Gathers vector `m`
+         */
+        element_type get(size_type m) const {
+            element_type _result;
+            for(size_type i = 0; i < TN; ++i) _result[i] = (*this)(m, i);
+            return _result;
+        }
+        /**
+         * @brief Scatters `v` into vector `m`
+         */
+        void set(size_type m, const element_type& v) {
+            for(size_type i = 0; i < TN; ++i) (*this)(m, i) = v[i];
+        }
+        /**
+         * @brief Changes the number of vectors, the content is unspecified afterwards
+         */
+        void resize(size_type count) {
+            m_szCount = count;
+            m_szStride = internal::small_batch_stride<TINT>(count);
+            m_vData.resize(TN * m_szStride);
+        }
+
+        bool operator == (const this_type& o) const noexcept {
+            if(m_szCount != o.m_szCount) return false;
+            for(size_type i = 0; i < TN; ++i)
+                if(!std::equal(plane(i), plane(i) + m_szCount, o.plane(i))) return false;
+            return true;
+        }
+        bool operator != (const this_type& o) const noexcept { return !(*this == o); }
+
+    protected:
+        size_type m_szCount;
+        size_type m_szStride;
+        storage_type m_vData;
+    };
+
+    /**
+     * @brief A batch of `count` independent `TN` x `TN` integer matrices, structure-of-arrays
+     *
+     * Element `(i, j)` of all matrices forms one contiguous, cache line aligned plane.
+     * The arithmetic wraps on overflow like the technique backends do.
+     *
+     * @tparam TINT The base integer type of the elements
+     * @tparam TN The matrix size, 3 or 4
+     * @tparam TTECH The technique type for the batch kernels
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_small_matrix_batch<int32_t, 4, adaptive::techn_t::AVX> a(1 << 20), b(1 << 20);
+     * auto c = a * b;                 // 2^20 independent 4x4 products, 8 per instruction
+     * adaptive::int32_vector_t<adaptive::techn_t::AVX> d;
+     * c.determinant(d);
+     * @endcode
+     */
+    template <typename TINT, size_t TN, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_small_matrix_batch {
+        static_assert(TN == 3 || TN == 4, "adaptive_small_matrix_batch: size 3 or 4");
+    public:
+        using this_type = adaptive_small_matrix_batch<TINT, TN, TTECH>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using pointer = this_type*;
+        using reference = this_type&;
+        using const_pointer = const this_type*;
+        using const_refernce = const this_type&;
+        using element_type = std::array<TINT, TN * TN>;
+        using vector_batch_type = adaptive_small_vector_batch<TINT, TN, TTECH>;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+        using kernel_type = internal::small_matrix_kernel<TINT, TN, TTECH>;
+
+        static constexpr size_t dim = TN;
+
+        adaptive_small_matrix_batch() noexcept
+            : m_szCount(0), m_szStride(0) { }
+        /**
+         * @brief Constructor for `count` zero matrices
+         */
+        explicit adaptive_small_matrix_batch(size_type count)
+            : m_szCount(count), m_szStride(internal::small_batch_stride<TINT>(count)), m_vData(TN * TN * m_szStride) { }
+
+        /**
+         * @brief Get the number of matrices
+         */
+        size_type size() const noexcept      { return m_szCount; }
+        /**
+         * @brief Get the distance in elements between two planes
+         */
+        size_type stride() const noexcept    { return m_szStride; }
+        techn_t get_techniq() const noexcept { return TTECH; }
+
+        value_type* data() noexcept             { return m_vData.data(); }
+        const value_type* data() const noexcept { return m_vData.data(); }
+        /**
+         * @brief Get the plane of element `(i, j)`, `size()` contiguous values
+         */
+        value_type* plane(size_type i, size_type j) noexcept             { return m_vData.data() + (i * TN + j) * m_szStride; }
+        const value_type* plane(size_type i, size_type j) const noexcept { return m_vData.data() + (i * TN + j) * m_szStride; }
+
+        /**
+         * @brief Element `(i, j)` of matrix `m`
+         */
+        value_type& operator () (size_type m, size_type i, size_type j) noexcept             { return plane(i, j)[m]; }
+        const value_type& operator () (size_type m, size_type i, size_type j) const noexcept { return plane(i, j)[m]; }
+
+        /**
+         * @brief Gathers matrix `m` as row-major array
+         */
+        element_type get(size_type m) const {
+            element_type _result;
+            for(size_type p = 0; p < TN * TN; ++p) _result[p] = m_vData[p * m_szStride + m];
+            return _result;
+        }
+        /**
+         * @brief Scatters the row-major array `v` into matrix `m`
+         */
+        void set(size_type m, const element_type& v) {
+            for(size_type p = 0; p < TN * TN; ++p) m_vData[p * m_szStride + m] = v[p];
+        }
+
+        /**
+         * @brief `c[m] = a[m] * b[m]` for every matrix, `c` is resized and may alias neither operand
+         *
+         * @throw std::invalid_argument if the batch sizes differ or `c` aliases an operand
+         */
+        static void multiply(const this_type& a, const this_type& b, this_type& c) {
+            if(a.size() != b.size()) throw std::invalid_argument("adaptive_small_matrix_batch::multiply: size mismatch");
+            if(&c == &a || &c == &b) throw std::invalid_argument("adaptive_small_matrix_batch::multiply: c aliases an operand");
+            c.resize(a.size());
+            kernel_type::multiply(a.data(), b.data(), c.data(), a.stride(), a.size());
+        }
+        /**
+         * @brief `y[m] = a[m] * x[m]` for every matrix
+         *
+         * @throw std::invalid_argument if the batch sizes differ or `y` aliases `x`
+         */
+        void multiply(const vector_batch_type& x, vector_batch_type& y) const {
+            if(x.size() != m_szCount) throw std::invalid_argument("adaptive_small_matrix_batch::multiply: size mismatch");
+            if(&x == &y) throw std::invalid_argument("adaptive_small_matrix_batch::multiply: y aliases x");
+            y.resize(m_szCount);
+            kernel_type::matvec(data(), x.data(), y.data(), m_szStride, x.stride(), m_szCount);
+        }
+        /**
+         * @brief Writes the determinant of every matrix into `det`
+         */
+        template <techn_t TVTECH>
+        void determinant(adaptive_vector<TINT, TVTECH>& det) const {
+            det.resize(m_szCount);
+            kernel_type::determinant(data(), det.data(), m_szStride, m_szCount);
+        }
+        /**
+         * @brief Writes the transpose of every matrix into `dst`
+         *
+         * In this layout a transpose only exchanges whole planes, nothing is shuffled.
+         *
+         * @param dst The destination batch, must not be this batch
+         */
+        void transpose(this_type& dst) const {
+            if(&dst == this) throw std::invalid_argument("adaptive_small_matrix_batch::transpose: dst aliases source");
+            dst.resize(m_szCount);
+            for(size_type i = 0; i < TN; ++i)
+                for(size_type j = 0; j < TN; ++j)
+                    std::copy(plane(i, j), plane(i, j) + m_szCount, dst.plane(j, i));
+        }
+        this_type transpose() const {
+            this_type _result;
+            transpose(_result);
+            return _result;
+        }
+        /**
+         * @brief Transposes every matrix in place by swapping the planes `(i, j)` and `(j, i)`
+         */
+        void transpose_inplace() {
+            for(size_type i = 0; i < TN; ++i)
+                for(size_type j = i + 1; j < TN; ++j)
+                    std::swap_ranges(plane(i, j), plane(i, j) + m_szCount, plane(j, i));
+        }
+
+        /**
+         * @brief Changes the number of matrices, the content is unspecified afterwards
+         */
+        void resize(size_type count) {
+            m_szCount = count;
+            m_szStride = internal::small_batch_stride<TINT>(count);
+            m_vData.resize(TN * TN * m_szStride);
+        }
+
+        this_type operator * (const this_type& o) const {
+            this_type _result;
+            multiply(*this, o, _result);
+            return _result;
+        }
+        vector_batch_type operator * (const vector_batch_type& x) const {
+            vector_batch_type _result;
+            multiply(x, _result);
+            return _result;
+        }
+
+        bool operator == (const this_type& o) const noexcept {
+            if(m_szCount != o.m_szCount) return false;
+            for(size_type p = 0; p < TN * TN; ++p)
+                if(!std::equal(data() + p * m_szStride, data() + p * m_szStride + m_szCount, o.data() + p * o.m_szStride)) return false;
+            return true;
+        }
+        bool operator != (const this_type& o) const noexcept { return !(*this == o); }
+
+    protected:
+        /**
+         * @brief The number of matrices
+         */
+        size_type m_szCount;
+        /**
+         * @brief The distance between two planes, `m_szCount` rounded up to cache lines
+         */
+        size_type m_szStride;
+        /**
+         * @brief The `TN * TN` planes
+         */
+        storage_type m_vData;
+    };
+
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    using mat3_batch_t = adaptive_small_matrix_batch<TINT, 3, TTECH>;
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    using mat4_batch_t = adaptive_small_matrix_batch<TINT, 4, TTECH>;
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    using vec3_batch_t = adaptive_small_vector_batch<TINT, 3, TTECH>;
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    using vec4_batch_t = adaptive_small_vector_batch<TINT, 4, TTECH>;
+}
+
+#endif
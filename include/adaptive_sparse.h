@@ -0,0 +1,221 @@
+/**
+ * @file adaptive_sparse.h
+ * @brief Header file for sparse adaptive integer matrices.
+ *
+ * This file defines the `adaptive_csr_matrix` class template, a compressed sparse row
+ * matrix over the adaptive element types. It is built from COO triples (or a dense
+ * `adaptive_matrix`) and multiplies with `adaptive_vector`s single- or multi-threaded.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_SPARSE__
+#define __ADAPTIVE_SPARSE__ 1
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+#include <adaptive_matrix.h>
+#include <adaptive_vector.h>
+
+#include <internal/kernel_spmv.h>
+#include <internal/parallel_for.h>
+
+namespace adaptive {
+    /**
+     * @brief A template class that implements a CSR sparse integer matrix with customizable technique
+     *
+     * @tparam TINT The base integer type of the elements
+     * @tparam TTECH The technique type for the kernels
+     *
+     * Column indices are stored as 32-bit values so the AVX kernel can feed them to the
+     * gather instructions directly; the number of columns is therefore limited to 2^31-1.
+     *
+     * Example usage:
+     * @code
+     * using csr_t = adaptive::adaptive_csr_matrix<int32_t, adaptive::techn_t::AVX>;
+     * auto a = csr_t::from_coo(3, 3, { {0, 0, 1}, {1, 2, 5}, {2, 1, 7} });
+     * adaptive::adaptive_vector<int32_t, adaptive::techn_t::AVX> x(3, 1), y;
+     * a.multiply(x, y);
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_csr_matrix {
+    public:
+        using this_type = adaptive_csr_matrix<TINT, TTECH>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using index_type = uint32_t;
+        using pointer = this_type*;
+        using reference = this_type&;
+        using const_pointer = const this_type*;
+        using const_refernce = const this_type&;
+        using const_type = const this_type;
+        using vector_type = adaptive_vector<TINT, TTECH>;
+        using dense_type = adaptive_matrix<TINT, TTECH>;
+        using kernel_type = internal::spmv_kernel<TINT, TTECH>;
+
+        /**
+         * @brief One COO entry
+         */
+        struct coo_entry {
+            size_type row;
+            size_type col;
+            value_type value;
+        };
+
+        /**
+         * @brief Default constructor, creates an empty 0x0 matrix
+         */
+        adaptive_csr_matrix() noexcept
+            : m_szRows(0), m_szCols(0), m_vRowPtr(1, 0) { }
+
+        /**
+         * @brief Builds a CSR matrix from COO triples
+         *
+         * The entries may come in any order; duplicates are summed and explicit zeros
+         * are dropped.
+         *
+         * @param rows The number of rows
+         * @param cols The number of columns
+         * @param entries The triples, taken by value because they are sorted
+         *
+         * @throw std::out_of_range if an entry is outside of the matrix
+         * @throw std::length_error if `cols` does not fit the 32-bit column index
+         */
+        static this_type from_coo(size_type rows, size_type cols, std::vector<coo_entry> entries) {
+            if(cols > size_type(std::numeric_limits<int32_t>::max()))
+                throw std::length_error("adaptive_csr_matrix: too many columns");
+
+            std::sort(entries.begin(), entries.end(), [](const coo_entry& a, const coo_entry& b) {
+                return a.row < b.row || (a.row == b.row && a.col < b.col);
+            });
+
+            this_type _result;
+            _result.m_szRows = rows;
+            _result.m_szCols = cols;
+            _result.m_vRowPtr.assign(rows + 1, 0);
+
+            for(size_t i = 0; i < entries.size(); ) {
+                const coo_entry& e = entries[i];
+                if(e.row >= rows || e.col >= cols) throw std::out_of_range("adaptive_csr_matrix: entry out of range");
+
+                value_type _sum = 0;
+                for(; i < entries.size() && entries[i].row == e.row && entries[i].col == e.col; ++i)
+                    _sum = static_cast<value_type>(_sum + entries[i].value);
+                if(_sum == 0) continue;
+
+                _result.m_vColIdx.push_back(static_cast<index_type>(e.col));
+                _result.m_vValues.push_back(_sum);
+                ++_result.m_vRowPtr[e.row + 1];
+            }
+            for(size_t r = 0; r < rows; ++r) _result.m_vRowPtr[r + 1] += _result.m_vRowPtr[r];
+            return _result;
+        }
+        /**
+         * @brief Builds a CSR matrix from the non zero elements of a dense matrix
+         */
+        static this_type from_dense(const dense_type& dense) {
+            std::vector<coo_entry> entries;
+            for(size_t r = 0; r < dense.rows(); ++r)
+                for(size_t c = 0; c < dense.cols(); ++c)
+                    if(dense(r, c) != 0) entries.push_back({ r, c, dense(r, c) });
+            return from_coo(dense.rows(), dense.cols(), std::move(entries));
+        }
+
+        size_type rows() const noexcept      { return m_szRows; }
+        size_type cols() const noexcept      { return m_szCols; }
+        /**
+         * @brief Get the number of stored non zero elements
+         */
+        size_type nonzeros() const noexcept  { return m_vValues.size(); }
+        techn_t get_techniq() const noexcept { return TTECH; }
+
+        const size_type* row_ptr() const noexcept  { return m_vRowPtr.data(); }
+        const index_type* col_idx() const noexcept { return m_vColIdx.data(); }
+        const value_type* values() const noexcept  { return m_vValues.data(); }
+
+        /**
+         * @brief Sparse matrix-vector multiply `y = A * x`
+         *
+         * @param x The dense input, `cols()` elements
+         * @param y Receives the `rows()` results
+         *
+         * @throw std::invalid_argument if `x` has the wrong size
+         */
+        void multiply(const vector_type& x, vector_type& y) const {
+            check_multiply(x, y);
+            kernel_type::rows(row_ptr(), col_idx(), values(), x.data(), y.data(), 0, m_szRows);
+        }
+        /**
+         * @brief Multi-threaded sparse matrix-vector multiply `y = A * x`
+         *
+         * The rows are split into contiguous bands with about the same number of non
+         * zeros, one band per thread, so skewed row lengths do not leave threads idle.
+         *
+         * @param x The dense input, `cols()` elements
+         * @param y Receives the `rows()` results
+         * @param threads The number of threads, 0 selects all hardware threads
+         */
+        void multiply(const vector_type& x, vector_type& y, size_type threads) const {
+            check_multiply(x, y);
+
+            const size_t chunks = std::max<size_t>(1, std::min(internal::resolve_threads(threads), m_szRows));
+            std::vector<size_t> bounds(chunks + 1, m_szRows);
+            bounds[0] = 0;
+            for(size_t i = 1; i < chunks; ++i) {
+                const size_t target = nonzeros() * i / chunks;
+                size_t r = size_t(std::lower_bound(m_vRowPtr.begin(), m_vRowPtr.end(), target) - m_vRowPtr.begin());
+                bounds[i] = std::min(std::max(r, bounds[i - 1]), m_szRows);
+            }
+            internal::parallel_for_bounds(bounds, [&](size_t, size_t rbegin, size_t rend) {
+                kernel_type::rows(row_ptr(), col_idx(), values(), x.data(), y.data(), rbegin, rend);
+            });
+        }
+        /**
+         * @brief Returns `A * x`
+         */
+        vector_type operator * (const vector_type& x) const {
+            vector_type _result;
+            multiply(x, _result);
+            return _result;
+        }
+
+        /**
+         * @brief Expands the matrix into a dense matrix
+         */
+        dense_type to_dense() const {
+            dense_type _result(m_szRows, m_szCols);
+            for(size_t r = 0; r < m_szRows; ++r)
+                for(size_t k = m_vRowPtr[r]; k < m_vRowPtr[r + 1]; ++k)
+                    _result(r, m_vColIdx[k]) = m_vValues[k];
+            return _result;
+        }
+
+    protected:
+        void check_multiply(const vector_type& x, vector_type& y) const {
+            if(x.size() != m_szCols) throw std::invalid_argument("adaptive_csr_matrix::multiply: size mismatch");
+            if(&x == &y) throw std::invalid_argument("adaptive_csr_matrix::multiply: y aliases x");
+            y.resize(m_szRows);
+        }
+
+    protected:
+        size_type m_szRows;
+        size_type m_szCols;
+        /**
+         * @brief Start of every row in `m_vColIdx`/`m_vValues`, `rows + 1` entries
+         */
+        std::vector<size_type> m_vRowPtr;
+        std::vector<index_type, aligned_allocator<index_type> > m_vColIdx;
+        std::vector<value_type, aligned_allocator<value_type> > m_vValues;
+    };
+}
+
+#endif
@@ -0,0 +1,353 @@
+/**
+ * @file adaptive_stencil.h
+ * @brief Header file for 2D convolution and stencil operations on adaptive matrices.
+ *
+ * This file defines `conv_filter`, a 3x3 or 5x5 integer stencil with an output shift,
+ * and `convolve`, which applies it to a uint8 or int16 image stored in an
+ * `adaptive_matrix`. Rows are streamed through a ring of `K` padded rows, so the
+ * working set of one output row stays in L1 no matter how tall the image is, and
+ * the border is handled once per row while padding instead of in the inner loops.
+ *
+ * Separable filters (gaussian, sobel, ...) run as a horizontal pass per source row
+ * into a ring of partial sums and a vertical pass per output row, `2K` instead of
+ * `K*K` multiplies per pixel. uint8 images use `pmaddubsw` (u8 x s8 -> s16) whenever
+ * the filter guarantees that the int16 sums cannot overflow, everything else widens
+ * to int32 with `pmaddwd`.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_STENCIL__
+#define __ADAPTIVE_STENCIL__ 1
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include <adaptive_matrix.h>
+#include <adaptive_thread_pool.h>
+
+#include <internal/aligned_allocator.h>
+#include <internal/kernel_stencil.h>
+#include <internal/parallel_for.h>
+
+/**
+ * @brief Minimal number of output rows of one band of the multi-threaded `convolve`.
+ */
+#ifndef ADAPTIVE_STENCIL_MIN_BAND
+#define ADAPTIVE_STENCIL_MIN_BAND 32
+#endif
+
+namespace adaptive {
+    /**
+     * @brief How pixels outside of the image are read
+     */
+    enum class border_mode {
+        Constant = 0,   ///< a fixed value
+        Replicate = 1,  ///< the nearest edge pixel, `aaa|abcd|ddd`
+        Reflect = 2,    ///< mirrored at the edge pixel, `dcb|abcd|cba`
+        Wrap = 3,       ///< the opposite edge, `bcd|abcd|abc`
+    };
+
+    /**
+     * @brief A `TSIZE` x `TSIZE` integer stencil, `out = (sum w * in + round) >> shift`
+     *
+     * The weights are applied as written (correlation, the way image filters are usually
+     * given), element `(i, j)` weighs the pixel `(y + i - TSIZE/2, x + j - TSIZE/2)`.
+     * A filter built from a row and a column vector is separable and runs in two passes.
+     *
+     * @tparam TSIZE The side length, 3 or 5
+     *
+     * Example usage:
+     * @code
+     * auto blur = adaptive::conv_filter<5>::gaussian();
+     * adaptive::conv_filter<3> sharpen({ 0, -1, 0, -1, 5, -1, 0, -1, 0 });
+     * @endcode
+     */
+    template <size_t TSIZE>
+    class conv_filter {
+        static_assert(TSIZE == 3 || TSIZE == 5, "conv_filter: 3x3 and 5x5 stencils are supported");
+    public:
+        using this_type = conv_filter<TSIZE>;
+        using weights_type = std::array<int16_t, TSIZE * TSIZE>;
+        using vector_type = std::array<int16_t, TSIZE>;
+
+        static constexpr size_t size = TSIZE;
+
+        /**
+         * @brief Constructor for a general (non separable) filter
+         *
+         * @param weights The row-major `TSIZE` x `TSIZE` weights
+         * @param shift The right shift applied to every sum, at most 15
+         *
+         * @throw std::invalid_argument if the shift is out of range or the sum of the absolute weights exceeds 65535
+         */
+        explicit conv_filter(const weights_type& weights, unsigned shift = 0)
+            : m_aWeights(weights), m_aRow(), m_aCol(), m_bSeparable(false), m_uShift(shift) {
+            validate();
+        }
+        /**
+         * @brief Constructor for a separable filter, the weights are `col[i] * row[j]`
+         *
+         * @param row The horizontal weights
+         * @param col The vertical weights
+         * @param shift The right shift applied to every sum, at most 15
+         *
+         * @throw std::invalid_argument if the shift is out of range, a product does not fit int16 or the
+         * sum of the absolute weights exceeds 65535
+         */
+        conv_filter(const vector_type& row, const vector_type& col, unsigned shift = 0)
+            : m_aWeights(), m_aRow(row), m_aCol(col), m_bSeparable(true), m_uShift(shift) {
+            for(size_t i = 0; i < TSIZE; ++i)
+                for(size_t j = 0; j < TSIZE; ++j) {
+                    const int32_t w = int32_t(col[i]) * row[j];
+                    if(w < INT16_MIN || w > INT16_MAX) throw std::invalid_argument("conv_filter: weight out of range");
+                    m_aWeights[i * TSIZE + j] = int16_t(w);
+                }
+            validate();
+        }
+
+        /**
+         * @brief Normalized binomial blur, `[1 2 1]` or `[1 4 6 4 1]` in both directions
+         */
+        static this_type gaussian() {
+            if constexpr (TSIZE == 3) return this_type({ 1, 2, 1 }, { 1, 2, 1 }, 4);
+            else return this_type({ 1, 4, 6, 4, 1 }, { 1, 4, 6, 4, 1 }, 8);
+        }
+        /**
+         * @brief Horizontal Sobel derivative, signed, use an int16 output
+         */
+        static this_type sobel_x() {
+            if constexpr (TSIZE == 3) return this_type({ -1, 0, 1 }, { 1, 2, 1 });
+            else return this_type({ -1, -2, 0, 2, 1 }, { 1, 4, 6, 4, 1 });
+        }
+        /**
+         * @brief Vertical Sobel derivative, signed, use an int16 output
+         */
+        static this_type sobel_y() {
+            if constexpr (TSIZE == 3) return this_type({ 1, 2, 1 }, { -1, 0, 1 });
+            else return this_type({ 1, 4, 6, 4, 1 }, { -1, -2, 0, 2, 1 });
+        }
+
+        const weights_type& weights() const noexcept { return m_aWeights; }
+        const vector_type& row_weights() const noexcept { return m_aRow; }
+        const vector_type& col_weights() const noexcept { return m_aCol; }
+        bool is_separable() const noexcept { return m_bSeparable; }
+        unsigned shift() const noexcept { return m_uShift; }
+
+    protected:
+        void validate() const {
+            if(m_uShift > 15) throw std::invalid_argument("conv_filter: shift out of range");
+            int32_t _sum = 0;
+            for(int16_t w : m_aWeights) _sum += std::abs(int32_t(w));
+            if(_sum > 65535) throw std::invalid_argument("conv_filter: weights too large for int32 sums");
+        }
+
+    protected:
+        weights_type m_aWeights;
+        vector_type m_aRow;
+        vector_type m_aCol;
+        bool m_bSeparable;
+        unsigned m_uShift;
+    };
+
+namespace internal {
+    /**
+     * @brief Maps the row or column `i` of `[0, n)` into the image, -1 for a constant pixel
+     */
+    inline ptrdiff_t stencil_border_index(ptrdiff_t i, ptrdiff_t n, border_mode mode) {
+        if(i >= 0 && i < n) return i;
+        switch(mode) {
+        case border_mode::Constant: return -1;
+        case border_mode::Replicate: return i < 0 ? 0 : n - 1;
+        case border_mode::Wrap: return ((i % n) + n) % n;
+        default:
+            if(n == 1) return 0;
+            while(i < 0 || i >= n) i = i < 0 ? -i : 2 * (n - 1) - i;
+            return i;
+        }
+    }
+
+    /**
+     * @brief Returns true if the int16 `pmaddubsw` sums of `w` over uint8 pixels cannot overflow
+     */
+    template <size_t N>
+    bool stencil_fits_i16(const std::array<int16_t, N>& w, int32_t round) {
+        int32_t _sum = 0;
+        for(int16_t v : w) {
+            if(v < INT8_MIN || v > INT8_MAX) return false;
+            _sum += std::abs(int32_t(v));
+        }
+        return _sum * 255 + round <= INT16_MAX;
+    }
+
+    /**
+     * @brief Convolves the output rows `[y0, y1)`, streaming the source through a ring of padded rows
+     */
+    template <techn_t TTECH, typename TSRC, typename TDST, size_t K>
+    void stencil_band(const adaptive_matrix<TSRC, TTECH>& src, adaptive_matrix<TDST, TTECH>& dst,
+                      const conv_filter<K>& filter, border_mode mode, TSRC value, size_t y0, size_t y1) {
+        using kernel_type = stencil_kernel<TTECH>;
+        constexpr size_t pad = K / 2;
+        constexpr size_t slack = ADAPTIVE_STENCIL_SLACK;
+
+        const size_t H = src.rows(), W = src.cols();
+        const size_t rstride = W + K - 1 + slack;
+        const size_t astride = W + slack;
+        const int32_t round = filter.shift() ? int32_t(1) << (filter.shift() - 1) : 0;
+
+        auto fetch = [&](ptrdiff_t sy, TSRC* buf) {
+            const ptrdiff_t y = stencil_border_index(sy, ptrdiff_t(H), mode);
+            if(y < 0) { std::fill(buf, buf + W + K - 1, value); return; }
+            const TSRC* row = src.row(size_t(y));
+            std::copy(row, row + W, buf + pad);
+            for(size_t j = 1; j <= pad; ++j) {
+                const ptrdiff_t l = stencil_border_index(-ptrdiff_t(j), ptrdiff_t(W), mode);
+                const ptrdiff_t r = stencil_border_index(ptrdiff_t(W - 1 + j), ptrdiff_t(W), mode);
+                buf[pad - j] = l < 0 ? value : row[l];
+                buf[pad + W - 1 + j] = r < 0 ? value : row[r];
+            }
+        };
+        auto slot = [](ptrdiff_t sy) { return size_t(((sy % ptrdiff_t(K)) + ptrdiff_t(K)) % ptrdiff_t(K)); };
+
+        std::vector<int32_t, aligned_allocator<int32_t> > acc(astride);
+
+        if(filter.is_separable()) {
+            const bool narrow = std::is_same<TSRC, uint8_t>::value && stencil_fits_i16(filter.row_weights(), 0);
+            std::vector<TSRC, aligned_allocator<TSRC> > scratch(rstride);
+            std::vector<int16_t, aligned_allocator<int16_t> > hring16(narrow ? K * astride : 0);
+            std::vector<int32_t, aligned_allocator<int32_t> > hring32(narrow ? 0 : K * astride);
+
+            // Horizontal pass of source row `sy` into its ring slot.
+            auto push = [&](ptrdiff_t sy) {
+                fetch(sy, scratch.data());
+                if constexpr (std::is_same<TSRC, uint8_t>::value) {
+                    if(narrow) {
+                        int16_t* h = hring16.data() + slot(sy) * astride;
+                        std::fill(h, h + W, int16_t(0));
+                        kernel_type::hrow_u8_i16(scratch.data(), filter.row_weights().data(), K, h, W);
+                        return;
+                    }
+                }
+                int32_t* h = hring32.data() + slot(sy) * astride;
+                std::fill(h, h + W, 0);
+                kernel_type::hrow_i32(scratch.data(), filter.row_weights().data(), K, h, W);
+            };
+
+            for(ptrdiff_t sy = ptrdiff_t(y0) - ptrdiff_t(pad); sy < ptrdiff_t(y0 + pad); ++sy) push(sy);
+            for(size_t y = y0; y < y1; ++y) {
+                push(ptrdiff_t(y + pad));
+                std::fill(acc.begin(), acc.begin() + W, 0);
+                if(narrow) {
+                    const int16_t* rows[K];
+                    for(size_t i = 0; i < K; ++i) rows[i] = hring16.data() + slot(ptrdiff_t(y + i) - ptrdiff_t(pad)) * astride;
+                    kernel_type::vcol_i32(rows, filter.col_weights().data(), K, acc.data(), W);
+                } else {
+                    const int32_t* rows[K];
+                    for(size_t i = 0; i < K; ++i) rows[i] = hring32.data() + slot(ptrdiff_t(y + i) - ptrdiff_t(pad)) * astride;
+                    kernel_type::vcol_i32(rows, filter.col_weights().data(), K, acc.data(), W);
+                }
+                kernel_type::store(acc.data(), dst.row(y), W, filter.shift());
+            }
+        } else {
+            const bool narrow = std::is_same<TSRC, uint8_t>::value && stencil_fits_i16(filter.weights(), round);
+            std::vector<TSRC, aligned_allocator<TSRC> > ring(K * rstride);
+            std::vector<int16_t, aligned_allocator<int16_t> > acc16(narrow ? astride : 0);
+
+            for(ptrdiff_t sy = ptrdiff_t(y0) - ptrdiff_t(pad); sy < ptrdiff_t(y0 + pad); ++sy)
+                fetch(sy, ring.data() + slot(sy) * rstride);
+            for(size_t y = y0; y < y1; ++y) {
+                fetch(ptrdiff_t(y + pad), ring.data() + slot(ptrdiff_t(y + pad)) * rstride);
+                const int16_t* w = filter.weights().data();
+
+                if constexpr (std::is_same<TSRC, uint8_t>::value) {
+                    if(narrow) {
+                        std::fill(acc16.begin(), acc16.begin() + W, int16_t(0));
+                        for(size_t i = 0; i < K; ++i)
+                            kernel_type::hrow_u8_i16(ring.data() + slot(ptrdiff_t(y + i) - ptrdiff_t(pad)) * rstride,
+                                                     w + i * K, K, acc16.data(), W);
+                        kernel_type::store(acc16.data(), dst.row(y), W, filter.shift());
+                        continue;
+                    }
+                }
+                std::fill(acc.begin(), acc.begin() + W, 0);
+                for(size_t i = 0; i < K; ++i)
+                    kernel_type::hrow_i32(ring.data() + slot(ptrdiff_t(y + i) - ptrdiff_t(pad)) * rstride,
+                                          w + i * K, K, acc.data(), W);
+                kernel_type::store(acc.data(), dst.row(y), W, filter.shift());
+            }
+        }
+    }
+
+    template <typename TSRC, typename TDST, techn_t TTECH>
+    void stencil_check(const adaptive_matrix<TSRC, TTECH>& src, adaptive_matrix<TDST, TTECH>& dst) {
+        static_assert((std::is_same<TSRC, uint8_t>::value && (std::is_same<TDST, uint8_t>::value || std::is_same<TDST, int16_t>::value)) ||
+                      (std::is_same<TSRC, int16_t>::value && std::is_same<TDST, int16_t>::value),
+                      "convolve: supported are uint8 -> uint8, uint8 -> int16 and int16 -> int16");
+        if(static_cast<const void*>(&src) == static_cast<const void*>(&dst))
+            throw std::invalid_argument("convolve: dst aliases source");
+        dst.resize(src.rows(), src.cols());
+    }
+}
+
+    /**
+     * @brief Single-threaded 2D convolution of `src` with `filter` into `dst`
+     *
+     * Each output is `saturate((sum w * in + round) >> shift)`, the pixels outside of
+     * the image are read according to `mode`.
+     *
+     * @param src The source image, uint8 or int16
+     * @param dst Receives the filtered image, reshaped to the shape of `src`; uint8 or
+     * int16 for a uint8 source, int16 for an int16 source
+     * @param filter The stencil
+     * @param mode How the border is read
+     * @param value The pixel value outside of the image for `border_mode::Constant`
+     *
+     * @throw std::invalid_argument if `dst` is `src`
+     */
+    template <typename TSRC, typename TDST, techn_t TTECH, size_t K>
+    void convolve(const adaptive_matrix<TSRC, TTECH>& src, adaptive_matrix<TDST, TTECH>& dst, const conv_filter<K>& filter,
+                  border_mode mode = border_mode::Replicate, typename adaptive_matrix<TSRC, TTECH>::value_type value = 0) {
+        internal::stencil_check(src, dst);
+        if(src.size() == 0) return;
+        internal::stencil_band(src, dst, filter, mode, value, 0, src.rows());
+    }
+    /**
+     * @brief Multi-threaded 2D convolution on `pool`
+     *
+     * The image is cut into bands of rows (at least `ADAPTIVE_STENCIL_MIN_BAND`), each
+     * band streams its own rows, the `K - 1` halo rows are read by both neighbours.
+     */
+    template <typename TSRC, typename TDST, techn_t TTECH, size_t K>
+    void convolve(const adaptive_matrix<TSRC, TTECH>& src, adaptive_matrix<TDST, TTECH>& dst, const conv_filter<K>& filter,
+                  thread_pool& pool, border_mode mode = border_mode::Replicate, typename adaptive_matrix<TSRC, TTECH>::value_type value = 0) {
+        internal::stencil_check(src, dst);
+        if(src.size() == 0) return;
+
+        const size_t bands = std::max<size_t>(1, std::min(4 * pool.size(), src.rows() / ADAPTIVE_STENCIL_MIN_BAND));
+        internal::parallel_for(0, src.rows(), bands, [&](size_t, size_t y0, size_t y1) {
+            internal::stencil_band(src, dst, filter, mode, value, y0, y1);
+        }, pool);
+    }
+    /**
+     * @brief Returns `src` convolved with `filter`, the output has the element type of `src`
+     */
+    template <typename TINT, techn_t TTECH, size_t K>
+    adaptive_matrix<TINT, TTECH> convolve(const adaptive_matrix<TINT, TTECH>& src, const conv_filter<K>& filter,
+                                          border_mode mode = border_mode::Replicate,
+                                          typename adaptive_matrix<TINT, TTECH>::value_type value = 0) {
+        adaptive_matrix<TINT, TTECH> _result;
+        convolve(src, _result, filter, mode, value);
+        return _result;
+    }
+}
+
+#endif
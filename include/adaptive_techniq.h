@@ -1,6 +1,8 @@
 #ifndef ADAPTIVE_ENUM_TECH_H
 #define ADAPTIVE_ENUM_TECH_H
 
+#include <string>
+
 #ifndef ADAPTIVE_BASE_TECHNIQ_USE 
 #define ADAPTIVE_BASE_TECHNIQ_USE internal::detected_techniq_used<TINT>()
 #endif
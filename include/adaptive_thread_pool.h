@@ -0,0 +1,299 @@
+/**
+ * @file adaptive_thread_pool.h
+ * @brief Header file for the work-stealing thread pool of the library.
+ *
+ * This file defines the `thread_pool` class. Every worker owns a task deque; it pops
+ * its own work from the back and steals from the front of the other deques when it
+ * runs dry, so uneven tasks (edge tiles, skewed rows) balance themselves. The thread
+ * that submits a batch works on it too, which also makes nested parallel calls safe;
+ * it only blocks once no queued task is left for it to take.
+ *
+ * A pool can pin its workers to CPUs (`thread_affinity`): a worker that the scheduler
+ * moves to another core leaves its L1 and L2 contents behind, which shows as run to
+ * run variance of the cache-blocked kernels on busy machines.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_THREAD_POOL__
+#define __ADAPTIVE_THREAD_POOL__ 1
+
+#include <cstddef>
+#include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <internal/affinity.h>
+
+/**
+ * @brief Number of times `thread_pool::parallel` yields while no task is left before it blocks.
+ */
+#ifndef ADAPTIVE_POOL_SPIN
+#define ADAPTIVE_POOL_SPIN 64
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Get the number of threads to use when the caller passed `threads`
+     *
+     * @param threads The requested thread count, 0 selects all hardware threads
+     */
+    inline size_t resolve_threads(size_t threads) {
+        if(threads == 0) threads = std::thread::hardware_concurrency();
+        return std::max<size_t>(threads, 1);
+    }
+}
+
+    /**
+     * @class thread_pool
+     * @brief A work-stealing pool of worker threads
+     *
+     * A pool of size `n` runs `n - 1` worker threads; the thread calling `parallel` is
+     * the n-th worker for the duration of the call.
+     *
+     * Example usage:
+     * @code
+     * adaptive::thread_pool pool(4);
+     * pool.parallel(100, [&](size_t i) { work(i); });
+     * @endcode
+     */
+    class thread_pool {
+    public:
+        using this_type = thread_pool;
+        using size_type = size_t;
+        using task_type = std::function<void()>;
+
+        /**
+         * @brief Constructor for a pool with the given concurrency
+         *
+         * Worker `i` is pinned to the `i`-th CPU of the placement, the caller's CPU (the
+         * first) is reserved for `pin_caller`.
+         *
+         * @param threads The number of threads including the caller, 0 selects all hardware threads
+         * @param affinity The CPUs of the threads
+         * @throw std::invalid_argument if `affinity.cpus` names a CPU the process may not run on
+         */
+        explicit thread_pool(size_type threads = 0, const thread_affinity& affinity = thread_affinity())
+            : m_szQueued(0), m_bStop(false) {
+            const size_t n = internal::resolve_threads(threads);
+            m_vPlan = internal::plan_placement(affinity, n);
+            m_vCpus.assign(n, -1);
+
+            for(size_t i = 0; i < n; ++i) m_vQueues.emplace_back(new worker_queue());
+            for(size_t i = 1; i < n; ++i) {
+                m_vThreads.emplace_back(&thread_pool::worker_loop, this, i);
+                if(internal::pin_thread(m_vThreads.back(), m_vPlan[i])) m_vCpus[i] = m_vPlan[i];
+            }
+        }
+        thread_pool(const this_type&) = delete;
+        this_type& operator = (const this_type&) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mtxWake);
+                m_bStop = true;
+            }
+            m_cvWake.notify_all();
+            for(auto& t : m_vThreads) t.join();
+        }
+
+        /**
+         * @brief Get the concurrency of the pool, the worker threads plus the caller
+         */
+        size_type size() const noexcept { return m_vQueues.size(); }
+
+        /**
+         * @brief Get the CPU every thread is pinned to, -1 for the unpinned ones
+         *
+         * Entry 0 is the caller, pinned only after `pin_caller`.
+         */
+        const std::vector<int>& placement() const noexcept { return m_vCpus; }
+
+        /**
+         * @brief Pins the calling thread to the first CPU of the placement
+         *
+         * @return False if the pool has no placement or the thread could not be pinned
+         */
+        bool pin_caller() {
+            if(!internal::pin_current_thread(m_vPlan[0])) return false;
+            m_vCpus[0] = m_vPlan[0];
+            return true;
+        }
+
+        /**
+         * @brief Get a line per thread with its CPU, core and package
+         */
+        std::string placement_report() const {
+            std::string _result;
+            char _line[96];
+            for(size_t i = 0; i < m_vCpus.size(); ++i) {
+                const internal::cpu_info* info = internal::cpu_topology::get().find(m_vCpus[i]);
+                if(m_vCpus[i] < 0 || info == nullptr)
+                    std::snprintf(_line, sizeof(_line), "thread %3zu  not pinned\n", i);
+                else
+                    std::snprintf(_line, sizeof(_line), "thread %3zu  cpu %4d  core %4d  package %2d%s\n", i, info->cpu,
+                                  info->core, info->package, info->smt != 0 ? "  smt sibling" : "");
+                _result += _line;
+            }
+            return _result;
+        }
+
+        /**
+         * @brief Get the process wide default pool, sized to the hardware threads
+         */
+        static this_type& instance() {
+            static this_type _pool;
+            return _pool;
+        }
+
+        /**
+         * @brief Runs `fn(i)` for every `i` in `[0, tasks)` and returns when all are done
+         *
+         * The tasks are dealt round robin to the worker deques. The first exception thrown
+         * by a task is rethrown here after every task has finished.
+         *
+         * @param tasks The number of tasks
+         * @param fn The task function
+         */
+        template <typename TFUNC>
+        void parallel(size_type tasks, TFUNC&& fn) {
+            if(tasks == 0) return;
+            if(tasks == 1 || size() == 1) {
+                for(size_t i = 0; i < tasks; ++i) fn(i);
+                return;
+            }
+
+            std::atomic<size_t> remaining(tasks);
+            std::exception_ptr error;
+            std::mutex batch_lock;
+            std::condition_variable done;
+            const size_t self = self_index();
+
+            for(size_t i = 0; i < tasks; ++i) {
+                worker_queue& q = *m_vQueues[(self + i) % size()];
+                std::lock_guard<std::mutex> lock(q.lock);
+                q.tasks.emplace_back([&fn, &remaining, &error, &batch_lock, &done, i]() {
+                    std::exception_ptr _error;
+                    try { fn(i); }
+                    catch(...) { _error = std::current_exception(); }
+                    // Under the lock, so the caller cannot return while the last task still notifies.
+                    std::lock_guard<std::mutex> guard(batch_lock);
+                    if(_error && !error) error = _error;
+                    if(remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) done.notify_all();
+                });
+            }
+            m_szQueued.fetch_add(tasks, std::memory_order_release);
+            { std::lock_guard<std::mutex> lock(m_mtxWake); }
+            m_cvWake.notify_all();
+
+            // Help while there is work, spin briefly when there is none, then sleep until
+            // the tasks still running elsewhere are done.
+            for(size_t spins = 0; remaining.load(std::memory_order_acquire) != 0 && spins < ADAPTIVE_POOL_SPIN; ) {
+                task_type t;
+                if(try_pop(self, t)) { t(); spins = 0; }
+                else { std::this_thread::yield(); ++spins; }
+            }
+            std::unique_lock<std::mutex> lock(batch_lock);
+            done.wait(lock, [&remaining]() { return remaining.load(std::memory_order_acquire) == 0; });
+            if(error) std::rethrow_exception(error);
+        }
+
+        /**
+         * @brief Queues `task` on a worker and returns without waiting for it
+         *
+         * The task must not throw. A pool without worker threads runs it on the caller
+         * before returning.
+         *
+         * @param task The task
+         */
+        void submit(task_type task) {
+            if(size() == 1) {
+                task();
+                return;
+            }
+            {
+                worker_queue& q = *m_vQueues[self_index() % (size() - 1) + 1];
+                std::lock_guard<std::mutex> lock(q.lock);
+                q.tasks.emplace_back(std::move(task));
+            }
+            m_szQueued.fetch_add(1, std::memory_order_release);
+            { std::lock_guard<std::mutex> lock(m_mtxWake); }
+            m_cvWake.notify_one();
+        }
+
+    protected:
+        /**
+         * @brief The task deque of one worker, padded to its own cache lines
+         */
+        struct alignas(64) worker_queue {
+            std::mutex lock;
+            std::deque<task_type> tasks;
+        };
+
+        static this_type*& tls_pool()  { static thread_local this_type* _pool = nullptr; return _pool; }
+        static size_t& tls_index()     { static thread_local size_t _index = 0; return _index; }
+
+        /**
+         * @brief Get the deque of the calling thread, 0 for threads outside of the pool
+         */
+        size_t self_index() const { return tls_pool() == this ? tls_index() : 0; }
+
+        /**
+         * @brief Pops from the back of the own deque or steals from the front of another
+         */
+        bool try_pop(size_t self, task_type& t) {
+            if(m_szQueued.load(std::memory_order_acquire) == 0) return false;
+
+            for(size_t n = 0; n < size(); ++n) {
+                worker_queue& q = *m_vQueues[(self + n) % size()];
+                std::lock_guard<std::mutex> lock(q.lock);
+                if(q.tasks.empty()) continue;
+                if(n == 0) { t = std::move(q.tasks.back()); q.tasks.pop_back(); }
+                else       { t = std::move(q.tasks.front()); q.tasks.pop_front(); }
+                m_szQueued.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+            return false;
+        }
+
+        void worker_loop(size_t index) {
+            tls_pool() = this;
+            tls_index() = index;
+
+            while(true) {
+                task_type t;
+                if(try_pop(index, t)) { t(); continue; }
+
+                std::unique_lock<std::mutex> lock(m_mtxWake);
+                m_cvWake.wait(lock, [this]() { return m_bStop || m_szQueued.load(std::memory_order_acquire) > 0; });
+                if(m_bStop && m_szQueued.load(std::memory_order_acquire) == 0) return;
+            }
+        }
+
+    protected:
+        std::vector<std::unique_ptr<worker_queue> > m_vQueues;
+        std::vector<std::thread> m_vThreads;
+        std::vector<int> m_vPlan;
+        std::vector<int> m_vCpus;
+        std::atomic<size_t> m_szQueued;
+        std::mutex m_mtxWake;
+        std::condition_variable m_cvWake;
+        bool m_bStop;
+    };
+}
+
+#endif
@@ -1 +1,185 @@
-    
\ No newline at end of file
+/**
+ * @file adaptive_vector.h
+ * @brief Header file for adaptive integer vectors with customizable techniques.
+ *
+ * This file defines the `adaptive_vector` class template, a dense one dimensional array
+ * of integers in cache line aligned storage. It is the array type the batch kernels of
+ * the library work on; like `adaptive_matrix` it carries the technique its kernels are
+ * dispatched to.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_VECTOR__
+#define __ADAPTIVE_VECTOR__ 1
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+
+#include <adaptive_integer.h>
+#include <adaptive_view.h>
+
+#include <internal/aligned_allocator.h>
+
+namespace adaptive {
+    /**
+     * @brief A template class that implements a dense integer array with customizable technique
+     *
+     * @tparam TINT The base integer type of the elements
+     * @tparam TTECH The technique type for the kernels working on this array
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_vector<int32_t, adaptive::techn_t::AVX> v(1024, 1);
+     * v[3] = 42;
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_vector {
+    public:
+        using number_type = adaptive_number<TINT, TTECH>;
+        using backend_type = typename number_type::backend_type;
+        using this_type = adaptive_vector<TINT, TTECH>;
+        using value_type = TINT;
+        using size_type = size_t;
+        using pointer = this_type*;
+        using reference = this_type&;
+        using const_pointer = const this_type*;
+        using const_refernce = const this_type&;
+        using const_type = const this_type;
+        using storage_type = std::vector<value_type, aligned_allocator<value_type> >;
+        using iterator = typename storage_type::iterator;
+        using const_iterator = typename storage_type::const_iterator;
+        using view_type = adaptive_vector_view<TINT, TTECH>;
+        using const_view_type = adaptive_vector_view<const TINT, TTECH>;
+
+        /**
+         * @brief Default constructor, creates an empty vector
+         */
+        adaptive_vector() noexcept = default;
+        /**
+         * @brief Constructor for a vector of `size` elements
+         *
+         * @param size The number of elements
+         * @param value The initial value of every element
+         */
+        explicit adaptive_vector(size_type size, value_type value = 0)
+            : m_vData(size, value) { }
+        /**
+         * @brief Constructor from a list of values
+         */
+        adaptive_vector(std::initializer_list<value_type> values)
+            : m_vData(values) { }
+        /**
+         * @brief Constructor that materializes a view
+         *
+         * @param view The view to copy, any stride
+         */
+        explicit adaptive_vector(const const_view_type& view)
+            : m_vData(view.size()) {
+            view_copy(view, this->view());
+        }
+
+        adaptive_vector(const_refernce other) = default;
+        adaptive_vector(this_type&& other) noexcept = default;
+        virtual ~adaptive_vector() = default;
+
+        this_type& operator = (const_refernce other) = default;
+        this_type& operator = (this_type&& other) noexcept = default;
+
+        /**
+         * @brief Get the number of elements
+         */
+        size_type size() const noexcept      { return m_vData.size(); }
+        bool empty() const noexcept          { return m_vData.empty(); }
+        /**
+         * @brief Get the technique used by this vector
+         */
+        techn_t get_techniq() const noexcept { return TTECH; }
+
+        value_type* data() noexcept             { return m_vData.data(); }
+        const value_type* data() const noexcept { return m_vData.data(); }
+
+        iterator begin() noexcept             { return m_vData.begin(); }
+        iterator end() noexcept               { return m_vData.end(); }
+        const_iterator begin() const noexcept { return m_vData.begin(); }
+        const_iterator end() const noexcept   { return m_vData.end(); }
+
+        value_type& operator [] (size_type i) noexcept             { return m_vData[i]; }
+        const value_type& operator [] (size_type i) const noexcept { return m_vData[i]; }
+
+        /**
+         * @brief Bounds checked element access
+         *
+         * @throw std::out_of_range if `i` is outside of the vector
+         */
+        value_type& at(size_type i)             { return m_vData.at(i); }
+        const value_type& at(size_type i) const { return m_vData.at(i); }
+
+        /**
+         * @brief Set every element to `value`
+         */
+        void fill(value_type value) {
+            std::fill(m_vData.begin(), m_vData.end(), value);
+        }
+        /**
+         * @brief Returns a view of the whole vector
+         */
+        view_type view() noexcept             { return view_type(data(), size()); }
+        const_view_type view() const noexcept { return const_view_type(data(), size()); }
+        /**
+         * @brief Returns a view of every `step`-th element of `[begin, begin + count * step)`, no copy
+         *
+         * @throw std::out_of_range if the slice leaves the vector
+         */
+        view_type slice(size_type begin, size_type count, ptrdiff_t step = 1) {
+            return view().slice(begin, count, step);
+        }
+        const_view_type slice(size_type begin, size_type count, ptrdiff_t step = 1) const {
+            return view().slice(begin, count, step);
+        }
+
+        /**
+         * @brief Changes the number of elements, new elements are set to `value`
+         */
+        void resize(size_type size, value_type value = 0) {
+            m_vData.resize(size, value);
+        }
+
+        bool operator == (const_refernce o) const noexcept { return m_vData == o.m_vData; }
+        bool operator != (const_refernce o) const noexcept { return !(*this == o); }
+
+    protected:
+        /**
+         * @brief The elements
+         */
+        storage_type m_vData;
+    };
+
+    template <techn_t TTECH = internal::detected_techniq_used<int8_t>() >
+    using int8_vector_t = adaptive_vector<int8_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<int16_t>() >
+    using int16_vector_t = adaptive_vector<int16_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<int32_t>() >
+    using int32_vector_t = adaptive_vector<int32_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<int64_t>() >
+    using int64_vector_t = adaptive_vector<int64_t, TTECH>;
+
+    template <techn_t TTECH = internal::detected_techniq_used<uint8_t>() >
+    using uint8_vector_t = adaptive_vector<uint8_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint16_t>() >
+    using uint16_vector_t = adaptive_vector<uint16_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint32_t>() >
+    using uint32_vector_t = adaptive_vector<uint32_t, TTECH>;
+    template <techn_t TTECH = internal::detected_techniq_used<uint64_t>() >
+    using uint64_vector_t = adaptive_vector<uint64_t, TTECH>;
+}
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file adaptive_view.h
+ * @brief Header file for non-owning strided views over adaptive storage.
+ *
+ * This file defines `adaptive_vector_view` and `adaptive_matrix_view`, which look into
+ * the storage of an `adaptive_vector` or `adaptive_matrix` (or any other memory) with
+ * arbitrary strides. Slicing a row, a column, a sub-block or the transpose of a matrix
+ * is a constant time operation that copies nothing. `view_copy` materializes a view and
+ * picks the cheapest kernel for the actual layout: `memcpy` for contiguous rows, the
+ * transpose kernel for column-major data and gathers only for truly strided elements.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __ADAPTIVE_VIEW__
+#define __ADAPTIVE_VIEW__ 1
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+
+#include <internal/kernel_strided.h>
+#include <internal/kernel_transpose.h>
+
+namespace adaptive {
+    /**
+     * @brief A non-owning view of `size` elements that are `stride` elements apart
+     *
+     * @tparam TINT The element type, const qualified for read-only views
+     * @tparam TTECH The technique type for the kernels working on this view
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_vector_view {
+    public:
+        using this_type = adaptive_vector_view<TINT, TTECH>;
+        using element_type = TINT;
+        using value_type = typename std::remove_cv<TINT>::type;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using const_view_type = adaptive_vector_view<const value_type, TTECH>;
+
+        adaptive_vector_view() noexcept
+            : m_pData(nullptr), m_szSize(0), m_iStride(1) { }
+        /**
+         * @brief Constructor for a view of `size` elements starting at `data`
+         *
+         * @param data The first element
+         * @param size The number of elements
+         * @param stride The distance between two elements, in elements
+         */
+        adaptive_vector_view(element_type* data, size_type size, difference_type stride = 1) noexcept
+            : m_pData(data), m_szSize(size), m_iStride(stride) { }
+
+        /**
+         * @brief Conversion of a mutable view into a read-only view
+         */
+        operator const_view_type() const noexcept { return const_view_type(m_pData, m_szSize, m_iStride); }
+
+        size_type size() const noexcept         { return m_szSize; }
+        difference_type stride() const noexcept { return m_iStride; }
+        element_type* data() const noexcept     { return m_pData; }
+        techn_t get_techniq() const noexcept    { return TTECH; }
+        /**
+         * @brief Returns true if the elements are adjacent in memory
+         */
+        bool is_contiguous() const noexcept     { return m_iStride == 1 || m_szSize <= 1; }
+
+        element_type& operator [] (size_type i) const noexcept { return m_pData[difference_type(i) * m_iStride]; }
+        element_type& at(size_type i) const {
+            if(i >= m_szSize) throw std::out_of_range("adaptive_vector_view: index out of range");
+            return (*this)[i];
+        }
+
+        /**
+         * @brief Returns the view of every `step`-th element of `[begin, begin + count * step)`
+         *
+         * @throw std::out_of_range if the slice leaves the view
+         */
+        this_type slice(size_type begin, size_type count, difference_type step = 1) const {
+            if(count > 0 && (step <= 0 || begin + (count - 1) * size_type(step) >= m_szSize))
+                throw std::out_of_range("adaptive_vector_view::slice: out of range");
+            return this_type(m_pData + difference_type(begin) * m_iStride, count, m_iStride * step);
+        }
+
+    protected:
+        element_type* m_pData;
+        size_type m_szSize;
+        difference_type m_iStride;
+    };
+
+    /**
+     * @brief A non-owning `rows` x `cols` view with independent row and element strides
+     *
+     * Element `(r, c)` is at `data()[r * row_stride() + c * col_stride()]`. A view of a
+     * row-major matrix has `col_stride() == 1`, its `transposed()` view has `row_stride() == 1`.
+     *
+     * @tparam TINT The element type, const qualified for read-only views
+     * @tparam TTECH The technique type for the kernels working on this view
+     *
+     * Example usage:
+     * @code
+     * adaptive::adaptive_matrix<int32_t> m(512, 512);
+     * auto block = m.submatrix(64, 64, 128, 128);   // no copy
+     * auto col = m.col_view(3);                     // no copy, stride 512
+     * adaptive::adaptive_matrix<int32_t> t(m.view().transposed());
+     * @endcode
+     */
+    template <typename TINT, techn_t TTECH = ADAPTIVE_BASE_TECHNIQ_USE >
+    class adaptive_matrix_view {
+    public:
+        using this_type = adaptive_matrix_view<TINT, TTECH>;
+        using element_type = TINT;
+        using value_type = typename std::remove_cv<TINT>::type;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using const_view_type = adaptive_matrix_view<const value_type, TTECH>;
+        using vector_view_type = adaptive_vector_view<TINT, TTECH>;
+
+        adaptive_matrix_view() noexcept
+            : m_pData(nullptr), m_szRows(0), m_szCols(0), m_iRowStride(0), m_iColStride(1) { }
+        /**
+         * @brief Constructor for a view of `rows` x `cols` elements starting at `data`
+         *
+         * @param data The element `(0, 0)`
+         * @param rows The number of rows
+         * @param cols The number of columns
+         * @param row_stride The distance between two rows, in elements
+         * @param col_stride The distance between two elements of a row, in elements
+         */
+        adaptive_matrix_view(element_type* data, size_type rows, size_type cols,
+                             difference_type row_stride, difference_type col_stride = 1) noexcept
+            : m_pData(data), m_szRows(rows), m_szCols(cols), m_iRowStride(row_stride), m_iColStride(col_stride) { }
+
+        /**
+         * @brief Conversion of a mutable view into a read-only view
+         */
+        operator const_view_type() const noexcept {
+            return const_view_type(m_pData, m_szRows, m_szCols, m_iRowStride, m_iColStride);
+        }
+
+        size_type rows() const noexcept             { return m_szRows; }
+        size_type cols() const noexcept             { return m_szCols; }
+        size_type size() const noexcept             { return m_szRows * m_szCols; }
+        difference_type row_stride() const noexcept { return m_iRowStride; }
+        difference_type col_stride() const noexcept { return m_iColStride; }
+        element_type* data() const noexcept         { return m_pData; }
+        techn_t get_techniq() const noexcept        { return TTECH; }
+
+        /**
+         * @brief Returns true if the elements of each row are adjacent in memory
+         */
+        bool has_contiguous_rows() const noexcept { return m_iColStride == 1 || m_szCols <= 1; }
+        /**
+         * @brief Returns true if the whole view is one dense row-major block
+         */
+        bool is_contiguous() const noexcept {
+            return has_contiguous_rows() && (m_iRowStride == difference_type(m_szCols) || m_szRows <= 1);
+        }
+
+        element_type& operator () (size_type r, size_type c) const noexcept {
+            return m_pData[difference_type(r) * m_iRowStride + difference_type(c) * m_iColStride];
+        }
+        element_type& at(size_type r, size_type c) const {
+            if(r >= m_szRows || c >= m_szCols) throw std::out_of_range("adaptive_matrix_view: index out of range");
+            return (*this)(r, c);
+        }
+
+        /**
+         * @brief Returns the view of row `r`
+         */
+        vector_view_type row(size_type r) const noexcept {
+            return vector_view_type(m_pData + difference_type(r) * m_iRowStride, m_szCols, m_iColStride);
+        }
+        /**
+         * @brief Returns the view of column `c`
+         */
+        vector_view_type col(size_type c) const noexcept {
+            return vector_view_type(m_pData + difference_type(c) * m_iColStride, m_szRows, m_iRowStride);
+        }
+        /**
+         * @brief Returns the view of the `rows` x `cols` block starting at `(r0, c0)`
+         *
+         * @throw std::out_of_range if the block leaves the view
+         */
+        this_type submatrix(size_type r0, size_type c0, size_type rows, size_type cols) const {
+            if(r0 + rows > m_szRows || c0 + cols > m_szCols)
+                throw std::out_of_range("adaptive_matrix_view::submatrix: out of range");
+            return this_type(&(*this)(r0, c0), rows, cols, m_iRowStride, m_iColStride);
+        }
+        /**
+         * @brief Returns the transposed view, rows and columns swapped without moving data
+         */
+        this_type transposed() const noexcept {
+            return this_type(m_pData, m_szCols, m_szRows, m_iColStride, m_iRowStride);
+        }
+
+    protected:
+        element_type* m_pData;
+        size_type m_szRows;
+        size_type m_szCols;
+        difference_type m_iRowStride;
+        difference_type m_iColStride;
+    };
+
+    /**
+     * @brief Copies the elements of `src` into `dst`
+     *
+     * Contiguous vectors are copied with `memmove`, strided ones through the gather
+     * kernel of `TTECH`.
+     *
+     * @throw std::invalid_argument if the sizes differ
+     */
+    template <typename TSRC, typename TINT, techn_t TTECH>
+    void view_copy(const adaptive_vector_view<TSRC, TTECH>& src, const adaptive_vector_view<TINT, TTECH>& dst) {
+        static_assert(std::is_same<typename std::remove_cv<TSRC>::type, TINT>::value, "view_copy: element types differ");
+        if(src.size() != dst.size()) throw std::invalid_argument("view_copy: size mismatch");
+        internal::strided_kernel<TINT, TTECH>::copy(src.data(), src.stride(), dst.data(), dst.stride(), src.size());
+    }
+
+    /**
+     * @brief Copies the elements of `src` into `dst`, the views must not overlap
+     *
+     * - rows contiguous on both sides: one `memcpy` per row, or one for the whole block
+     * - columns contiguous on both sides: the same on the transposed views
+     * - one side column-major (`row_stride() == 1`), the other with contiguous rows: the
+     *   cache-oblivious transpose kernel
+     * - otherwise: the gather kernel of `TTECH` row by row
+     *
+     * @throw std::invalid_argument if the shapes differ
+     */
+    template <typename TSRC, typename TINT, techn_t TTECH>
+    void view_copy(const adaptive_matrix_view<TSRC, TTECH>& src, const adaptive_matrix_view<TINT, TTECH>& dst) {
+        static_assert(std::is_same<typename std::remove_cv<TSRC>::type, TINT>::value, "view_copy: element types differ");
+        if(src.rows() != dst.rows() || src.cols() != dst.cols()) throw std::invalid_argument("view_copy: shape mismatch");
+        if(src.size() == 0) return;
+
+        if(src.is_contiguous() && dst.is_contiguous()) {
+            std::memmove(dst.data(), src.data(), src.size() * sizeof(TINT));
+        } else if(src.has_contiguous_rows() && dst.has_contiguous_rows()) {
+            for(size_t r = 0; r < src.rows(); ++r)
+                std::memmove(&dst(r, 0), &src(r, 0), src.cols() * sizeof(TINT));
+        } else if(src.row_stride() == 1 && dst.row_stride() == 1) {
+            view_copy(src.transposed(), dst.transposed());
+        } else if(src.row_stride() == 1 && src.col_stride() > 0 && dst.has_contiguous_rows() && dst.row_stride() > 0) {
+            internal::transpose_recursive<internal::transpose_kernel<TINT, TTECH> >(
+                src.data(), size_t(src.col_stride()), dst.data(), size_t(dst.row_stride()), src.cols(), src.rows());
+        } else if(dst.row_stride() == 1 && dst.col_stride() > 0 && src.has_contiguous_rows() && src.row_stride() > 0) {
+            internal::transpose_recursive<internal::transpose_kernel<TINT, TTECH> >(
+                src.data(), size_t(src.row_stride()), dst.data(), size_t(dst.col_stride()), src.rows(), src.cols());
+        } else {
+            for(size_t r = 0; r < src.rows(); ++r)
+                internal::strided_kernel<TINT, TTECH>::copy(&src(r, 0), src.col_stride(), &dst(r, 0), dst.col_stride(), src.cols());
+        }
+    }
+}
+
+#endif
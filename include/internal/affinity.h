@@ -0,0 +1,220 @@
+/**
+ * @file affinity.h
+ * @brief Header file for the CPU topology and pinning helpers of the thread pool.
+ *
+ * This file reads the CPUs the process may run on (`sched_getaffinity`, so `taskset`
+ * and cgroup limits are respected) and their core and package from sysfs, orders them
+ * for a `thread_placement` and pins threads with `pthread_setaffinity_np`. On other
+ * systems than Linux no CPU is known and nothing is pinned.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_AFFINITY_H
+#define ADAPTIVE_AFFINITY_H
+
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#if defined(CPU_SET) && defined(CPU_SETSIZE)
+#define ADAPTIVE_HAS_AFFINITY 1
+#endif
+#endif
+
+namespace adaptive {
+    /**
+     * @brief How the threads of a pool are spread over the CPUs
+     */
+    enum class thread_placement {
+        /**
+         * @brief Not pinned, the scheduler may move the threads
+         */
+        none,
+        /**
+         * @brief Neighbouring threads on the CPUs of one core and package, they share the caches
+         */
+        compact,
+        /**
+         * @brief Neighbouring threads on different packages and cores, for memory bandwidth
+         */
+        scatter
+    };
+
+    /**
+     * @brief The CPU placement of a `thread_pool`
+     */
+    struct thread_affinity {
+        /**
+         * @brief The order of the CPUs
+         */
+        thread_placement placement = thread_placement::none;
+        /**
+         * @brief The CPUs to use, empty for all the process may run on
+         */
+        std::vector<int> cpus;
+        /**
+         * @brief Places threads on the second hardware thread of a core only once every core has one
+         */
+        bool avoid_smt = false;
+    };
+
+namespace internal {
+    /**
+     * @brief A CPU the process may run on
+     */
+    struct cpu_info {
+        int cpu;
+        int core;
+        int package;
+        int smt;        // 0 for the first CPU of its core, 1 for its first sibling, ...
+    };
+
+    /**
+     * @brief The CPUs of the process, read once
+     */
+    struct cpu_topology {
+        std::vector<cpu_info> cpus;
+
+        static const cpu_topology& get() {
+            static const cpu_topology _topology = detect();
+            return _topology;
+        }
+
+        const cpu_info* find(int cpu) const noexcept {
+            for(const auto& c : cpus) if(c.cpu == cpu) return &c;
+            return nullptr;
+        }
+
+    private:
+        static int read_id(int cpu, const char* name, int fallback) {
+            char _path[128];
+            std::snprintf(_path, sizeof(_path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+            std::FILE* f = std::fopen(_path, "r");
+            if(f == nullptr) return fallback;
+            int _result = fallback;
+            if(std::fscanf(f, "%d", &_result) != 1) _result = fallback;
+            std::fclose(f);
+            return _result;
+        }
+
+        static cpu_topology detect() {
+            cpu_topology _result;
+#ifdef ADAPTIVE_HAS_AFFINITY
+            cpu_set_t _set;
+            CPU_ZERO(&_set);
+            if(sched_getaffinity(0, sizeof(_set), &_set) != 0) return _result;
+            for(int c = 0; c < CPU_SETSIZE; ++c) {
+                if(!CPU_ISSET(c, &_set)) continue;
+                _result.cpus.push_back(cpu_info{ c, read_id(c, "core_id", c), read_id(c, "physical_package_id", 0), 0 });
+            }
+            // The CPUs are in ascending order, so the first of each core gets rank 0.
+            for(size_t i = 0; i < _result.cpus.size(); ++i)
+                for(size_t j = 0; j < i; ++j)
+                    if(_result.cpus[j].core == _result.cpus[i].core && _result.cpus[j].package == _result.cpus[i].package)
+                        ++_result.cpus[i].smt;
+#endif
+            return _result;
+        }
+    };
+
+    /**
+     * @brief Get the CPU of every thread of a pool of `threads` threads, -1 where it is not pinned
+     *
+     * The CPUs are ordered for the placement and dealt to the threads in turn; with more
+     * threads than CPUs the order repeats.
+     *
+     * @throw std::invalid_argument if `affinity.cpus` names a CPU the process may not run on
+     */
+    inline std::vector<int> plan_placement(const thread_affinity& affinity, size_t threads) {
+        std::vector<int> _result(threads, -1);
+        if(affinity.placement == thread_placement::none && affinity.cpus.empty()) return _result;
+
+        const cpu_topology& topology = cpu_topology::get();
+        if(topology.cpus.empty()) return _result;
+        std::vector<cpu_info> _cpus;
+        if(affinity.cpus.empty()) {
+            _cpus = topology.cpus;
+        } else {
+            for(int c : affinity.cpus) {
+                const cpu_info* info = topology.find(c);
+                if(info == nullptr) throw std::invalid_argument("thread_pool: CPU " + std::to_string(c) + " is not available");
+                if(std::none_of(_cpus.begin(), _cpus.end(), [c](const cpu_info& i) { return i.cpu == c; })) _cpus.push_back(*info);
+            }
+        }
+
+        // Ranks of the cores within their package, for scatter.
+        std::vector<int> _rank(_cpus.size(), 0);
+        for(size_t i = 0; i < _cpus.size(); ++i)
+            for(size_t j = 0; j < _cpus.size(); ++j)
+                if(_cpus[j].package == _cpus[i].package && _cpus[j].smt == 0 && _cpus[j].core < _cpus[i].core) ++_rank[i];
+
+        std::vector<size_t> _order(_cpus.size());
+        for(size_t i = 0; i < _order.size(); ++i) _order[i] = i;
+        const bool smt_last = affinity.avoid_smt || affinity.placement == thread_placement::scatter;
+        std::stable_sort(_order.begin(), _order.end(), [&](size_t x, size_t y) {
+            const cpu_info& a = _cpus[x];
+            const cpu_info& b = _cpus[y];
+            if(smt_last && a.smt != b.smt) return a.smt < b.smt;
+            if(affinity.placement == thread_placement::scatter) {
+                if(_rank[x] != _rank[y]) return _rank[x] < _rank[y];
+                return a.package < b.package;
+            }
+            if(affinity.placement == thread_placement::compact) {
+                if(a.package != b.package) return a.package < b.package;
+                if(a.core != b.core) return a.core < b.core;
+                return a.smt < b.smt;
+            }
+            return false;
+        });
+        for(size_t t = 0; t < threads; ++t) _result[t] = _cpus[_order[t % _order.size()]].cpu;
+        return _result;
+    }
+
+    /**
+     * @brief Pins `thread` to `cpu`
+     *
+     * @return False if the thread could not be pinned or `cpu` is -1
+     */
+    inline bool pin_thread(std::thread& thread, int cpu) noexcept {
+#ifdef ADAPTIVE_HAS_AFFINITY
+        if(cpu < 0 || cpu >= CPU_SETSIZE) return false;
+        cpu_set_t _set;
+        CPU_ZERO(&_set);
+        CPU_SET(cpu, &_set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(_set), &_set) == 0;
+#else
+        (void)thread; (void)cpu;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Pins the calling thread to `cpu`
+     */
+    inline bool pin_current_thread(int cpu) noexcept {
+#ifdef ADAPTIVE_HAS_AFFINITY
+        if(cpu < 0 || cpu >= CPU_SETSIZE) return false;
+        cpu_set_t _set;
+        CPU_ZERO(&_set);
+        CPU_SET(cpu, &_set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(_set), &_set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+}
+}
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file aligned_allocator.h
+ * @brief Header file for the `aligned_allocator` class.
+ *
+ * This file defines the `aligned_allocator` class, a standard conforming allocator
+ * that returns storage aligned to a cache line. It is used by the adaptive container
+ * types so that SIMD kernels can rely on aligned rows and never split a cache line
+ * on the first element.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_ALIGNED_ALLOCATOR_H
+#define ADAPTIVE_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+#ifndef ADAPTIVE_DEFAULT_ALIGNMENT
+#define ADAPTIVE_DEFAULT_ALIGNMENT 64
+#endif
+
+namespace adaptive {
+    /**
+     * @class aligned_allocator
+     * @brief A allocator that returns storage aligned to `TALIGN` bytes.
+     *
+     * @tparam T The element type to allocate.
+     * @tparam TALIGN The alignment in bytes, defaults to `ADAPTIVE_DEFAULT_ALIGNMENT`.
+     */
+    template <typename T, size_t TALIGN = ADAPTIVE_DEFAULT_ALIGNMENT>
+    class aligned_allocator {
+    public:
+        using this_type = aligned_allocator<T, TALIGN>;
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        template <typename U>
+        struct rebind { using other = aligned_allocator<U, TALIGN>; };
+
+        aligned_allocator() noexcept = default;
+
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, TALIGN>&) noexcept { }
+
+        /**
+         * @brief Allocates aligned storage for `n` elements of type `T`.
+         *
+         * @param n The number of elements.
+         * @return Pointer to the first element of the aligned storage.
+         */
+        value_type* allocate(size_type n) {
+            return static_cast<value_type*>(::operator new(n * sizeof(value_type), std::align_val_t(TALIGN)));
+        }
+        /**
+         * @brief Releases storage that was obtained with `allocate`.
+         *
+         * @param p Pointer returned by `allocate`.
+         * @param n The number of elements passed to `allocate`.
+         */
+        void deallocate(value_type* p, size_type n) noexcept {
+            (void)n;
+            ::operator delete(p, std::align_val_t(TALIGN));
+        }
+
+        template <typename U>
+        bool operator == (const aligned_allocator<U, TALIGN>&) const noexcept { return true; }
+        template <typename U>
+        bool operator != (const aligned_allocator<U, TALIGN>&) const noexcept { return false; }
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file cpu_features.h
+ * @brief Header file for runtime CPU feature detection.
+ *
+ * The techniques are chosen at compile time from the `-m` flags. A few instructions
+ * (VNNI, ...) are too new to require them in the build flags, this file lets kernels
+ * probe for them once at runtime and take a faster path when they are present.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_CPU_FEATURES_H
+#define ADAPTIVE_CPU_FEATURES_H
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ADAPTIVE_HAS_CPU_DETECTION 1
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class cpu_features
+     * @brief Runtime detected instruction set extensions of the executing CPU.
+     */
+    struct cpu_features {
+        bool avx512vnni = false;
+        bool avxvnni = false;
+
+        /**
+         * @brief Get the features of the executing CPU, detected on first use.
+         */
+        static const cpu_features& get() {
+            static const cpu_features _features = detect();
+            return _features;
+        }
+
+    private:
+        static cpu_features detect() {
+            cpu_features _result;
+#ifdef ADAPTIVE_HAS_CPU_DETECTION
+            __builtin_cpu_init();
+            _result.avx512vnni = __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512vl");
+            _result.avxvnni = __builtin_cpu_supports("avxvnni");
+#endif
+            return _result;
+        }
+    };
+}
+}
+
+#endif
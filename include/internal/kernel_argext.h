@@ -0,0 +1,236 @@
+/**
+ * @file kernel_argext.h
+ * @brief Header file for the argmin / argmax kernels.
+ *
+ * This file defines `argext_kernel`, which finds the index of the first smallest or
+ * largest element of an integer array. The SIMD kernels keep, per lane, the best value
+ * seen so far and the step it was seen in, update both with a compare and a blend, and
+ * reduce the lanes at the end, so there is no branch per element. A lane only takes a
+ * strictly better value and lanes of equal value go to the smaller index, which makes
+ * the result the first occurrence.
+ *
+ * The step counters have the width of the elements, 8-bit and 16-bit arrays are
+ * processed in blocks of at most 255 or 65535 steps and the blocks merged in order.
+ * Unsigned elements are compared with the sign bit flipped.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_ARGEXT_H
+#define ADAPTIVE_KERNEL_ARGEXT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief `a` is strictly better than `b`, larger for argmax and smaller for argmin
+     */
+    template <bool TMAX, typename TINT>
+    inline bool argext_better(TINT a, TINT b) noexcept {
+        return TMAX ? (a > b) : (a < b);
+    }
+
+    /**
+     * @brief SSE handles 64-bit lanes only with the SSE4.2 `pcmpgtq`
+     */
+    template <typename TINT>
+    constexpr bool argext_sse_width() {
+#ifdef __SSE4_2__
+        return std::is_integral<TINT>::value;
+#else
+        return std::is_integral<TINT>::value && sizeof(TINT) < 8;
+#endif
+    }
+
+    /**
+     * @class argext_ops
+     * @brief Register operations of the argmin / argmax kernels, only the SIMD techniques.
+     *
+     * `load` returns the elements with the sign bit flipped for unsigned types, so that
+     * the signed `cmpgt` orders them.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct argext_ops;
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct argext_ops<TINT, techn_type::SSE, typename std::enable_if<argext_sse_width<TINT>()>::type> {
+        using reg = __m128i;
+        using step_type = typename std::make_unsigned<TINT>::type;
+        static constexpr size_t lanes = 16 / sizeof(TINT);
+
+        static reg set1(step_type v) {
+            if constexpr (sizeof(TINT) == 1) return _mm_set1_epi8(char(v));
+            else if constexpr (sizeof(TINT) == 2) return _mm_set1_epi16(short(v));
+            else if constexpr (sizeof(TINT) == 4) return _mm_set1_epi32(int(v));
+            else return _mm_set1_epi64x(int64_t(v));
+        }
+        static reg load(const TINT* p) {
+            const reg v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            if constexpr (std::is_signed<TINT>::value) return v;
+            else return _mm_xor_si128(v, set1(step_type(std::numeric_limits<typename std::make_signed<TINT>::type>::min())));
+        }
+        static void store(step_type* p, reg v)  { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg zero()                       { return _mm_setzero_si128(); }
+        static reg blend(reg a, reg b, reg m)   { return _mm_blendv_epi8(a, b, m); }
+        static reg cmpgt(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 1) return _mm_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_cmpgt_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_cmpgt_epi32(a, b);
+            else return _mm_cmpgt_epi64(a, b);
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct argext_ops<TINT, techn_type::AVX, typename std::enable_if<std::is_integral<TINT>::value>::type> {
+        using reg = __m256i;
+        using step_type = typename std::make_unsigned<TINT>::type;
+        static constexpr size_t lanes = 32 / sizeof(TINT);
+
+        static reg set1(step_type v) {
+            if constexpr (sizeof(TINT) == 1) return _mm256_set1_epi8(char(v));
+            else if constexpr (sizeof(TINT) == 2) return _mm256_set1_epi16(short(v));
+            else if constexpr (sizeof(TINT) == 4) return _mm256_set1_epi32(int(v));
+            else return _mm256_set1_epi64x(int64_t(v));
+        }
+        static reg load(const TINT* p) {
+            const reg v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            if constexpr (std::is_signed<TINT>::value) return v;
+            else return _mm256_xor_si256(v, set1(step_type(std::numeric_limits<typename std::make_signed<TINT>::type>::min())));
+        }
+        static void store(step_type* p, reg v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg zero()                       { return _mm256_setzero_si256(); }
+        static reg blend(reg a, reg b, reg m)   { return _mm256_blendv_epi8(a, b, m); }
+        static reg cmpgt(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 1) return _mm256_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm256_cmpgt_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_cmpgt_epi32(a, b);
+            else return _mm256_cmpgt_epi64(a, b);
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct argext_ops<TINT, techn_type::AVX512, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : argext_ops<TINT, techn_type::AVX> { };
+#endif
+
+    /**
+     * @class argext_kernel
+     * @brief argmin / argmax, a scalar loop for the scalar technique.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct argext_kernel {
+        /**
+         * @brief Index of the first best element of `p[0, n)`, `n` must not be 0
+         */
+        template <bool TMAX>
+        static size_t find(const TINT* p, size_t n) noexcept {
+            return find_from<TMAX>(p, 1, n, 0);
+        }
+
+        /**
+         * @brief Index of the first best element of `p[i, n)` and `p[best]`
+         */
+        template <bool TMAX>
+        static size_t find_from(const TINT* p, size_t i, size_t n, size_t best) noexcept {
+            TINT _value = p[best];
+            for(; i < n; ++i) {
+                const bool b = argext_better<TMAX>(p[i], _value);
+                _value = b ? p[i] : _value;
+                best = b ? i : best;
+            }
+            return best;
+        }
+    };
+
+    /**
+     * @brief argmin / argmax with two accumulators of `TOPS::lanes` values and step counters
+     */
+    template <typename TINT, typename TOPS>
+    struct argext_kernel_simd {
+        using reg = typename TOPS::reg;
+        using step_type = typename TOPS::step_type;
+        static constexpr size_t lanes = TOPS::lanes;
+        static constexpr size_t step = 2 * lanes;
+        static constexpr size_t max_steps = sizeof(TINT) >= 4 ? (size_t(1) << 30) : size_t(std::numeric_limits<step_type>::max());
+
+        template <bool TMAX>
+        static size_t find(const TINT* p, size_t n) noexcept {
+            size_t best = 0, i = 0;
+            bool found = false;
+            while(n - i >= step) {
+                const size_t steps = std::min((n - i) / step, max_steps);
+                const TINT* q = p + i;
+                reg b0 = TOPS::load(q), b1 = TOPS::load(q + lanes);
+                reg k0 = TOPS::zero(), k1 = TOPS::zero();
+                for(size_t k = 1; k < steps; ++k) {
+                    const reg kk = TOPS::set1(step_type(k));
+                    const reg v0 = TOPS::load(q + k * step), v1 = TOPS::load(q + k * step + lanes);
+                    const reg m0 = TMAX ? TOPS::cmpgt(v0, b0) : TOPS::cmpgt(b0, v0);
+                    const reg m1 = TMAX ? TOPS::cmpgt(v1, b1) : TOPS::cmpgt(b1, v1);
+                    b0 = TOPS::blend(b0, v0, m0);
+                    b1 = TOPS::blend(b1, v1, m1);
+                    k0 = TOPS::blend(k0, kk, m0);
+                    k1 = TOPS::blend(k1, kk, m1);
+                }
+
+                // Candidates of the lanes, in any order: equal values go to the smaller index.
+                step_type _steps[step];
+                TOPS::store(_steps, k0);
+                TOPS::store(_steps + lanes, k1);
+                size_t _block = i + size_t(_steps[0]) * step;
+                for(size_t l = 1; l < step; ++l) {
+                    const size_t c = i + size_t(_steps[l]) * step + l;
+                    if(argext_better<TMAX>(p[c], p[_block]) || (p[c] == p[_block] && c < _block)) _block = c;
+                }
+                if(!found || argext_better<TMAX>(p[_block], p[best])) best = _block;
+                found = true;
+                i += steps * step;
+            }
+            if(!found) return argext_kernel<TINT, techn_type::Scalar>::template find<TMAX>(p, n);
+            return argext_kernel<TINT, techn_type::Scalar>::template find_from<TMAX>(p, i, n, best);
+        }
+    };
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct argext_kernel<TINT, techn_type::SSE, typename std::enable_if<argext_sse_width<TINT>()>::type>
+        : argext_kernel_simd<TINT, argext_ops<TINT, techn_type::SSE>> { };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct argext_kernel<TINT, techn_type::AVX, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : argext_kernel_simd<TINT, argext_ops<TINT, techn_type::AVX>> { };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct argext_kernel<TINT, techn_type::AVX512, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : argext_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
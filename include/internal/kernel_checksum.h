@@ -0,0 +1,411 @@
+/**
+ * @file kernel_checksum.h
+ * @brief Header file for the buffer checksum kernels, CRC32C, Adler-32 and Fletcher-32.
+ *
+ * This file defines `checksum_kernel`, which checksums a byte buffer:
+ *  - CRC32C with SSE4.2 runs three independent `crc32` streams over three blocks, which
+ *    hides the 3-cycle latency of the instruction, and merges them with table lookups
+ *    that multiply by x^(8*block) mod P. With AVX and PCLMULQDQ, buffers of at least
+ *    `ADAPTIVE_CRC32C_FOLD_MIN` bytes are folded 64 bytes at a time with carry-less
+ *    multiplies and only the last 16 bytes go through `crc32`.
+ *  - Adler-32 sums 16 or 32 bytes per step with `psadbw` and the position weighted
+ *    sum with `pmaddubsw`, reduced modulo 65521 once per 5552 bytes.
+ *  - Fletcher-32 sums little-endian 16-bit words widened to 32-bit lanes, reduced
+ *    modulo 65535 once per 256 steps.
+ *
+ * All CRC values here are the raw register, without the initial and final inversion.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_CHECKSUM_H
+#define ADAPTIVE_KERNEL_CHECKSUM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <adaptive_techniq.h>
+#include "kernel_crc.h"
+#include "simd_util.h"
+
+#if defined(__PCLMUL__) && defined(__SSE4_2__)
+#include "wmmintrin.h"
+#endif
+
+#ifndef ADAPTIVE_CRC32C_FOLD_MIN
+/**
+ * @brief Smallest buffer that takes the PCLMULQDQ folding path of CRC32C
+ *
+ * The fold loads its first 64 bytes unconditionally, smaller values count as 64.
+ */
+#define ADAPTIVE_CRC32C_FOLD_MIN 1024
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Bytes per stream of the long and the short three-stream CRC32C blocks.
+     */
+    constexpr size_t crc32c_long = 8192;
+    constexpr size_t crc32c_short = 256;
+    /**
+     * @brief Largest run of bytes whose Adler-32 sums fit 32 bits before the modulo.
+     */
+    constexpr size_t adler32_nmax = 5552;
+    constexpr uint32_t adler32_base = 65521;
+
+    /**
+     * @brief `p * x mod P`, bit 31 is the coefficient of x^0.
+     */
+    constexpr uint32_t crc32c_mulx(uint32_t p) noexcept {
+        return (p >> 1) ^ (crc32c_poly & (0u - (p & 1u)));
+    }
+    /**
+     * @brief `x^n mod P`.
+     */
+    constexpr uint32_t crc32c_xpow(size_t n) noexcept {
+        uint32_t p = 0x80000000u;
+        for(; n != 0; --n) p = crc32c_mulx(p);
+        return p;
+    }
+    /**
+     * @brief `a * b mod P`.
+     */
+    constexpr uint32_t crc32c_multmodp(uint32_t a, uint32_t b) noexcept {
+        uint32_t p = 0;
+        for(uint32_t m = 0x80000000u; m != 0; m >>= 1, b = crc32c_mulx(b)) {
+            if(a & m) p ^= b;
+        }
+        return p;
+    }
+
+    /**
+     * @brief Byte tables of `crc * x^(8 * bytes) mod P`, the CRC register moved past `bytes` zero bytes.
+     */
+    struct crc32c_shift_table {
+        uint32_t m_uValues[4][256];
+
+        constexpr explicit crc32c_shift_table(size_t bytes) : m_uValues() {
+            const uint32_t k = crc32c_xpow(8 * bytes);
+            for(int b = 0; b < 4; ++b) {
+                for(uint32_t v = 0; v < 256; ++v) m_uValues[b][v] = crc32c_multmodp(k, v << (8 * b));
+            }
+        }
+        uint32_t shift(uint32_t crc) const noexcept {
+            return m_uValues[0][crc & 0xFFu] ^ m_uValues[1][(crc >> 8) & 0xFFu] ^
+                   m_uValues[2][(crc >> 16) & 0xFFu] ^ m_uValues[3][crc >> 24];
+        }
+    };
+    inline constexpr crc32c_shift_table s_crc32cLongShift{ crc32c_long };
+    inline constexpr crc32c_shift_table s_crc32cShortShift{ crc32c_short };
+
+    inline uint64_t checksum_load64(const unsigned char* p) noexcept {
+        uint64_t _result;
+        std::memcpy(&_result, p, sizeof(_result));
+        return _result;
+    }
+
+    /**
+     * @brief CRC32C of one stream, eight bytes per `crc32`.
+     */
+    inline uint32_t crc32c_serial(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+        for(; n >= 8; p += 8, n -= 8) crc = crc32c_u64(crc, checksum_load64(p));
+        for(; n != 0; ++p, --n) crc = crc32c_u8(crc, *p);
+        return crc;
+    }
+    /**
+     * @brief CRC32C of runs of three `block` byte blocks, interleaving one stream per block.
+     */
+    inline uint32_t crc32c_3way(uint32_t crc, const unsigned char*& p, size_t& n, size_t block,
+                                const crc32c_shift_table& shift) noexcept {
+        for(; n >= 3 * block; p += 3 * block, n -= 3 * block) {
+            uint32_t c0 = crc, c1 = 0, c2 = 0;
+            for(size_t i = 0; i < block; i += 8) {
+                c0 = crc32c_u64(c0, checksum_load64(p + i));
+                c1 = crc32c_u64(c1, checksum_load64(p + block + i));
+                c2 = crc32c_u64(c2, checksum_load64(p + 2 * block + i));
+            }
+            crc = shift.shift(shift.shift(c0) ^ c1) ^ c2;
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Adler-32 of the bytes, one byte at a time.
+     */
+    inline uint32_t adler32_scalar(uint32_t adler, const unsigned char* p, size_t n) noexcept {
+        uint32_t s1 = adler & 0xFFFFu, s2 = adler >> 16;
+        while(n != 0) {
+            const size_t m = std::min(n, adler32_nmax);
+            for(size_t i = 0; i < m; ++i) {
+                s1 += p[i];
+                s2 += s1;
+            }
+            s1 %= adler32_base;
+            s2 %= adler32_base;
+            p += m;
+            n -= m;
+        }
+        return (s2 << 16) | s1;
+    }
+    /**
+     * @brief Fletcher-32 of the little-endian 16-bit words, an odd last byte is padded with 0.
+     */
+    inline uint32_t fletcher32_scalar(uint32_t fletcher, const unsigned char* p, size_t n) noexcept {
+        uint64_t s1 = fletcher & 0xFFFFu, s2 = fletcher >> 16;
+        for(size_t i = 0; i + 1 < n; i += 2) {
+            s1 += uint32_t(p[i]) | (uint32_t(p[i + 1]) << 8);
+            s2 += s1;
+            if((i & 0x1FFEu) == 0x1FFEu) {
+                s1 %= 0xFFFFu;
+                s2 %= 0xFFFFu;
+            }
+        }
+        if(n & 1) {
+            s1 += p[n - 1];
+            s2 += s1;
+        }
+        return uint32_t(s2 % 0xFFFFu) << 16 | uint32_t(s1 % 0xFFFFu);
+    }
+
+    /**
+     * @class checksum_ops
+     * @brief Register operations of the SIMD Adler-32 and Fletcher-32 kernels.
+     *
+     * `sad` sums groups of eight bytes into the low 32 bits of 64-bit lanes, `weighted`
+     * sums `(bytes - i) * p[i]` into 32-bit lanes and `widen` loads `words` 16-bit words
+     * into two registers of 32-bit lanes, the first half into `lo`.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct checksum_ops;
+
+#ifdef __SSE4_1__
+    template <>
+    struct checksum_ops<techn_type::SSE> {
+        using reg = __m128i;
+        static constexpr size_t bytes = 16, words = 8;
+
+        static reg zero()                   { return _mm_setzero_si128(); }
+        static reg load(const unsigned char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static reg add(reg a, reg b)        { return _mm_add_epi32(a, b); }
+        static reg mullo(reg a, reg b)      { return _mm_mullo_epi32(a, b); }
+        static reg sad(reg v)               { return _mm_sad_epu8(v, _mm_setzero_si128()); }
+        static reg weighted(reg v) {
+            const reg w = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+            return _mm_madd_epi16(_mm_maddubs_epi16(v, w), _mm_set1_epi16(1));
+        }
+        static void widen(const unsigned char* p, reg& lo, reg& hi) {
+            lo = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+            hi = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 8)));
+        }
+        static reg index_lo()               { return _mm_setr_epi32(0, 1, 2, 3); }
+        static reg index_hi()               { return _mm_setr_epi32(4, 5, 6, 7); }
+        static uint64_t hsum(reg v) {
+            alignas(16) uint32_t _lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(_lanes), v);
+            return uint64_t(_lanes[0]) + _lanes[1] + _lanes[2] + _lanes[3];
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <>
+    struct checksum_ops<techn_type::AVX> {
+        using reg = __m256i;
+        static constexpr size_t bytes = 32, words = 16;
+
+        static reg zero()                   { return _mm256_setzero_si256(); }
+        static reg load(const unsigned char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static reg add(reg a, reg b)        { return _mm256_add_epi32(a, b); }
+        static reg mullo(reg a, reg b)      { return _mm256_mullo_epi32(a, b); }
+        static reg sad(reg v)               { return _mm256_sad_epu8(v, _mm256_setzero_si256()); }
+        static reg weighted(reg v) {
+            const reg w = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+            return _mm256_madd_epi16(_mm256_maddubs_epi16(v, w), _mm256_set1_epi16(1));
+        }
+        static void widen(const unsigned char* p, reg& lo, reg& hi) {
+            lo = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            hi = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+        }
+        static reg index_lo()               { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+        static reg index_hi()               { return _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15); }
+        static uint64_t hsum(reg v) {
+            alignas(32) uint32_t _lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(_lanes), v);
+            uint64_t _result = 0;
+            for(uint32_t l : _lanes) _result += l;
+            return _result;
+        }
+    };
+#endif
+
+    /**
+     * @brief Adler-32 written once over `checksum_ops`, the tail is scalar.
+     *
+     * Per step `vs1` gets the byte sums and `vp` the `vs1` of before the step, so a byte
+     * at offset `i` of step `k` of `K` adds `bytes * (K - 1 - k) + (bytes - i)` times to `s2`.
+     */
+    template <typename TOPS>
+    uint32_t adler32_simd(uint32_t adler, const unsigned char* p, size_t n) noexcept {
+        using reg = typename TOPS::reg;
+        uint32_t s1 = adler & 0xFFFFu, s2 = adler >> 16;
+        while(n >= TOPS::bytes) {
+            const size_t steps = std::min(n, adler32_nmax) / TOPS::bytes;
+            reg vs1 = TOPS::zero(), vp = TOPS::zero(), vs2 = TOPS::zero();
+            for(size_t k = 0; k < steps; ++k, p += TOPS::bytes) {
+                const reg v = TOPS::load(p);
+                vp = TOPS::add(vp, vs1);
+                vs1 = TOPS::add(vs1, TOPS::sad(v));
+                vs2 = TOPS::add(vs2, TOPS::weighted(v));
+            }
+            n -= steps * TOPS::bytes;
+            s2 = uint32_t((s2 + uint64_t(s1) * steps * TOPS::bytes + TOPS::bytes * TOPS::hsum(vp) + TOPS::hsum(vs2)) % adler32_base);
+            s1 = uint32_t((s1 + TOPS::hsum(vs1)) % adler32_base);
+        }
+        return adler32_scalar((s2 << 16) | s1, p, n);
+    }
+    /**
+     * @brief Fletcher-32 written once over `checksum_ops`, the tail is scalar.
+     *
+     * Lane `j` sums the words at offset `j` of every step into `vs1` and the running
+     * `vs1` into `vs2`, so `s2 = words * sum(vs2) - sum(j * vs1_j)`. 256 steps keep
+     * `vs2` below 2^32.
+     */
+    template <typename TOPS>
+    uint32_t fletcher32_simd(uint32_t fletcher, const unsigned char* p, size_t n) noexcept {
+        using reg = typename TOPS::reg;
+        constexpr size_t step_bytes = 2 * TOPS::words;
+        uint64_t s1 = fletcher & 0xFFFFu, s2 = fletcher >> 16;
+        while(n >= step_bytes) {
+            const size_t steps = std::min<size_t>(n / step_bytes, 256);
+            reg a_lo = TOPS::zero(), a_hi = TOPS::zero(), b_lo = TOPS::zero(), b_hi = TOPS::zero();
+            for(size_t k = 0; k < steps; ++k, p += step_bytes) {
+                reg lo, hi;
+                TOPS::widen(p, lo, hi);
+                a_lo = TOPS::add(a_lo, lo);
+                a_hi = TOPS::add(a_hi, hi);
+                b_lo = TOPS::add(b_lo, a_lo);
+                b_hi = TOPS::add(b_hi, a_hi);
+            }
+            n -= steps * step_bytes;
+            const uint64_t a = TOPS::hsum(a_lo) + TOPS::hsum(a_hi);
+            const uint64_t b = TOPS::hsum(b_lo) + TOPS::hsum(b_hi);
+            const uint64_t ja = TOPS::hsum(TOPS::mullo(a_lo, TOPS::index_lo())) + TOPS::hsum(TOPS::mullo(a_hi, TOPS::index_hi()));
+            s2 = (s2 + s1 * (steps * TOPS::words) + TOPS::words * b - ja) % 0xFFFFu;
+            s1 = (s1 + a) % 0xFFFFu;
+        }
+        return fletcher32_scalar(uint32_t(s2 << 16 | s1), p, n);
+    }
+
+    /**
+     * @class checksum_kernel
+     * @brief The buffer checksums, one stream of `crc32` and scalar sums for the scalar technique.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct checksum_kernel {
+        static uint32_t crc32c(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+            return crc32c_serial(crc, p, n);
+        }
+        static uint32_t adler32(uint32_t adler, const unsigned char* p, size_t n) noexcept {
+            return adler32_scalar(adler, p, n);
+        }
+        static uint32_t fletcher32(uint32_t fletcher, const unsigned char* p, size_t n) noexcept {
+            return fletcher32_scalar(fletcher, p, n);
+        }
+    };
+
+#ifdef __SSE4_2__
+    template <>
+    struct checksum_kernel<techn_type::SSE> {
+        static uint32_t crc32c(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+            crc = crc32c_3way(crc, p, n, crc32c_long, s_crc32cLongShift);
+            crc = crc32c_3way(crc, p, n, crc32c_short, s_crc32cShortShift);
+            return crc32c_serial(crc, p, n);
+        }
+        static uint32_t adler32(uint32_t adler, const unsigned char* p, size_t n) noexcept {
+            return adler32_simd<checksum_ops<techn_type::SSE>>(adler, p, n);
+        }
+        static uint32_t fletcher32(uint32_t fletcher, const unsigned char* p, size_t n) noexcept {
+            return fletcher32_simd<checksum_ops<techn_type::SSE>>(fletcher, p, n);
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <>
+    struct checksum_kernel<techn_type::AVX> {
+        static uint32_t crc32c(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+#ifdef __PCLMUL__
+            if(n >= fold_min) crc = fold(crc, p, n);
+#endif
+            return checksum_kernel<techn_type::SSE>::crc32c(crc, p, n);
+        }
+        static uint32_t adler32(uint32_t adler, const unsigned char* p, size_t n) noexcept {
+            return adler32_simd<checksum_ops<techn_type::AVX>>(adler, p, n);
+        }
+        static uint32_t fletcher32(uint32_t fletcher, const unsigned char* p, size_t n) noexcept {
+            return fletcher32_simd<checksum_ops<techn_type::AVX>>(fletcher, p, n);
+        }
+
+    protected:
+#ifdef __PCLMUL__
+        static constexpr size_t fold_min = ADAPTIVE_CRC32C_FOLD_MIN < 64 ? 64 : ADAPTIVE_CRC32C_FOLD_MIN;
+
+        /**
+         * @brief Moves `x` by `bits` with `k = { x^(bits + 31), x^(bits - 33) } mod P`
+         *
+         * The low quadword holds the higher powers in the reflected order, `pclmulqdq`
+         * of reflected operands adds one x^33 that the constants take back.
+         */
+        static __m128i fold_step(__m128i x, __m128i k) noexcept {
+            return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+        }
+        static __m128i fold_constants(size_t bits) noexcept {
+            return _mm_set_epi64x(int64_t(crc32c_xpow(bits - 33)), int64_t(crc32c_xpow(bits + 31)));
+        }
+        /**
+         * @brief CRC32C of the leading multiple of 16 bytes, four accumulators of 16 bytes
+         */
+        static uint32_t fold(uint32_t crc, const unsigned char*& p, size_t& n) noexcept {
+            static const __m128i k512 = fold_constants(512), k128 = fold_constants(128);
+            const __m128i* src = reinterpret_cast<const __m128i*>(p);
+            __m128i x0 = _mm_xor_si128(_mm_loadu_si128(src), _mm_cvtsi32_si128(int(crc)));
+            __m128i x1 = _mm_loadu_si128(src + 1), x2 = _mm_loadu_si128(src + 2), x3 = _mm_loadu_si128(src + 3);
+            size_t i = 4;
+            for(; (i + 4) * 16 <= n; i += 4) {
+                x0 = _mm_xor_si128(fold_step(x0, k512), _mm_loadu_si128(src + i));
+                x1 = _mm_xor_si128(fold_step(x1, k512), _mm_loadu_si128(src + i + 1));
+                x2 = _mm_xor_si128(fold_step(x2, k512), _mm_loadu_si128(src + i + 2));
+                x3 = _mm_xor_si128(fold_step(x3, k512), _mm_loadu_si128(src + i + 3));
+            }
+            x0 = _mm_xor_si128(fold_step(x0, k128), x1);
+            x0 = _mm_xor_si128(fold_step(x0, k128), x2);
+            x0 = _mm_xor_si128(fold_step(x0, k128), x3);
+            for(; (i + 1) * 16 <= n; ++i) x0 = _mm_xor_si128(fold_step(x0, k128), _mm_loadu_si128(src + i));
+            p += i * 16;
+            n -= i * 16;
+            crc = crc32c_u64(0, uint64_t(_mm_cvtsi128_si64(x0)));
+            return crc32c_u64(crc, uint64_t(_mm_extract_epi64(x0, 1)));
+        }
+#endif
+    };
+#endif
+
+#ifdef __AVX512__
+    template <>
+    struct checksum_kernel<techn_type::AVX512> : checksum_kernel<techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
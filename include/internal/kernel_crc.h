@@ -0,0 +1,84 @@
+/**
+ * @file kernel_crc.h
+ * @brief Header file for the CRC32C (Castagnoli) primitives.
+ *
+ * This file defines the CRC32C update of one 8, 32 or 64-bit word, with the SSE4.2
+ * `crc32` instruction when it is available and a byte-wise table otherwise. The CRC
+ * is the reflected one of iSCSI and ext4 (polynomial 0x1EDC6F41), without the initial
+ * and final inversion, which callers apply themselves.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_CRC_H
+#define ADAPTIVE_KERNEL_CRC_H
+
+#include <cstdint>
+#include <cstddef>
+
+#ifdef __SSE4_2__
+#include "nmmintrin.h"
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief The reflected CRC32C polynomial.
+     */
+    constexpr uint32_t crc32c_poly = 0x82F63B78u;
+
+    /**
+     * @brief Table of the CRC32C of every byte, for targets without SSE4.2.
+     */
+    struct crc32c_table {
+        uint32_t m_uValues[256];
+
+        constexpr crc32c_table() : m_uValues() {
+            for(uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for(int k = 0; k < 8; ++k) c = (c >> 1) ^ (crc32c_poly & (0u - (c & 1u)));
+                m_uValues[i] = c;
+            }
+        }
+    };
+    inline constexpr crc32c_table s_crc32cTable{};
+
+    /**
+     * @brief `crc` updated with the byte `v`.
+     */
+    inline uint32_t crc32c_u8(uint32_t crc, uint8_t v) noexcept {
+#ifdef __SSE4_2__
+        return _mm_crc32_u8(crc, v);
+#else
+        return (crc >> 8) ^ s_crc32cTable.m_uValues[(crc ^ v) & 0xFFu];
+#endif
+    }
+    /**
+     * @brief `crc` updated with the little-endian bytes of `v`.
+     */
+    inline uint32_t crc32c_u32(uint32_t crc, uint32_t v) noexcept {
+#ifdef __SSE4_2__
+        return _mm_crc32_u32(crc, v);
+#else
+        for(int k = 0; k < 4; ++k, v >>= 8) crc = crc32c_u8(crc, uint8_t(v));
+        return crc;
+#endif
+    }
+    /**
+     * @brief `crc` updated with the little-endian bytes of `v`.
+     */
+    inline uint32_t crc32c_u64(uint32_t crc, uint64_t v) noexcept {
+#if defined(__SSE4_2__) && defined(__x86_64__)
+        return uint32_t(_mm_crc32_u64(crc, v));
+#else
+        crc = crc32c_u32(crc, uint32_t(v));
+        return crc32c_u32(crc, uint32_t(v >> 32));
+#endif
+    }
+}
+}
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * @file kernel_gcd.h
+ * @brief Header file for the batched binary GCD and LCM kernels.
+ *
+ * This file defines `gcd_kernel`, the element-wise greatest common divisor and least
+ * common multiple of two integer arrays. Both use Stein's binary algorithm: the common
+ * power of two is split off with `tzcnt`, then the smaller odd value is subtracted from
+ * the larger and the difference shifted right by its trailing zeros until it becomes 0.
+ * The loop body is min, max, sub and shift, no divide and no data dependent branch.
+ * The AVX kernels run that loop for all lanes of a register at once, lanes that have
+ * converged are frozen by a mask and the loop ends when every lane has. SSE has no per
+ * lane shift counts, emulating them costs more than the four lanes gain, so SSE uses the
+ * scalar kernel. The LCM divides by the GCD exactly, with a multiplication by the inverse
+ * of its odd part modulo `2^w`.
+ *
+ * Signed inputs are replaced by their magnitude, so the results are non-negative like
+ * those of `std::gcd` and `std::lcm`; results that do not fit the type wrap.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_GCD_H
+#define ADAPTIVE_KERNEL_GCD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief `|v|` as the unsigned type of `TINT`, without a branch.
+     */
+    template <typename TINT>
+    inline typename std::make_unsigned<TINT>::type gcd_magnitude(TINT v) noexcept {
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+        if constexpr (std::is_signed<TINT>::value) {
+            const unsigned_type s = unsigned_type(0) - unsigned_type(v < 0);
+            return unsigned_type((unsigned_type(v) ^ s) - s);
+        } else {
+            return v;
+        }
+    }
+
+    /**
+     * @brief Binary GCD of two magnitudes, `gcd(0, b) = b`.
+     */
+    template <typename TUINT>
+    inline TUINT gcd_binary(TUINT a, TUINT b) noexcept {
+        // Narrow types are counted and shifted in 32 bits.
+        using wide = typename std::conditional<(sizeof(TUINT) <= 4), uint32_t, uint64_t>::type;
+        wide u = a, v = b;
+        if(u == 0 || v == 0) return TUINT(u | v);
+
+        const int shift = ctz(wide(u | v));
+        u >>= ctz(u);
+        v >>= ctz(v);
+        for(;;) {
+            const wide mn = u < v ? u : v;
+            const wide d = (u < v ? v : u) - mn;
+            v = mn;
+            if(d == 0) break;
+            u = d >> ctz(d);
+        }
+        return TUINT(v << shift);
+    }
+
+    /**
+     * @brief Inverse of the odd `x` modulo `2^w`, Newton's iteration doubles the correct bits.
+     */
+    template <typename TUINT>
+    inline TUINT inverse_odd(TUINT x) noexcept {
+        using wide = typename std::conditional<(sizeof(TUINT) <= 4), uint32_t, uint64_t>::type;
+        // x * x = 1 mod 8 for every odd x: three bits to start with.
+        wide y = x;
+        for(int bits = 3; bits < int(8 * sizeof(wide)); bits *= 2) y *= wide(2) - wide(x) * y;
+        return TUINT(y);
+    }
+
+    /**
+     * @brief LCM of two magnitudes from their GCD `g`, `lcm(0, b) = 0`.
+     */
+    template <typename TUINT>
+    inline TUINT lcm_binary(TUINT a, TUINT b, TUINT g) noexcept {
+        using wide = typename std::conditional<(sizeof(TUINT) <= 4), uint32_t, uint64_t>::type;
+        if(g == 0) return 0;
+        const int k = ctz(wide(g));
+        // g divides a: (a / 2^k) / (g / 2^k) is exact, so it equals the product with the inverse.
+        const wide q = wide(wide(a) >> k) * inverse_odd<wide>(wide(g) >> k);
+        return TUINT(q * wide(b));
+    }
+
+    /**
+     * @class gcd_kernel
+     * @brief Scalar GCD and LCM kernels, used for every technique and type without a specialization.
+     *
+     * @tparam TINT The integer type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct gcd_kernel {
+        /**
+         * @brief `out[i] = gcd(|a[i]|, |b[i]|)`, `out` may alias an input.
+         */
+        static void gcd(const TINT* a, const TINT* b, TINT* out, size_t n) {
+            for(size_t i = 0; i < n; ++i) out[i] = TINT(gcd_binary(gcd_magnitude(a[i]), gcd_magnitude(b[i])));
+        }
+        /**
+         * @brief `out[i] = lcm(|a[i]|, |b[i]|)`, `out` may alias an input.
+         */
+        static void lcm(const TINT* a, const TINT* b, TINT* out, size_t n) {
+            for(size_t i = 0; i < n; ++i) {
+                const auto _a = gcd_magnitude(a[i]), _b = gcd_magnitude(b[i]);
+                out[i] = TINT(lcm_binary(_a, _b, gcd_binary(_a, _b)));
+            }
+        }
+    };
+
+#ifdef __AVX2__
+    /**
+     * @brief AVX2 register operations of the GCD kernels, eight 32-bit or four 64-bit lanes.
+     *
+     * AVX2 lacks the unsigned 64-bit min/max and the 64-bit abs, they are built from
+     * `vpcmpgtq` on sign flipped operands.
+     */
+    template <typename TINT>
+    struct gcd_ops_avx {
+        static constexpr bool is_64 = (sizeof(TINT) == 8);
+        static constexpr size_t lanes = 32 / sizeof(TINT);
+        using reg = __m256i;
+
+        static reg load(const TINT* p)        { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(TINT* p, reg v)     { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(uint32_t v)           { return is_64 ? _mm256_set1_epi64x(int64_t(v)) : _mm256_set1_epi32(int(v)); }
+        static reg or_(reg a, reg b)          { return _mm256_or_si256(a, b); }
+        static reg and_(reg a, reg b)         { return _mm256_and_si256(a, b); }
+        static reg andnot(reg m, reg v)       { return _mm256_andnot_si256(m, v); }
+        static reg select(reg m, reg a, reg b) { return _mm256_blendv_epi8(b, a, m); }
+        static bool none(reg v)               { return _mm256_testz_si256(v, v) != 0; }
+        static reg abs(reg v) {
+            if constexpr (is_64) {
+                const reg s = _mm256_cmpgt_epi64(_mm256_setzero_si256(), v);
+                return _mm256_sub_epi64(_mm256_xor_si256(v, s), s);
+            } else {
+                return _mm256_abs_epi32(v);
+            }
+        }
+        static reg eq0(reg v) {
+            if constexpr (is_64) return _mm256_cmpeq_epi64(v, _mm256_setzero_si256());
+            else return _mm256_cmpeq_epi32(v, _mm256_setzero_si256());
+        }
+        static reg sub(reg a, reg b) {
+            if constexpr (is_64) return _mm256_sub_epi64(a, b);
+            else return _mm256_sub_epi32(a, b);
+        }
+        static reg min(reg a, reg b) {
+            if constexpr (is_64) return _mm256_blendv_epi8(a, b, gt_u64(a, b));
+            else return _mm256_min_epu32(a, b);
+        }
+        static reg max(reg a, reg b) {
+            if constexpr (is_64) return _mm256_blendv_epi8(b, a, gt_u64(a, b));
+            else return _mm256_max_epu32(a, b);
+        }
+        static reg mul(reg a, reg b) {
+            if constexpr (is_64) return mullo_epi64_avx(a, b);
+            else return _mm256_mullo_epi32(a, b);
+        }
+        static reg srlv(reg v, reg c) {
+            if constexpr (is_64) return _mm256_srlv_epi64(v, c);
+            else return _mm256_srlv_epi32(v, c);
+        }
+        static reg sllv(reg v, reg c) {
+            if constexpr (is_64) return _mm256_sllv_epi64(v, c);
+            else return _mm256_sllv_epi32(v, c);
+        }
+        /**
+         * @brief Trailing zeros of every lane, 0 for a zero lane
+         *
+         * The lowest set bit `v & -v` converts exactly to a float, its exponent is the count.
+         * A 64-bit lane has the bit in one of its 32-bit halves, the high half adds 32.
+         */
+        static reg ctz(reg v) {
+            const reg low = _mm256_and_si256(v, sub(_mm256_setzero_si256(), v));
+            reg e = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(low)), 23),
+                                                      _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+            if constexpr (is_64) {
+                e = _mm256_andnot_si256(_mm256_cmpeq_epi32(low, _mm256_setzero_si256()),
+                                        _mm256_add_epi32(e, _mm256_set1_epi64x(int64_t(32) << 32)));
+                return _mm256_add_epi64(_mm256_and_si256(e, _mm256_set1_epi64x(0xFFFFFFFF)), _mm256_srli_epi64(e, 32));
+            } else {
+                return _mm256_andnot_si256(_mm256_cmpeq_epi32(low, _mm256_setzero_si256()), e);
+            }
+        }
+
+    private:
+        static reg gt_u64(reg a, reg b) {
+            const reg s = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+        }
+    };
+#endif
+
+    /**
+     * @class gcd_kernel_simd
+     * @brief Lane-parallel binary GCD and LCM written once over the register operations `TOPS`.
+     *
+     * Every lane runs the scalar `gcd_binary` loop. A lane is active while its `u` is not
+     * zero; the difference of a finished lane is masked to zero so it stays finished and
+     * keeps its result. Pairs with a zero operand start finished with `u | v`.
+     */
+    template <typename TINT, typename TOPS>
+    struct gcd_kernel_simd {
+        using reg = typename TOPS::reg;
+        using scalar_type = gcd_kernel<TINT, techn_type::Scalar>;
+
+        static void gcd(const TINT* a, const TINT* b, TINT* out, size_t n) {
+            constexpr size_t L = TOPS::lanes;
+            size_t i = 0;
+            for(; i + L <= n; i += L) {
+                reg shift;
+                const reg g = gcd_odd(TOPS::load(a + i), TOPS::load(b + i), shift);
+                TOPS::store(out + i, TOPS::sllv(g, shift));
+            }
+            scalar_type::gcd(a + i, b + i, out + i, n - i);
+        }
+        static void lcm(const TINT* a, const TINT* b, TINT* out, size_t n) {
+            constexpr size_t L = TOPS::lanes;
+            constexpr int steps = (sizeof(TINT) == 8) ? 5 : 4;
+            const reg two = TOPS::set1(2);
+            size_t i = 0;
+            for(; i + L <= n; i += L) {
+                const reg va = TOPS::load(a + i), vb = TOPS::load(b + i);
+                // The odd part of the gcd and its power of two, a zero gcd gives a zero inverse.
+                reg shift;
+                const reg g = gcd_odd(va, vb, shift);
+                reg inv = g;
+                for(int s = 0; s < steps; ++s) inv = TOPS::mul(inv, TOPS::sub(two, TOPS::mul(g, inv)));
+                const reg q = TOPS::mul(TOPS::srlv(magnitude(va), shift), inv);
+                TOPS::store(out + i, TOPS::mul(q, magnitude(vb)));
+            }
+            scalar_type::lcm(a + i, b + i, out + i, n - i);
+        }
+
+    protected:
+        static reg magnitude(reg v) {
+            if constexpr (std::is_signed<TINT>::value) return TOPS::abs(v);
+            else return v;
+        }
+        /**
+         * @brief The odd part of `gcd(|a|, |b|)`, stores its power of two in `shift`
+         *
+         * Lanes with a zero operand return `|a| | |b|` unshifted with a shift of 0.
+         */
+        static reg gcd_odd(reg a, reg b, reg& shift) {
+            reg u = magnitude(a), v = magnitude(b);
+            const reg has0 = TOPS::or_(TOPS::eq0(u), TOPS::eq0(v));
+            v = TOPS::select(has0, TOPS::or_(u, v), v);
+            u = TOPS::andnot(has0, u);
+
+            const reg cu = TOPS::ctz(u);
+            const reg cv = TOPS::andnot(has0, TOPS::ctz(v));
+            shift = TOPS::min(cu, cv);
+            u = TOPS::srlv(u, cu);
+            v = TOPS::srlv(v, cv);
+            while(!TOPS::none(u)) {
+                const reg active = TOPS::eq0(TOPS::eq0(u));
+                const reg mn = TOPS::min(u, v);
+                const reg d = TOPS::and_(active, TOPS::sub(TOPS::max(u, v), mn));
+                v = TOPS::select(active, mn, v);
+                u = TOPS::srlv(d, TOPS::ctz(d));
+            }
+            return v;
+        }
+    };
+
+#ifdef __AVX2__
+    /**
+     * @brief Specialization for AVX technique, 32-bit and 64-bit lanes
+     */
+    template <typename TINT>
+    struct gcd_kernel<TINT, techn_type::AVX, typename std::enable_if<sizeof(TINT) == 4 || sizeof(TINT) == 8>::type>
+        : gcd_kernel_simd<TINT, gcd_ops_avx<TINT>> { };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <typename TINT>
+    struct gcd_kernel<TINT, techn_type::AVX512, typename std::enable_if<sizeof(TINT) == 4 || sizeof(TINT) == 8>::type>
+        : gcd_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
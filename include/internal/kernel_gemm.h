@@ -0,0 +1,237 @@
+/**
+ * @file kernel_gemm.h
+ * @brief Header file for the blocked integer matrix multiply kernels.
+ *
+ * This file defines the packing routines and the `gemm_kernel` micro kernels for
+ * `C += A * B` on integer matrices. `A` is packed into strips of `mr` rows, `B` into
+ * strips of `nr` columns, both `k`-major, so the micro kernel streams both operands
+ * with unit stride. The SSE and AVX kernels broadcast one `A` element per row and
+ * multiply it with a register of `B` (16-, 32- and 64-bit elements); 8-bit elements
+ * and the scalar technique use the plain loop.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_GEMM_H
+#define ADAPTIVE_KERNEL_GEMM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include "immintrin.h"
+#endif
+
+/**
+ * @brief Depth of one packed block (elements of `k`).
+ */
+#ifndef ADAPTIVE_GEMM_KC
+#define ADAPTIVE_GEMM_KC 256
+#endif
+/**
+ * @brief Bytes of the per-thread packed `B` panel, sized to stay in a private L2.
+ */
+#ifndef ADAPTIVE_GEMM_L2_BYTES
+#define ADAPTIVE_GEMM_L2_BYTES 262144
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Register operations for the SIMD micro kernel.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct gemm_simd {
+        static constexpr bool enabled = false;
+    };
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct gemm_simd<TINT, techn_type::SSE> {
+        static constexpr bool enabled = sizeof(TINT) == 2 || sizeof(TINT) == 4 || sizeof(TINT) == 8;
+        static constexpr size_t lanes = 16 / sizeof(TINT);
+        using reg = __m128i;
+
+        static reg zero()                    { return _mm_setzero_si128(); }
+        static reg load(const TINT* p)       { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(TINT* p, reg v)    { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg set1(TINT v) {
+            if constexpr (sizeof(TINT) == 2) return _mm_set1_epi16(v);
+            else if constexpr (sizeof(TINT) == 4) return _mm_set1_epi32(v);
+            else return _mm_set1_epi64x(v);
+        }
+        static reg madd(reg c, reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm_add_epi16(c, _mm_mullo_epi16(a, b));
+            else if constexpr (sizeof(TINT) == 4) return _mm_add_epi32(c, _mm_mullo_epi32(a, b));
+            else return _mm_add_epi64(c, mullo_epi64_sse(a, b));
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct gemm_simd<TINT, techn_type::AVX> {
+        static constexpr bool enabled = sizeof(TINT) == 2 || sizeof(TINT) == 4 || sizeof(TINT) == 8;
+        static constexpr size_t lanes = 32 / sizeof(TINT);
+        using reg = __m256i;
+
+        static reg zero()                    { return _mm256_setzero_si256(); }
+        static reg load(const TINT* p)       { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(TINT* p, reg v)    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(TINT v) {
+            if constexpr (sizeof(TINT) == 2) return _mm256_set1_epi16(v);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_set1_epi32(v);
+            else return _mm256_set1_epi64x(v);
+        }
+        static reg madd(reg c, reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm256_add_epi16(c, _mm256_mullo_epi16(a, b));
+            else if constexpr (sizeof(TINT) == 4) return _mm256_add_epi32(c, _mm256_mullo_epi32(a, b));
+            else return _mm256_add_epi64(c, mullo_epi64_avx(a, b));
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct gemm_simd<TINT, techn_type::AVX512> : gemm_simd<TINT, techn_type::AVX> { };
+#endif
+
+    /**
+     * @class gemm_kernel
+     * @brief The `mr` x `nr` micro kernel of the technique.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, bool TSIMD = gemm_simd<TINT, TTECH>::enabled>
+    struct gemm_kernel {
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+        // Narrow types would be promoted to (signed) int and could overflow.
+        using wide_type = typename std::conditional<(sizeof(unsigned_type) < sizeof(unsigned)), unsigned, unsigned_type>::type;
+
+        static constexpr size_t mr = 4;
+        static constexpr size_t nr = 8;
+
+        /**
+         * @brief Computes the `mr` x `nr` product of a packed `A` strip and a packed `B` strip.
+         *
+         * @param kc The depth.
+         * @param pa The packed `A` strip, `[k][mr]`.
+         * @param pb The packed `B` strip, `[k][nr]`.
+         * @param tile Receives the `mr` x `nr` result, row-major.
+         */
+        static void micro(size_t kc, const TINT* pa, const TINT* pb, TINT* tile) {
+            wide_type acc[mr * nr] = { };
+            for(size_t k = 0; k < kc; ++k)
+                for(size_t r = 0; r < mr; ++r)
+                    for(size_t j = 0; j < nr; ++j)
+                        acc[r * nr + j] += wide_type(unsigned_type(pa[k * mr + r])) * wide_type(unsigned_type(pb[k * nr + j]));
+            for(size_t i = 0; i < mr * nr; ++i) tile[i] = TINT(unsigned_type(acc[i]));
+        }
+    };
+
+    template <typename TINT, techn_t TTECH>
+    struct gemm_kernel<TINT, TTECH, true> {
+        using simd_type = gemm_simd<TINT, TTECH>;
+        using reg = typename simd_type::reg;
+
+        static constexpr size_t mr = 4;
+        static constexpr size_t nr = 2 * simd_type::lanes;
+
+        static void micro(size_t kc, const TINT* pa, const TINT* pb, TINT* tile) {
+            reg c0[mr], c1[mr];
+            for(size_t r = 0; r < mr; ++r) c0[r] = c1[r] = simd_type::zero();
+
+            for(size_t k = 0; k < kc; ++k) {
+                reg b0 = simd_type::load(pb + k * nr);
+                reg b1 = simd_type::load(pb + k * nr + simd_type::lanes);
+                for(size_t r = 0; r < mr; ++r) {
+                    reg a = simd_type::set1(pa[k * mr + r]);
+                    c0[r] = simd_type::madd(c0[r], a, b0);
+                    c1[r] = simd_type::madd(c1[r], a, b1);
+                }
+            }
+            for(size_t r = 0; r < mr; ++r) {
+                simd_type::store(tile + r * nr, c0[r]);
+                simd_type::store(tile + r * nr + simd_type::lanes, c1[r]);
+            }
+        }
+    };
+
+    /**
+     * @brief Packs rows `[0, mc)` x depth `[0, kc)` of `a` into strips of `MR` rows, `[strip][k][MR]`.
+     *
+     * `lda` and `acs` are the row and element strides of `a`. The last strip is padded
+     * with zero rows.
+     */
+    template <size_t MR, typename TINT>
+    void gemm_pack_a(const TINT* a, ptrdiff_t lda, ptrdiff_t acs, size_t mc, size_t kc, TINT* dst) {
+        for(size_t i = 0; i < mc; i += MR) {
+            const size_t m = std::min(MR, mc - i);
+            for(size_t k = 0; k < kc; ++k) {
+                for(size_t r = 0; r < m; ++r) dst[k * MR + r] = a[ptrdiff_t(i + r) * lda + ptrdiff_t(k) * acs];
+                for(size_t r = m; r < MR; ++r) dst[k * MR + r] = 0;
+            }
+            dst += kc * MR;
+        }
+    }
+    /**
+     * @brief Packs depth `[0, kc)` x columns `[0, nc)` of `b` into strips of `NR` columns, `[strip][k][NR]`.
+     *
+     * `ldb` and `bcs` are the row and element strides of `b`; rows with unit element
+     * stride are copied as a block. The last strip is padded with zero columns.
+     */
+    template <size_t NR, typename TINT>
+    void gemm_pack_b(const TINT* b, ptrdiff_t ldb, ptrdiff_t bcs, size_t kc, size_t nc, TINT* dst) {
+        for(size_t j = 0; j < nc; j += NR) {
+            const size_t n = std::min(NR, nc - j);
+            for(size_t k = 0; k < kc; ++k) {
+                const TINT* brow = b + ptrdiff_t(k) * ldb + ptrdiff_t(j) * bcs;
+                if(bcs == 1) std::copy(brow, brow + n, dst + k * NR);
+                else for(size_t q = 0; q < n; ++q) dst[k * NR + q] = brow[ptrdiff_t(q) * bcs];
+                std::fill(dst + k * NR + n, dst + k * NR + NR, TINT(0));
+            }
+            dst += kc * NR;
+        }
+    }
+
+    /**
+     * @brief Adds the micro kernel results of a packed `A` block times a packed `B` panel to `C`.
+     *
+     * @param pa The packed rows of `A` for this block, as produced by `gemm_pack_a`.
+     * @param pb The packed panel of `B`, as produced by `gemm_pack_b`.
+     * @param c The first element of the `mc` x `nc` destination block.
+     */
+    template <typename TKERNEL, typename TINT>
+    void gemm_macro(size_t mc, size_t nc, size_t kc, const TINT* pa, const TINT* pb, TINT* c, size_t ldc) {
+        constexpr size_t MR = TKERNEL::mr, NR = TKERNEL::nr;
+        TINT tile[MR * NR];
+
+        for(size_t j = 0; j < nc; j += NR) {
+            const size_t n = std::min(NR, nc - j);
+            const TINT* pbs = pb + (j / NR) * kc * NR;
+            for(size_t i = 0; i < mc; i += MR) {
+                const size_t m = std::min(MR, mc - i);
+                TKERNEL::micro(kc, pa + (i / MR) * kc * MR, pbs, tile);
+                for(size_t r = 0; r < m; ++r) {
+                    TINT* crow = c + (i + r) * ldc + j;
+                    for(size_t q = 0; q < n; ++q) crow[q] = TINT(crow[q] + tile[r * NR + q]);
+                }
+            }
+        }
+    }
+}
+}
+
+#endif
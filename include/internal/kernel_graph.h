@@ -0,0 +1,142 @@
+/**
+ * @file kernel_graph.h
+ * @brief Header file for the chunk kernels of the expression graph executor.
+ *
+ * This file defines `graph_op`, the operations of an `expr_graph`, and `graph_kernel`,
+ * which applies one of them to a chunk of elements. The comparisons, `abs`, `sign`,
+ * `avg` and `clamp` run the batch functions of the technique backend; the wrapping
+ * arithmetic and bitwise operations are plain loops over the unsigned type, which the
+ * compiler vectorizes for the target. The reductions use the sum and argmin / argmax
+ * kernels.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_GRAPH_H
+#define ADAPTIVE_KERNEL_GRAPH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_integer.h>
+
+#include "kernel_argext.h"
+#include "kernel_scan.h"
+
+namespace adaptive {
+    /**
+     * @brief The operations of an expression graph
+     */
+    enum class graph_op : uint8_t {
+        Input = 0,      ///< an array bound to the graph
+        Constant,       ///< a scalar known when the graph is built
+        Add,            ///< `a + b`, wrapping
+        Sub,            ///< `a - b`, wrapping
+        Mul,            ///< `a * b`, wrapping
+        And,            ///< `a & b`
+        Or,             ///< `a | b`
+        Xor,            ///< `a ^ b`
+        Neg,            ///< `-a`, wrapping
+        Abs,            ///< `|a|`
+        Sign,           ///< -1, 0 or 1
+        Min,            ///< `min(a, b)`
+        Max,            ///< `max(a, b)`
+        Avg,            ///< `(a + b + 1) >> 1` without overflow
+        Clamp,          ///< `a` limited to two scalars
+        Sum,            ///< the wrapping sum of an array, a scalar
+        MinOf,          ///< the smallest element of an array, a scalar
+        MaxOf,          ///< the largest element of an array, a scalar
+    };
+
+namespace internal {
+    /**
+     * @brief Get whether `op` is symmetric in its operands, for the common subexpression keys
+     */
+    constexpr bool graph_op_commutative(graph_op op) noexcept {
+        return op == graph_op::Add || op == graph_op::Mul || op == graph_op::And || op == graph_op::Or ||
+               op == graph_op::Xor || op == graph_op::Min || op == graph_op::Max || op == graph_op::Avg;
+    }
+    /**
+     * @brief Get whether `op` reduces an array to a scalar
+     */
+    constexpr bool graph_op_reduction(graph_op op) noexcept {
+        return op == graph_op::Sum || op == graph_op::MinOf || op == graph_op::MaxOf;
+    }
+    /**
+     * @brief Get the number of array or scalar operands of `op`
+     */
+    constexpr int graph_op_arity(graph_op op) noexcept {
+        return (op == graph_op::Input || op == graph_op::Constant) ? 0
+             : (op == graph_op::Add || op == graph_op::Sub || op == graph_op::Mul || op == graph_op::And ||
+                op == graph_op::Or || op == graph_op::Xor || op == graph_op::Min || op == graph_op::Max ||
+                op == graph_op::Avg) ? 2 : 1;
+    }
+
+    /**
+     * @class graph_kernel
+     * @brief Applies the element-wise operations and reductions of a graph to chunks.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct graph_kernel {
+        using value_type = TINT;
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+        // Narrow types would be promoted to (signed) int and could overflow.
+        using wide_type = typename std::conditional<(sizeof(unsigned_type) < sizeof(unsigned)), unsigned, unsigned_type>::type;
+        using backend_type = typename adaptive_number<TINT, TTECH>::backend_type;
+
+        /**
+         * @brief `out[i] = op(a[i], b[i])`, `b` is unused for unary operations
+         *
+         * @param lo The lower bound of `Clamp`
+         * @param hi The upper bound of `Clamp`
+         */
+        static void apply(graph_op op, const TINT* a, const TINT* b, TINT* out, size_t n, TINT lo, TINT hi) {
+            const unsigned_type* ua = reinterpret_cast<const unsigned_type*>(a);
+            const unsigned_type* ub = reinterpret_cast<const unsigned_type*>(b);
+            unsigned_type* uo = reinterpret_cast<unsigned_type*>(out);
+            switch(op) {
+                case graph_op::Add: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(ua[i] + ub[i]); break;
+                case graph_op::Sub: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(ua[i] - ub[i]); break;
+                case graph_op::Mul: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(wide_type(ua[i]) * ub[i]); break;
+                case graph_op::And: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(ua[i] & ub[i]); break;
+                case graph_op::Or:  for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(ua[i] | ub[i]); break;
+                case graph_op::Xor: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(ua[i] ^ ub[i]); break;
+                case graph_op::Neg: for(size_t i = 0; i < n; ++i) uo[i] = unsigned_type(0u - ua[i]); break;
+                case graph_op::Abs:   backend_type::abs(a, out, n); break;
+                case graph_op::Sign:  backend_type::sign(a, out, n); break;
+                case graph_op::Min:   backend_type::min(a, b, out, n); break;
+                case graph_op::Max:   backend_type::max(a, b, out, n); break;
+                case graph_op::Avg:   backend_type::avg(a, b, out, n); break;
+                case graph_op::Clamp: backend_type::clamp(a, lo, hi, out, n); break;
+                default: break;
+            }
+        }
+
+        /**
+         * @brief The reduction `op` of `p[0, n)`, `n` must not be 0
+         */
+        static TINT reduce(graph_op op, const TINT* p, size_t n) noexcept {
+            if(op == graph_op::Sum) return scan_kernel<TINT, TTECH>::reduce(p, n);
+            if(op == graph_op::MinOf) return p[argext_kernel<TINT, TTECH>::template find<false>(p, n)];
+            return p[argext_kernel<TINT, TTECH>::template find<true>(p, n)];
+        }
+        /**
+         * @brief Merges two partial results of the reduction `op`
+         */
+        static TINT combine(graph_op op, TINT a, TINT b) noexcept {
+            if(op == graph_op::Sum) return TINT(unsigned_type(unsigned_type(a) + unsigned_type(b)));
+            if(op == graph_op::MinOf) return b < a ? b : a;
+            return a < b ? b : a;
+        }
+    };
+}
+}
+
+#endif
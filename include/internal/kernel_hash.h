@@ -0,0 +1,301 @@
+/**
+ * @file kernel_hash.h
+ * @brief Header file for the batched integer hash and partition kernels.
+ *
+ * This file defines `hash_kernel`, which hashes every 32-bit or 64-bit key of an array
+ * and optionally maps the hash to a partition in `[0, partitions)` in the same pass.
+ * The mixers (Murmur3 finalizer, xxHash of the key bytes, multiply-shift) are written
+ * once over the register operations `hash_ops`, which are plain integers for the scalar
+ * technique and `_mm*_mullo` plus xor and shifts for SSE/AVX; AVX2 has no 64-bit low
+ * multiply, 64-bit keys use the three `pmuludq` emulation. The CRC32C hash is one
+ * `crc32` instruction per key and has no SIMD form.
+ *
+ * The partition of a hash is `(h' * partitions) >> 32` with `h'` the high 32 bits of
+ * the hash, the multiply replaces the modulo and uses the best mixed bits.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_HASH_H
+#define ADAPTIVE_KERNEL_HASH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "kernel_crc.h"
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Constants of the mixers for one word width.
+     */
+    template <typename TUINT>
+    struct hash_constants;
+    template <>
+    struct hash_constants<uint32_t> {
+        static constexpr uint32_t murmur_m1 = 0x85EBCA6Bu, murmur_m2 = 0xC2B2AE35u;
+        static constexpr int murmur_s1 = 16, murmur_s2 = 13, murmur_s3 = 16;
+        static constexpr uint32_t xxh_p1 = 0x9E3779B1u, xxh_p2 = 0x85EBCA77u, xxh_p3 = 0xC2B2AE3Du,
+                                  xxh_p4 = 0x27D4EB2Fu, xxh_p5 = 0x165667B1u;
+        static constexpr uint32_t golden = 0x9E3779B1u;
+    };
+    template <>
+    struct hash_constants<uint64_t> {
+        static constexpr uint64_t murmur_m1 = 0xFF51AFD7ED558CCDull, murmur_m2 = 0xC4CEB9FE1A85EC53ull;
+        static constexpr int murmur_s1 = 33, murmur_s2 = 33, murmur_s3 = 33;
+        static constexpr uint64_t xxh_p1 = 0x9E3779B185EBCA87ull, xxh_p2 = 0xC2B2AE3D27D4EB4Full,
+                                  xxh_p3 = 0x165667B19E3779F9ull, xxh_p4 = 0x85EBCA77C2B2AE63ull,
+                                  xxh_p5 = 0x27D4EB2F165667C5ull;
+        static constexpr uint64_t golden = 0x9E3779B97F4A7C15ull;
+    };
+
+    /**
+     * @class hash_ops
+     * @brief Register operations of the hash kernels, the scalar technique with one lane.
+     *
+     * @tparam TINT The key type, 32 or 64 bits.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct hash_ops {
+        using value_type = typename std::make_unsigned<TINT>::type;
+        using reg = value_type;
+        static constexpr size_t lanes = 1;
+        static constexpr int bits = 8 * sizeof(TINT);
+
+        static reg load(const TINT* p)          { return reg(*p); }
+        static void store(TINT* p, reg v)       { *p = TINT(v); }
+        static reg set1(value_type v)           { return v; }
+        static reg xor_(reg a, reg b)           { return reg(a ^ b); }
+        static reg add(reg a, reg b)            { return reg(a + b); }
+        static reg mul(reg a, reg b)            { return reg(a * b); }
+        static reg srli(reg v, int n)           { return reg(v >> n); }
+        static reg rotl(reg v, int n)           { return reg((v << n) | (v >> (bits - n))); }
+        static void store_part(uint32_t* p, reg h, uint32_t partitions) {
+            *p = uint32_t((uint64_t(h >> (bits - 32)) * partitions) >> 32);
+        }
+    };
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct hash_ops<TINT, techn_type::SSE, typename std::enable_if<sizeof(TINT) == 4 || sizeof(TINT) == 8>::type> {
+        using value_type = typename std::make_unsigned<TINT>::type;
+        using reg = __m128i;
+        static constexpr size_t lanes = 16 / sizeof(TINT);
+        static constexpr bool is_64 = (sizeof(TINT) == 8);
+
+        static reg load(const TINT* p)          { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(TINT* p, reg v)       { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg set1(value_type v)           { return is_64 ? _mm_set1_epi64x(int64_t(v)) : _mm_set1_epi32(int(v)); }
+        static reg xor_(reg a, reg b)           { return _mm_xor_si128(a, b); }
+        static reg add(reg a, reg b)            { return is_64 ? _mm_add_epi64(a, b) : _mm_add_epi32(a, b); }
+        static reg mul(reg a, reg b)            { return is_64 ? mullo_epi64_sse(a, b) : _mm_mullo_epi32(a, b); }
+        static reg srli(reg v, int n)           { return is_64 ? _mm_srli_epi64(v, n) : _mm_srli_epi32(v, n); }
+        static reg rotl(reg v, int n) {
+            if constexpr (is_64) return _mm_or_si128(_mm_slli_epi64(v, n), _mm_srli_epi64(v, 64 - n));
+            else return _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - n));
+        }
+        static void store_part(uint32_t* p, reg h, uint32_t partitions) {
+            const reg np = _mm_set1_epi32(int(partitions));
+            if constexpr (is_64) {
+                // The high words of the products sit in the odd 32-bit lanes.
+                const reg q = _mm_mul_epu32(_mm_srli_epi64(h, 32), np);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_shuffle_epi32(q, _MM_SHUFFLE(3, 1, 3, 1)));
+            } else {
+                const reg even = _mm_srli_epi64(_mm_mul_epu32(h, np), 32);
+                const reg odd = _mm_mul_epu32(_mm_srli_epi64(h, 32), np);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_blend_epi16(even, odd, 0xCC));
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct hash_ops<TINT, techn_type::AVX, typename std::enable_if<sizeof(TINT) == 4 || sizeof(TINT) == 8>::type> {
+        using value_type = typename std::make_unsigned<TINT>::type;
+        using reg = __m256i;
+        static constexpr size_t lanes = 32 / sizeof(TINT);
+        static constexpr bool is_64 = (sizeof(TINT) == 8);
+
+        static reg load(const TINT* p)          { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(TINT* p, reg v)       { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(value_type v)           { return is_64 ? _mm256_set1_epi64x(int64_t(v)) : _mm256_set1_epi32(int(v)); }
+        static reg xor_(reg a, reg b)           { return _mm256_xor_si256(a, b); }
+        static reg add(reg a, reg b)            { return is_64 ? _mm256_add_epi64(a, b) : _mm256_add_epi32(a, b); }
+        static reg mul(reg a, reg b)            { return is_64 ? mullo_epi64_avx(a, b) : _mm256_mullo_epi32(a, b); }
+        static reg srli(reg v, int n)           { return is_64 ? _mm256_srli_epi64(v, n) : _mm256_srli_epi32(v, n); }
+        static reg rotl(reg v, int n) {
+            if constexpr (is_64) return _mm256_or_si256(_mm256_slli_epi64(v, n), _mm256_srli_epi64(v, 64 - n));
+            else return _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - n));
+        }
+        static void store_part(uint32_t* p, reg h, uint32_t partitions) {
+            const reg np = _mm256_set1_epi32(int(partitions));
+            if constexpr (is_64) {
+                const reg q = _mm256_mul_epu32(_mm256_srli_epi64(h, 32), np);
+                const reg packed = _mm256_permutevar8x32_epi32(q, _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+            } else {
+                const reg even = _mm256_srli_epi64(_mm256_mul_epu32(h, np), 32);
+                const reg odd = _mm256_mul_epu32(_mm256_srli_epi64(h, 32), np);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_blend_epi32(even, odd, 0xAA));
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct hash_ops<TINT, techn_type::AVX512, typename std::enable_if<sizeof(TINT) == 4 || sizeof(TINT) == 8>::type>
+        : hash_ops<TINT, techn_type::AVX> { };
+#endif
+
+    /**
+     * @brief The MurmurHash3 finalizer `fmix` of `key ^ seed`
+     */
+    template <typename TOPS>
+    struct murmur3_mix {
+        using reg = typename TOPS::reg;
+        using constants = hash_constants<typename TOPS::value_type>;
+
+        explicit murmur3_mix(typename TOPS::value_type seed)
+            : m_rSeed(TOPS::set1(seed)), m_rM1(TOPS::set1(constants::murmur_m1)), m_rM2(TOPS::set1(constants::murmur_m2)) { }
+
+        reg operator () (reg x) const {
+            x = TOPS::xor_(x, m_rSeed);
+            x = TOPS::mul(TOPS::xor_(x, TOPS::srli(x, constants::murmur_s1)), m_rM1);
+            x = TOPS::mul(TOPS::xor_(x, TOPS::srli(x, constants::murmur_s2)), m_rM2);
+            return TOPS::xor_(x, TOPS::srli(x, constants::murmur_s3));
+        }
+
+    protected:
+        reg m_rSeed, m_rM1, m_rM2;
+    };
+
+    /**
+     * @brief XXH32 / XXH64 of the little-endian key bytes, equal to the reference implementation
+     */
+    template <typename TOPS>
+    struct xxhash_mix {
+        using reg = typename TOPS::reg;
+        using value_type = typename TOPS::value_type;
+        using constants = hash_constants<value_type>;
+        static constexpr bool is_64 = (sizeof(value_type) == 8);
+
+        explicit xxhash_mix(value_type seed)
+            : m_rStart(TOPS::set1(value_type(seed + constants::xxh_p5 + sizeof(value_type)))),
+              m_rP1(TOPS::set1(constants::xxh_p1)), m_rP2(TOPS::set1(constants::xxh_p2)),
+              m_rP3(TOPS::set1(constants::xxh_p3)), m_rP4(TOPS::set1(constants::xxh_p4)) { }
+
+        reg operator () (reg x) const {
+            reg h;
+            if constexpr (is_64) {
+                h = TOPS::xor_(m_rStart, TOPS::mul(TOPS::rotl(TOPS::mul(x, m_rP2), 31), m_rP1));
+                h = TOPS::add(TOPS::mul(TOPS::rotl(h, 27), m_rP1), m_rP4);
+                h = TOPS::mul(TOPS::xor_(h, TOPS::srli(h, 33)), m_rP2);
+                h = TOPS::mul(TOPS::xor_(h, TOPS::srli(h, 29)), m_rP3);
+                return TOPS::xor_(h, TOPS::srli(h, 32));
+            } else {
+                h = TOPS::add(m_rStart, TOPS::mul(x, m_rP3));
+                h = TOPS::mul(TOPS::rotl(h, 17), m_rP4);
+                h = TOPS::mul(TOPS::xor_(h, TOPS::srli(h, 15)), m_rP2);
+                h = TOPS::mul(TOPS::xor_(h, TOPS::srli(h, 13)), m_rP3);
+                return TOPS::xor_(h, TOPS::srli(h, 16));
+            }
+        }
+
+    protected:
+        reg m_rStart, m_rP1, m_rP2, m_rP3, m_rP4;
+    };
+
+    /**
+     * @brief Multiply-shift, `key * a` with the odd multiplier `a = golden ^ (seed << 1)`
+     *
+     * Only the high bits are well mixed, the partition uses exactly those.
+     */
+    template <typename TOPS>
+    struct multiply_shift_mix {
+        using reg = typename TOPS::reg;
+        using value_type = typename TOPS::value_type;
+
+        explicit multiply_shift_mix(value_type seed)
+            : m_rA(TOPS::set1(value_type(hash_constants<value_type>::golden ^ value_type(seed << 1)))) { }
+
+        reg operator () (reg x) const { return TOPS::mul(x, m_rA); }
+
+    protected:
+        reg m_rA;
+    };
+
+    /**
+     * @class hash_kernel
+     * @brief Hashes an array of keys and optionally maps every hash to a partition.
+     *
+     * `hashes` and `parts` may each be null to skip that output.
+     *
+     * @tparam TINT The key type, 32 or 64 bits.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct hash_kernel {
+        using ops = hash_ops<TINT, TTECH>;
+        using scalar_ops = hash_ops<TINT, techn_type::Scalar>;
+        using value_type = typename scalar_ops::value_type;
+
+        static void murmur3(const TINT* keys, TINT* hashes, uint32_t* parts, uint32_t partitions, size_t n, value_type seed) {
+            run<murmur3_mix>(keys, hashes, parts, partitions, n, seed);
+        }
+        static void xxhash(const TINT* keys, TINT* hashes, uint32_t* parts, uint32_t partitions, size_t n, value_type seed) {
+            run<xxhash_mix>(keys, hashes, parts, partitions, n, seed);
+        }
+        static void multiply_shift(const TINT* keys, TINT* hashes, uint32_t* parts, uint32_t partitions, size_t n, value_type seed) {
+            run<multiply_shift_mix>(keys, hashes, parts, partitions, n, seed);
+        }
+        /**
+         * @brief CRC32C of the key bytes seeded with the low 32 bits of `seed`
+         *
+         * A 64-bit hash holds a second CRC with the inverted high seed bits in its high
+         * half, the partition is taken from that one.
+         */
+        static void crc32c(const TINT* keys, TINT* hashes, uint32_t* parts, uint32_t partitions, size_t n, value_type seed) {
+            for(size_t i = 0; i < n; ++i) {
+                value_type h;
+                if constexpr (sizeof(TINT) == 8) {
+                    h = crc32c_u64(uint32_t(seed), uint64_t(keys[i]))
+                      | (uint64_t(crc32c_u64(~uint32_t(seed >> 32), uint64_t(keys[i]))) << 32);
+                } else {
+                    h = crc32c_u32(uint32_t(seed), uint32_t(keys[i]));
+                }
+                if(hashes) scalar_ops::store(hashes + i, h);
+                if(parts) scalar_ops::store_part(parts + i, h, partitions);
+            }
+        }
+
+    protected:
+        template <template <typename> class TMIX>
+        static void run(const TINT* keys, TINT* hashes, uint32_t* parts, uint32_t partitions, size_t n, value_type seed) {
+            const TMIX<ops> mix(seed);
+            size_t i = 0;
+            for(; i + ops::lanes <= n; i += ops::lanes) {
+                const typename ops::reg h = mix(ops::load(keys + i));
+                if(hashes) ops::store(hashes + i, h);
+                if(parts) ops::store_part(parts + i, h, partitions);
+            }
+            const TMIX<scalar_ops> tail(seed);
+            for(; i < n; ++i) {
+                const value_type h = tail(scalar_ops::load(keys + i));
+                if(hashes) scalar_ops::store(hashes + i, h);
+                if(parts) scalar_ops::store_part(parts + i, h, partitions);
+            }
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * @file kernel_intmath.h
+ * @brief Header file for the batched integer log2, log10, square root and power kernels.
+ *
+ * This file defines `intmath_kernel`, element-wise `floor(log2(x))`, `floor(log10(x))`,
+ * `floor(sqrt(x))` and `x^e` over arrays of unsigned integers:
+ *
+ * - log2 is `lzcnt` in the scalar kernel. SSE/AVX2 have no lane-wise `lzcnt`, there the
+ *   value with the bit below its top bit cleared is converted to a float, which cannot
+ *   round up to the next power of two, and the exponent is the result.
+ * - log10 estimates the result from the log2 (`(log2 + 1) * 1233 >> 12`, 1233 / 4096
+ *   is just below log10(2)) and corrects it by one compare with a table of powers of ten,
+ *   gathered on AVX2.
+ * - sqrt takes the root of a float (32-bit lanes) or double (64-bit lanes) estimate,
+ *   which is off by at most one, and corrects it both ways with exact integer squares.
+ * - pow squares and multiplies, a lane whose product overflows at any step saturates to
+ *   the maximum of the type and is counted.
+ *
+ * The SIMD kernels cover 32-bit lanes on SSE and 32-bit and 64-bit lanes on AVX, the
+ * other widths use the scalar kernel.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_INTMATH_H
+#define ADAPTIVE_KERNEL_INTMATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Powers of ten that fit the type, the table of the log10 correction.
+     */
+    template <typename TUINT>
+    struct pow10_table;
+    template <>
+    struct pow10_table<uint32_t> {
+        static constexpr uint32_t s_values[10] = {
+            1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+        };
+    };
+    template <>
+    struct pow10_table<uint64_t> {
+        static constexpr uint64_t s_values[20] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+            1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+            100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+            1000000000000000000ull, 10000000000000000000ull
+        };
+    };
+
+    /**
+     * @brief `floor(log2(x))`, 0 for `x == 0`.
+     */
+    template <typename TUINT>
+    inline TUINT ilog2_scalar(TUINT x) noexcept {
+        if constexpr (sizeof(TUINT) <= 4) return TUINT(31 - clz(uint32_t(x) | 1u));
+        else return TUINT(63 - clz(uint64_t(x) | 1u));
+    }
+    /**
+     * @brief `floor(log10(x))`, 0 for `x == 0`.
+     */
+    template <typename TUINT>
+    inline TUINT ilog10_scalar(TUINT x) noexcept {
+        using wide = typename std::conditional<(sizeof(TUINT) <= 4), uint32_t, uint64_t>::type;
+        // x | 1 has the same log10 for x > 0, powers of ten are even.
+        const wide v = wide(x) | 1u;
+        const wide t = ((ilog2_scalar(v) + 1) * 1233) >> 12;
+        return TUINT(t - wide(v < pow10_table<wide>::s_values[t]));
+    }
+    /**
+     * @brief `floor(sqrt(x))`.
+     */
+    template <typename TUINT>
+    inline TUINT isqrt_scalar(TUINT x) noexcept {
+        if constexpr (sizeof(TUINT) <= 4) {
+            // The correctly rounded double root of a 32-bit value never reaches the next integer.
+            return TUINT(uint32_t(std::sqrt(double(x))));
+        } else {
+            uint64_t r = uint64_t(std::sqrt(double(x)));
+            r -= uint64_t(r > 0xFFFFFFFFull);
+            r -= uint64_t(r * r > x);
+            r += uint64_t(r < 0xFFFFFFFFull && (r + 1) * (r + 1) <= x);
+            return TUINT(r);
+        }
+    }
+    /**
+     * @brief `a * b`, returns true if the product does not fit `TUINT` (the result then wraps).
+     */
+    template <typename TUINT>
+    inline bool mul_overflow(TUINT a, TUINT b, TUINT& out) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, &out);
+#else
+        using wide = typename std::conditional<(sizeof(TUINT) < sizeof(unsigned)), unsigned, TUINT>::type;
+        out = TUINT(wide(a) * wide(b));
+        return a != 0 && out / a != b;
+#endif
+    }
+    /**
+     * @brief `x^e` by squaring, `0^0 = 1`, saturates and returns true if it does not fit `TUINT`.
+     */
+    template <typename TUINT>
+    inline bool ipow_scalar(TUINT x, uint32_t e, TUINT& out) noexcept {
+        TUINT r = 1;
+        bool ovf = false;
+        for(;;) {
+            if(e & 1u) ovf |= mul_overflow(r, x, r);
+            e >>= 1;
+            if(e == 0) break;
+            ovf |= mul_overflow(x, x, x);
+        }
+        out = ovf ? std::numeric_limits<TUINT>::max() : r;
+        return ovf;
+    }
+
+    /**
+     * @class intmath_kernel
+     * @brief Scalar integer math kernels, used for every technique and type without a specialization.
+     *
+     * @tparam TINT The unsigned integer type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct intmath_kernel {
+        static void ilog2(const TINT* a, TINT* out, size_t n) {
+            for(size_t i = 0; i < n; ++i) out[i] = ilog2_scalar(a[i]);
+        }
+        static void ilog10(const TINT* a, TINT* out, size_t n) {
+            for(size_t i = 0; i < n; ++i) out[i] = ilog10_scalar(a[i]);
+        }
+        static void isqrt(const TINT* a, TINT* out, size_t n) {
+            for(size_t i = 0; i < n; ++i) out[i] = isqrt_scalar(a[i]);
+        }
+        /**
+         * @brief `out[i] = a[i]^e`, saturated on overflow.
+         * @return The number of saturated elements.
+         */
+        static size_t ipow(const TINT* a, uint32_t e, TINT* out, size_t n) {
+            size_t _result = 0;
+            for(size_t i = 0; i < n; ++i) _result += ipow_scalar(a[i], e, out[i]);
+            return _result;
+        }
+    };
+
+#ifdef __SSE4_1__
+    /**
+     * @brief SSE4.1 register operations of the integer math kernels, four uint32 lanes.
+     */
+    struct intmath_ops_sse32 {
+        using value_type = uint32_t;
+        static constexpr size_t lanes = 4;
+        static constexpr uint32_t max_root = 0xFFFFu;
+        using reg = __m128i;
+
+        static reg load(const uint32_t* p)     { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(uint32_t* p, reg v)  { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg set1(uint32_t v)            { return _mm_set1_epi32(int(v)); }
+        static reg add(reg a, reg b)           { return _mm_add_epi32(a, b); }
+        static reg sub(reg a, reg b)           { return _mm_sub_epi32(a, b); }
+        static reg or_(reg a, reg b)           { return _mm_or_si128(a, b); }
+        static reg andnot(reg m, reg v)        { return _mm_andnot_si128(m, v); }
+        static reg srli(reg v, int n)          { return _mm_srli_epi32(v, n); }
+        static reg eq(reg a, reg b)            { return _mm_cmpeq_epi32(a, b); }
+        static reg lt(reg a, reg b) {
+            const reg s = _mm_set1_epi32(INT32_MIN);
+            return _mm_cmpgt_epi32(_mm_xor_si128(b, s), _mm_xor_si128(a, s));
+        }
+        static reg mul(reg a, reg b)           { return _mm_mullo_epi32(a, b); }
+        static reg mul_small(reg a, reg b)     { return _mm_mullo_epi32(a, b); }
+        static size_t count(reg m)             { return size_t(popcount(uint32_t(_mm_movemask_ps(_mm_castsi128_ps(m))))); }
+        /**
+         * @brief Non-zero in the lanes whose product `a * b` needs more than 32 bits
+         */
+        static reg mul_ovf(reg a, reg b) {
+            const reg even = _mm_srli_epi64(_mm_mul_epu32(a, b), 32);
+            const reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_blend_epi16(even, odd, 0xCC);
+        }
+        static reg log2(reg x) {
+            const reg e = float_exp(_mm_andnot_si128(_mm_srli_epi32(x, 1), x));
+            // A set top bit converts to a negative float, that lane is 31.
+            return _mm_max_epi32(_mm_max_epi32(e, _mm_setzero_si128()), _mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(31)));
+        }
+        static reg pow10(reg t) {
+            const uint32_t* tab = pow10_table<uint32_t>::s_values;
+            return _mm_setr_epi32(int(tab[_mm_cvtsi128_si32(t)]), int(tab[_mm_extract_epi32(t, 1)]),
+                                  int(tab[_mm_extract_epi32(t, 2)]), int(tab[_mm_extract_epi32(t, 3)]));
+        }
+        /**
+         * @brief `sqrt(x)` off by at most one, at most `max_root`
+         */
+        static reg sqrt_est(reg x) {
+            const __m128 f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 16)), _mm_set1_ps(65536.0f)),
+                                        _mm_cvtepi32_ps(_mm_and_si128(x, _mm_set1_epi32(0xFFFF))));
+            return _mm_min_epu32(_mm_cvttps_epi32(_mm_sqrt_ps(f)), _mm_set1_epi32(int(max_root)));
+        }
+
+    private:
+        static reg float_exp(reg v) {
+            return _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(_mm_castps_si128(_mm_cvtepi32_ps(v)), 23),
+                                               _mm_set1_epi32(0xFF)), _mm_set1_epi32(127));
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief AVX2 register operations of the integer math kernels, eight uint32 lanes.
+     */
+    struct intmath_ops_avx32 {
+        using value_type = uint32_t;
+        static constexpr size_t lanes = 8;
+        static constexpr uint32_t max_root = 0xFFFFu;
+        using reg = __m256i;
+
+        static reg load(const uint32_t* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(uint32_t* p, reg v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(uint32_t v)            { return _mm256_set1_epi32(int(v)); }
+        static reg add(reg a, reg b)           { return _mm256_add_epi32(a, b); }
+        static reg sub(reg a, reg b)           { return _mm256_sub_epi32(a, b); }
+        static reg or_(reg a, reg b)           { return _mm256_or_si256(a, b); }
+        static reg andnot(reg m, reg v)        { return _mm256_andnot_si256(m, v); }
+        static reg srli(reg v, int n)          { return _mm256_srli_epi32(v, n); }
+        static reg eq(reg a, reg b)            { return _mm256_cmpeq_epi32(a, b); }
+        static reg lt(reg a, reg b) {
+            const reg s = _mm256_set1_epi32(INT32_MIN);
+            return _mm256_cmpgt_epi32(_mm256_xor_si256(b, s), _mm256_xor_si256(a, s));
+        }
+        static reg mul(reg a, reg b)           { return _mm256_mullo_epi32(a, b); }
+        static reg mul_small(reg a, reg b)     { return _mm256_mullo_epi32(a, b); }
+        static size_t count(reg m)             { return size_t(popcount(uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(m))))); }
+        static reg mul_ovf(reg a, reg b) {
+            const reg even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+            const reg odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+            return _mm256_blend_epi32(even, odd, 0xAA);
+        }
+        static reg log2(reg x) {
+            const reg e = float_exp(_mm256_andnot_si256(_mm256_srli_epi32(x, 1), x));
+            return _mm256_max_epi32(_mm256_max_epi32(e, _mm256_setzero_si256()),
+                                    _mm256_and_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(31)));
+        }
+        static reg pow10(reg t) {
+            return _mm256_i32gather_epi32(reinterpret_cast<const int*>(pow10_table<uint32_t>::s_values), t, 4);
+        }
+        static reg sqrt_est(reg x) {
+            const __m256 f = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 16)), _mm256_set1_ps(65536.0f)),
+                                           _mm256_cvtepi32_ps(_mm256_and_si256(x, _mm256_set1_epi32(0xFFFF))));
+            return _mm256_min_epu32(_mm256_cvttps_epi32(_mm256_sqrt_ps(f)), _mm256_set1_epi32(int(max_root)));
+        }
+
+        /**
+         * @brief Float exponent of every signed 32-bit lane, -127 for a zero lane
+         */
+        static reg float_exp(reg v) {
+            return _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(v)), 23),
+                                                     _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+        }
+    };
+
+    /**
+     * @brief AVX2 register operations of the integer math kernels, four uint64 lanes.
+     *
+     * AVX2 has neither a 64-bit multiply nor conversions between 64-bit integers and
+     * doubles: log2 combines the 32-bit halves, products are assembled from `vpmuludq`,
+     * and the square root estimate goes through the 2^52 exponent trick.
+     */
+    struct intmath_ops_avx64 {
+        using value_type = uint64_t;
+        static constexpr size_t lanes = 4;
+        static constexpr uint64_t max_root = 0xFFFFFFFFull;
+        using reg = __m256i;
+
+        static reg load(const uint64_t* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(uint64_t* p, reg v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(uint64_t v)            { return _mm256_set1_epi64x(int64_t(v)); }
+        static reg add(reg a, reg b)           { return _mm256_add_epi64(a, b); }
+        static reg sub(reg a, reg b)           { return _mm256_sub_epi64(a, b); }
+        static reg or_(reg a, reg b)           { return _mm256_or_si256(a, b); }
+        static reg andnot(reg m, reg v)        { return _mm256_andnot_si256(m, v); }
+        static reg srli(reg v, int n)          { return _mm256_srli_epi64(v, n); }
+        static reg eq(reg a, reg b)            { return _mm256_cmpeq_epi64(a, b); }
+        static reg lt(reg a, reg b) {
+            const reg s = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(b, s), _mm256_xor_si256(a, s));
+        }
+        static reg mul(reg a, reg b)           { return mullo_epi64_avx(a, b); }
+        /**
+         * @brief Product of lanes below 2^32
+         */
+        static reg mul_small(reg a, reg b)     { return _mm256_mul_epu32(a, b); }
+        static size_t count(reg m)             { return size_t(popcount(uint32_t(_mm256_movemask_pd(_mm256_castsi256_pd(m))))); }
+        /**
+         * @brief Non-zero in the lanes whose product `a * b` needs more than 64 bits
+         *
+         * With both high halves set it always does; otherwise at most one cross product
+         * is non-zero and the sum with the carry of the low product still fits 64 bits.
+         */
+        static reg mul_ovf(reg a, reg b) {
+            const reg a1 = _mm256_srli_epi64(a, 32), b1 = _mm256_srli_epi64(b, 32);
+            const reg cross = _mm256_add_epi64(_mm256_mul_epu32(a1, b), _mm256_mul_epu32(a, b1));
+            const reg t = _mm256_add_epi64(cross, _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32));
+            return _mm256_or_si256(_mm256_mul_epu32(a1, b1), _mm256_srli_epi64(t, 32));
+        }
+        /**
+         * @brief The log2 of the high half plus 32 if it is non-zero, else that of the low half
+         */
+        static reg log2(reg x) {
+            reg e = intmath_ops_avx32::log2(x);
+            e = _mm256_andnot_si256(_mm256_cmpeq_epi32(x, _mm256_setzero_si256()),
+                                    _mm256_add_epi32(e, _mm256_set1_epi64x(int64_t(32) << 32)));
+            return _mm256_max_epu32(_mm256_srli_epi64(e, 32), _mm256_and_si256(e, _mm256_set1_epi64x(0xFFFFFFFF)));
+        }
+        static reg pow10(reg t) {
+            return _mm256_i64gather_epi64(reinterpret_cast<const long long*>(pow10_table<uint64_t>::s_values), t, 8);
+        }
+        static reg sqrt_est(reg x) {
+            const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+            const reg magic = _mm256_castpd_si256(two52);
+            // Each 32-bit half or'ed into the mantissa of 2^52 is 2^52 + half exactly.
+            const __m256d hi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 32), magic)), two52);
+            const __m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi64x(0xFFFFFFFF)), magic)), two52);
+            const __m256d d = _mm256_add_pd(_mm256_mul_pd(hi, _mm256_set1_pd(4294967296.0)), lo);
+            // Adding 2^52 rounds the root to an integer in the low mantissa bits.
+            reg r = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(_mm256_sqrt_pd(d), two52)), magic);
+            return _mm256_add_epi64(r, _mm256_cmpgt_epi64(r, _mm256_set1_epi64x(int64_t(max_root))));
+        }
+    };
+#endif
+
+    /**
+     * @class intmath_kernel_simd
+     * @brief Integer math kernels written once over the register operations `TOPS`.
+     */
+    template <typename TOPS>
+    struct intmath_kernel_simd {
+        using reg = typename TOPS::reg;
+        using value_type = typename TOPS::value_type;
+        using scalar_type = intmath_kernel<value_type, techn_type::Scalar>;
+
+        static void ilog2(const value_type* a, value_type* out, size_t n) {
+            size_t i = 0;
+            for(; i + TOPS::lanes <= n; i += TOPS::lanes) TOPS::store(out + i, TOPS::log2(TOPS::load(a + i)));
+            scalar_type::ilog2(a + i, out + i, n - i);
+        }
+        static void ilog10(const value_type* a, value_type* out, size_t n) {
+            const reg one = TOPS::set1(1), c1233 = TOPS::set1(1233);
+            size_t i = 0;
+            for(; i + TOPS::lanes <= n; i += TOPS::lanes) {
+                const reg x = TOPS::or_(TOPS::load(a + i), one);
+                const reg t = TOPS::srli(TOPS::mul_small(TOPS::add(TOPS::log2(x), one), c1233), 12);
+                TOPS::store(out + i, TOPS::add(t, TOPS::lt(x, TOPS::pow10(t))));
+            }
+            scalar_type::ilog10(a + i, out + i, n - i);
+        }
+        static void isqrt(const value_type* a, value_type* out, size_t n) {
+            const reg one = TOPS::set1(1), limit = TOPS::set1(value_type(TOPS::max_root) + 1);
+            size_t i = 0;
+            for(; i + TOPS::lanes <= n; i += TOPS::lanes) {
+                const reg x = TOPS::load(a + i);
+                reg r = TOPS::sqrt_est(x);
+                r = TOPS::add(r, TOPS::lt(x, TOPS::mul_small(r, r)));
+                // The square of max_root + 1 wraps, that lane must not step up.
+                const reg r1 = TOPS::add(r, one);
+                const reg stay = TOPS::or_(TOPS::lt(x, TOPS::mul_small(r1, r1)), TOPS::eq(r1, limit));
+                TOPS::store(out + i, TOPS::sub(r, TOPS::andnot(stay, TOPS::set1(value_type(-1)))));
+            }
+            scalar_type::isqrt(a + i, out + i, n - i);
+        }
+        static size_t ipow(const value_type* a, uint32_t e, value_type* out, size_t n) {
+            const reg ones = TOPS::set1(value_type(-1)), zero = TOPS::set1(0);
+            size_t _result = 0, i = 0;
+            for(; i + TOPS::lanes <= n; i += TOPS::lanes) {
+                reg x = TOPS::load(a + i), r = TOPS::set1(1), ovf = zero;
+                for(uint32_t k = e;;) {
+                    if(k & 1u) {
+                        ovf = TOPS::or_(ovf, TOPS::mul_ovf(r, x));
+                        r = TOPS::mul(r, x);
+                    }
+                    k >>= 1;
+                    if(k == 0) break;
+                    // A square that overflows is a factor of the result, which overflows too.
+                    ovf = TOPS::or_(ovf, TOPS::mul_ovf(x, x));
+                    x = TOPS::mul(x, x);
+                }
+                const reg sat = TOPS::andnot(TOPS::eq(ovf, zero), ones);
+                TOPS::store(out + i, TOPS::or_(r, sat));
+                _result += TOPS::count(sat);
+            }
+            return _result + scalar_type::ipow(a + i, e, out + i, n - i);
+        }
+    };
+
+#ifdef __SSE4_1__
+    /**
+     * @brief Specialization for SSE technique, 32-bit lanes
+     */
+    template <>
+    struct intmath_kernel<uint32_t, techn_type::SSE> : intmath_kernel_simd<intmath_ops_sse32> { };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief Specialization for AVX technique, 32-bit lanes
+     */
+    template <>
+    struct intmath_kernel<uint32_t, techn_type::AVX> : intmath_kernel_simd<intmath_ops_avx32> { };
+    /**
+     * @brief Specialization for AVX technique, 64-bit lanes
+     */
+    template <>
+    struct intmath_kernel<uint64_t, techn_type::AVX> : intmath_kernel_simd<intmath_ops_avx64> { };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <typename TINT>
+    struct intmath_kernel<TINT, techn_type::AVX512, typename std::enable_if<std::is_same<TINT, uint32_t>::value || std::is_same<TINT, uint64_t>::value>::type>
+        : intmath_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,406 @@
+/**
+ * @file kernel_mod.h
+ * @brief Header file for divide free modular reduction and the batched modular kernels.
+ *
+ * This file defines `barrett_reducer`, which reduces a product modulo a fixed modulus
+ * with a multiplication by the precomputed reciprocal instead of a hardware divide, and
+ * `mod_kernel`, the lane-wise modular add, sub, mul and reduce over arrays of uint32.
+ * The SSE/AVX kernels use Montgomery reduction, which needs nothing but the 32x32->64
+ * bit `pmuludq` (`_mm_mul_epu32`), for odd moduli below 2^31; other moduli and the
+ * scalar technique use the Barrett reducer.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_MOD_H
+#define ADAPTIVE_KERNEL_MOD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Full 128-bit product of `a` and `b`, returns the low half and stores the high half in `hi`.
+     */
+    inline uint64_t mul_wide_u64(uint64_t a, uint64_t b, uint64_t& hi) noexcept {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+        hi = static_cast<uint64_t>(p >> 64);
+        return static_cast<uint64_t>(p);
+#else
+        const uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32, b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+        const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        const uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+        hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        return (mid << 32) | (p00 & 0xFFFFFFFFu);
+#endif
+    }
+    /**
+     * @brief High 64 bits of the product of `a` and `b`.
+     */
+    inline uint64_t mulhi_u64(uint64_t a, uint64_t b) noexcept {
+        uint64_t _hi;
+        mul_wide_u64(a, b, _hi);
+        return _hi;
+    }
+
+    /**
+     * @class barrett_reducer
+     * @brief Modular arithmetic for a fixed modulus `m >= 2` without divides.
+     *
+     * Stores `mu = floor((2^(2w) - 1) / m)` for the word width `w` (64 bits for moduli up
+     * to 32 bits, 128 bits for 64-bit moduli). The quotient `floor(x * mu / 2^(2w))`
+     * underestimates `x / m` by at most a few units, which a few conditional subtractions fix.
+     * All operands of add and sub must already be reduced, `reduce` accepts any value; mul
+     * needs reduced operands for 64-bit moduli and accepts any operands up to 32 bits.
+     *
+     * @tparam TINT The unsigned type of the modulus and the values.
+     */
+    template <typename TINT>
+    class barrett_reducer {
+        static_assert(std::is_unsigned<TINT>::value && sizeof(TINT) <= 8, "barrett_reducer: unsigned integer up to 64 bits");
+    public:
+        using this_type = barrett_reducer<TINT>;
+        using value_type = TINT;
+
+        /**
+         * @brief Constructor, precomputes the reciprocal of `m`
+         *
+         * @throw std::invalid_argument if `m` is smaller than 2
+         */
+        constexpr explicit barrett_reducer(value_type m)
+            : m_tiModulus(m), m_uMuHi(0), m_uMuLo(0) {
+            if(m < 2) throw std::invalid_argument("barrett_reducer: modulus must be at least 2");
+            if constexpr (sizeof(TINT) <= 4) {
+                m_uMuLo = UINT64_MAX / m;
+            } else {
+                // (2^128 - 1) / m by long division, the low word only consists of one bits.
+                m_uMuHi = UINT64_MAX / m;
+                uint64_t _rem = UINT64_MAX % m;
+                for(int i = 0; i < 64; ++i) {
+                    const bool carry = (_rem >> 63) != 0;
+                    _rem = (_rem << 1) | 1;
+                    m_uMuLo <<= 1;
+                    if(carry || _rem >= m) { _rem -= m; m_uMuLo |= 1; }
+                }
+            }
+        }
+
+        constexpr value_type modulus() const noexcept { return m_tiModulus; }
+
+        /**
+         * @brief `x mod m` for any `x`
+         */
+        value_type reduce(value_type x) const noexcept {
+            if constexpr (sizeof(TINT) <= 4) return reduce_wide(x);
+            else return reduce_wide(0, x);
+        }
+        value_type add(value_type a, value_type b) const noexcept {
+            const value_type _result = value_type(a + b);
+            return (_result < a || _result >= m_tiModulus) ? value_type(_result - m_tiModulus) : _result;
+        }
+        value_type sub(value_type a, value_type b) const noexcept {
+            return a >= b ? value_type(a - b) : value_type(m_tiModulus - (b - a));
+        }
+        value_type neg(value_type a) const noexcept {
+            return a == 0 ? 0 : value_type(m_tiModulus - a);
+        }
+        value_type mul(value_type a, value_type b) const noexcept {
+            if constexpr (sizeof(TINT) <= 4) {
+                return reduce_wide(uint64_t(a) * b);
+            } else {
+                uint64_t _hi;
+                const uint64_t _lo = mul_wide_u64(a, b, _hi);
+                return reduce_wide(_hi, _lo);
+            }
+        }
+        /**
+         * @brief `a^e mod m` by square and multiply, `0^0` is 1
+         */
+        value_type pow(value_type a, uint64_t e) const noexcept {
+            value_type _result = reduce(1);
+            for(; e != 0; e >>= 1) {
+                if(e & 1) _result = mul(_result, a);
+                a = mul(a, a);
+            }
+            return _result;
+        }
+
+        bool operator == (const this_type& o) const noexcept { return m_tiModulus == o.m_tiModulus; }
+        bool operator != (const this_type& o) const noexcept { return m_tiModulus != o.m_tiModulus; }
+
+    protected:
+        /**
+         * @brief `x mod m` for a 64-bit `x`, moduli up to 32 bits
+         */
+        value_type reduce_wide(uint64_t x) const noexcept {
+            uint64_t _r = x - mulhi_u64(x, m_uMuLo) * m_tiModulus;
+            while(_r >= m_tiModulus) _r -= m_tiModulus;
+            return value_type(_r);
+        }
+        /**
+         * @brief `x mod m` for the 128-bit `x = hi:lo < m^2`, 64-bit moduli
+         */
+        value_type reduce_wide(uint64_t hi, uint64_t lo) const noexcept {
+            // The quotient is below m < 2^64, the dropped low x low product only costs one unit.
+            const uint64_t q = hi * m_uMuHi + mulhi_u64(hi, m_uMuLo) + mulhi_u64(lo, m_uMuHi);
+            uint64_t _qhi;
+            const uint64_t _qlo = mul_wide_u64(q, m_tiModulus, _qhi);
+            uint64_t _r = lo - _qlo;
+            uint64_t _rhi = hi - _qhi - (lo < _qlo ? 1 : 0);
+            while(_rhi != 0 || _r >= m_tiModulus) {
+                _rhi -= (_r < m_tiModulus ? 1 : 0);
+                _r -= m_tiModulus;
+            }
+            return value_type(_r);
+        }
+
+    protected:
+        value_type m_tiModulus;
+        uint64_t m_uMuHi;
+        uint64_t m_uMuLo;
+    };
+
+    /**
+     * @brief Montgomery constants for an odd 32-bit modulus and `R = 2^32`.
+     */
+    struct montgomery32 {
+        uint32_t m;
+        uint32_t ninv;  ///< `-m^-1 mod R`
+        uint32_t r1;    ///< `R mod m`
+        uint32_t r2;    ///< `R^2 mod m`
+
+        /**
+         * @brief Returns true for the moduli the SIMD kernels handle: odd and below 2^31
+         */
+        static bool supported(uint32_t mod) noexcept { return (mod & 1) != 0 && mod < (1u << 31); }
+
+        explicit montgomery32(uint32_t mod) noexcept : m(mod) {
+            uint32_t inv = mod;                             // correct to 3 bits for an odd modulus
+            for(int i = 0; i < 4; ++i) inv *= 2 - mod * inv; // Newton, doubles the correct bits
+            ninv = 0u - inv;
+            // Once per batch, not per element.
+            r1 = uint32_t((uint64_t(1) << 32) % mod);
+            r2 = uint32_t(uint64_t(r1) * r1 % mod);
+        }
+    };
+
+    /**
+     * @class mod_kernel
+     * @brief Scalar modular kernels over uint32 arrays, used for every technique without a specialization.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct mod_kernel {
+        using reducer_type = barrett_reducer<uint32_t>;
+
+        /**
+         * @brief `out[i] = a[i] mod m`, any `a[i]`.
+         */
+        static void reduce(const uint32_t* a, uint32_t* out, size_t n, const reducer_type& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = r.reduce(a[i]);
+        }
+        /**
+         * @brief `out[i] = (a[i] + b[i]) mod m`, reduced inputs.
+         */
+        static void add(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = r.add(a[i], b[i]);
+        }
+        /**
+         * @brief `out[i] = (a[i] - b[i]) mod m`, reduced inputs.
+         */
+        static void sub(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = r.sub(a[i], b[i]);
+        }
+        /**
+         * @brief `out[i] = a[i] * b[i] mod m`, any `a[i]`, reduced `b[i]`.
+         *
+         * The 32-bit reducer handles any 64-bit product, so `a[i]` needs no reduction first.
+         */
+        static void mul(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = r.mul(a[i], b[i]);
+        }
+        /**
+         * @brief `out[i] = a[i] * c mod m`, any `a[i]`, reduced `c`.
+         */
+        static void scale(const uint32_t* a, uint32_t c, uint32_t* out, size_t n, const reducer_type& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = r.mul(a[i], c);
+        }
+    };
+
+#ifdef __SSE4_1__
+    /**
+     * @brief SSE4.1 register operations of the Montgomery kernels, four uint32 lanes.
+     */
+    struct mod_ops_sse {
+        static constexpr size_t lanes = 4;
+        using reg = __m128i;
+
+        static reg load(const uint32_t* p)     { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(uint32_t* p, reg v)  { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg set1(uint32_t v)            { return _mm_set1_epi32(int(v)); }
+        static reg add(reg a, reg b)           { return _mm_add_epi32(a, b); }
+        static reg sub(reg a, reg b)           { return _mm_sub_epi32(a, b); }
+        static reg min(reg a, reg b)           { return _mm_min_epu32(a, b); }
+        static reg mul_even(reg a, reg b)      { return _mm_mul_epu32(a, b); }
+        static reg add64(reg a, reg b)         { return _mm_add_epi64(a, b); }
+        static reg odd(reg v)                  { return _mm_srli_epi64(v, 32); }
+        /**
+         * @brief Packs the high halves of the 64-bit lanes of `even` and `odd` into 32-bit lanes
+         */
+        static reg merge(reg even, reg odd)    { return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC); }
+    };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief AVX2 register operations of the Montgomery kernels, eight uint32 lanes.
+     */
+    struct mod_ops_avx {
+        static constexpr size_t lanes = 8;
+        using reg = __m256i;
+
+        static reg load(const uint32_t* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(uint32_t* p, reg v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg set1(uint32_t v)            { return _mm256_set1_epi32(int(v)); }
+        static reg add(reg a, reg b)           { return _mm256_add_epi32(a, b); }
+        static reg sub(reg a, reg b)           { return _mm256_sub_epi32(a, b); }
+        static reg min(reg a, reg b)           { return _mm256_min_epu32(a, b); }
+        static reg mul_even(reg a, reg b)      { return _mm256_mul_epu32(a, b); }
+        static reg add64(reg a, reg b)         { return _mm256_add_epi64(a, b); }
+        static reg odd(reg v)                  { return _mm256_srli_epi64(v, 32); }
+        static reg merge(reg even, reg odd)    { return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA); }
+    };
+#endif
+
+    /**
+     * @class mod_kernel_simd
+     * @brief Montgomery kernels written once over the register operations `TOPS`.
+     *
+     * Values stay in the normal representation. `redc(t) = t * R^-1 mod m` (below `2m`)
+     * is computed in the 64-bit lanes with two `pmuludq`, the result lands in the high
+     * half of every lane; even and odd uint32 lanes are handled in separate registers
+     * and merged with one blend. A product `a * b` takes two reductions, `redc(redc(a * b) * R^2)`,
+     * reduce and scale only one, `redc(a * (c * R mod m))`.
+     */
+    template <typename TOPS>
+    struct mod_kernel_simd {
+        using reg = typename TOPS::reg;
+        using reducer_type = barrett_reducer<uint32_t>;
+        using scalar_type = mod_kernel<techn_type::Scalar>;
+
+        static void reduce(const uint32_t* a, uint32_t* out, size_t n, const reducer_type& r) {
+            if(!montgomery32::supported(r.modulus())) return scalar_type::reduce(a, out, n, r);
+            const montgomery32 mg(r.modulus());
+            const size_t full = n - n % TOPS::lanes;
+            scale_range(a, mg.r1, out, full, mg);
+            scalar_type::reduce(a + full, out + full, n - full, r);
+        }
+        static void scale(const uint32_t* a, uint32_t c, uint32_t* out, size_t n, const reducer_type& r) {
+            if(!montgomery32::supported(r.modulus())) return scalar_type::scale(a, c, out, n, r);
+            const montgomery32 mg(r.modulus());
+            const size_t full = n - n % TOPS::lanes;
+            scale_range(a, r.mul(c, mg.r1), out, full, mg);
+            scalar_type::scale(a + full, c, out + full, n - full, r);
+        }
+        static void mul(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            if(!montgomery32::supported(r.modulus())) return scalar_type::mul(a, b, out, n, r);
+            const montgomery32 mg(r.modulus());
+            const reg m = TOPS::set1(mg.m), ninv = TOPS::set1(mg.ninv), r2 = TOPS::set1(mg.r2);
+            const size_t full = n - n % TOPS::lanes;
+
+            for(size_t i = 0; i < full; i += TOPS::lanes) {
+                const reg va = TOPS::load(a + i), vb = TOPS::load(b + i);
+                reg te = redc(TOPS::mul_even(va, vb), m, ninv);
+                reg to = redc(TOPS::mul_even(TOPS::odd(va), TOPS::odd(vb)), m, ninv);
+                te = redc(TOPS::mul_even(TOPS::odd(te), r2), m, ninv);
+                to = redc(TOPS::mul_even(TOPS::odd(to), r2), m, ninv);
+                TOPS::store(out + i, csub(TOPS::merge(te, to), m));
+            }
+            scalar_type::mul(a + full, b + full, out + full, n - full, r);
+        }
+        static void add(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            if(r.modulus() > (1u << 31)) return scalar_type::add(a, b, out, n, r);
+            const reg m = TOPS::set1(r.modulus());
+            const size_t full = n - n % TOPS::lanes;
+
+            for(size_t i = 0; i < full; i += TOPS::lanes)
+                TOPS::store(out + i, csub(TOPS::add(TOPS::load(a + i), TOPS::load(b + i)), m));
+            scalar_type::add(a + full, b + full, out + full, n - full, r);
+        }
+        static void sub(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t n, const reducer_type& r) {
+            if(r.modulus() > (1u << 31)) return scalar_type::sub(a, b, out, n, r);
+            const reg m = TOPS::set1(r.modulus());
+            const size_t full = n - n % TOPS::lanes;
+
+            for(size_t i = 0; i < full; i += TOPS::lanes) {
+                // a - b wraps to a huge value when b > a, adding m brings it below m.
+                const reg d = TOPS::sub(TOPS::load(a + i), TOPS::load(b + i));
+                TOPS::store(out + i, TOPS::min(d, TOPS::add(d, m)));
+            }
+            scalar_type::sub(a + full, b + full, out + full, n - full, r);
+        }
+
+    protected:
+        /**
+         * @brief `t + ((t * ninv) mod R) * m`, its high half is `t * R^-1 mod m` plus at most `m`
+         */
+        static reg redc(reg t, reg m, reg ninv) {
+            return TOPS::add64(t, TOPS::mul_even(TOPS::mul_even(t, ninv), m));
+        }
+        /**
+         * @brief Maps `[0, 2m)` to `[0, m)`, `v - m` wraps above `v` if `v < m`
+         */
+        static reg csub(reg v, reg m) { return TOPS::min(v, TOPS::sub(v, m)); }
+
+        /**
+         * @brief `out[i] = redc(a[i] * c)` for the first `n` elements, a multiple of the lanes
+         */
+        static void scale_range(const uint32_t* a, uint32_t c, uint32_t* out, size_t n, const montgomery32& mg) {
+            const reg m = TOPS::set1(mg.m), ninv = TOPS::set1(mg.ninv), vc = TOPS::set1(c);
+            for(size_t i = 0; i < n; i += TOPS::lanes) {
+                const reg va = TOPS::load(a + i);
+                const reg te = redc(TOPS::mul_even(va, vc), m, ninv);
+                const reg to = redc(TOPS::mul_even(TOPS::odd(va), vc), m, ninv);
+                TOPS::store(out + i, csub(TOPS::merge(te, to), m));
+            }
+        }
+    };
+
+#ifdef __SSE4_1__
+    /**
+     * @brief Specialization for SSE technique
+     */
+    template <>
+    struct mod_kernel<techn_type::SSE> : mod_kernel_simd<mod_ops_sse> { };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief Specialization for AVX technique
+     */
+    template <>
+    struct mod_kernel<techn_type::AVX> : mod_kernel_simd<mod_ops_avx> { };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <>
+    struct mod_kernel<techn_type::AVX512> : mod_kernel<techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,448 @@
+/**
+ * @file kernel_ntt.h
+ * @brief Header file for the number-theoretic transform kernels.
+ *
+ * This file defines `ntt_field`, the Montgomery arithmetic modulo an NTT prime, and
+ * `ntt_kernel`, the in-place forward (decimation in frequency, natural order in,
+ * bit-reversed order out) and inverse (decimation in time, bit-reversed in, natural out)
+ * transforms. Two radix-2 stages are fused into one radix-4 pass over the data, the
+ * stages narrower than a register run together in registers, and once a block of
+ * `ADAPTIVE_NTT_BLOCK_BYTES` holds all remaining butterflies it is finished depth
+ * first while it is in cache. The butterflies are written once over the
+ * register operations; 32-bit primes get SSE/AVX Montgomery multiplies on `pmuludq`,
+ * 64-bit primes stay scalar since neither instruction set has a 64x64 bit multiply.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_NTT_H
+#define ADAPTIVE_KERNEL_NTT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+#include "kernel_mod.h"
+
+/**
+ * @brief Bytes of the blocks that are transformed depth first once they fit.
+ */
+#ifndef ADAPTIVE_NTT_BLOCK_BYTES
+#define ADAPTIVE_NTT_BLOCK_BYTES 16384
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class ntt_field
+     * @brief Montgomery arithmetic modulo an odd prime `p`, `R = 2^32` or `2^64`.
+     *
+     * Values are kept fully reduced in `[0, p)`. `mul(a, b)` returns `a * b * R^-1`, so a
+     * twiddle stored as `w * R` (`to_mont`) multiplies by `w` itself. 32-bit primes must
+     * be below 2^30 to leave the SIMD lanes headroom, 64-bit primes may use all bits.
+     *
+     * @tparam TINT uint32_t or uint64_t.
+     */
+    template <typename TINT>
+    struct ntt_field {
+        static_assert(std::is_same<TINT, uint32_t>::value || std::is_same<TINT, uint64_t>::value,
+                      "ntt_field: uint32_t or uint64_t");
+
+        TINT p;
+        TINT pinv;  ///< `p^-1 mod R`
+        TINT r2;    ///< `R^2 mod p`
+
+        explicit ntt_field(TINT prime) noexcept : p(prime), pinv(prime) {
+            for(int i = 0; i < 6; ++i) pinv *= TINT(2) - prime * pinv;
+            const barrett_reducer<TINT> _red(prime);
+            const TINT r1 = _red.reduce(TINT(0) - prime); // R - p = R mod p
+            r2 = _red.mul(r1, r1);
+        }
+
+        // The butterfly operands are random, so the conditional corrections are masks, not branches.
+        TINT add(TINT a, TINT b) const noexcept {
+            const TINT _s = TINT(a + b);
+            return TINT(_s - (p & (TINT(0) - TINT((_s < a) | (_s >= p)))));
+        }
+        TINT sub(TINT a, TINT b) const noexcept {
+            const TINT _d = TINT(a - b);
+            return TINT(_d + (p & (TINT(0) - TINT(a < b))));
+        }
+        /**
+         * @brief `a * b * R^-1 mod p` for `a * b < p * R`
+         */
+        TINT mul(TINT a, TINT b) const noexcept {
+            // (t - u * p) / R with u = t * p^-1 mod R, the low halves cancel exactly.
+            TINT th, uh;
+            if constexpr (sizeof(TINT) == 4) {
+                const uint64_t t = uint64_t(a) * b;
+                const uint32_t u = uint32_t(t) * pinv;
+                th = uint32_t(t >> 32);
+                uh = uint32_t((uint64_t(u) * p) >> 32);
+            } else {
+                const uint64_t tl = mul_wide_u64(a, b, th);
+                uh = mulhi_u64(tl * pinv, p);
+            }
+            return TINT(th - uh + (p & (TINT(0) - TINT(th < uh))));
+        }
+        TINT to_mont(TINT a) const noexcept { return mul(a, r2); }
+    };
+
+    /**
+     * @brief Scalar register operations of the butterflies, one lane.
+     */
+    template <typename TINT>
+    struct ntt_ops_scalar {
+        static constexpr size_t lanes = 1;
+        using reg = TINT;
+
+        explicit ntt_ops_scalar(const ntt_field<TINT>& f) noexcept : field(f) { }
+
+        reg load(const TINT* p) const noexcept     { return *p; }
+        void store(TINT* p, reg v) const noexcept  { *p = v; }
+        reg set1(TINT v) const noexcept            { return v; }
+        reg add(reg a, reg b) const noexcept       { return field.add(a, b); }
+        reg sub(reg a, reg b) const noexcept       { return field.sub(a, b); }
+        reg mul(reg a, reg b) const noexcept       { return field.mul(a, b); }
+
+        ntt_field<TINT> field;
+    };
+
+#ifdef __SSE4_1__
+    /**
+     * @brief Splits two SSE registers into the operands of the butterflies of half size `h < 4`
+     *
+     * `split` gathers the first elements of every pair of `r0` and `r1` into `x` and the
+     * second ones into `y`, element `i` of `x` always has the position `i mod h` in its
+     * block; `join` is the inverse.
+     */
+    struct ntt_shuffle_sse {
+        static void split(__m128i r0, __m128i r1, size_t h, __m128i& x, __m128i& y) {
+            if(h == 2) {
+                x = _mm_unpacklo_epi64(r0, r1);
+                y = _mm_unpackhi_epi64(r0, r1);
+            } else {
+                x = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(r0), _mm_castsi128_ps(r1), _MM_SHUFFLE(2, 0, 2, 0)));
+                y = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(r0), _mm_castsi128_ps(r1), _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+        }
+        static void join(__m128i x, __m128i y, size_t h, __m128i& r0, __m128i& r1) {
+            if(h == 2) {
+                r0 = _mm_unpacklo_epi64(x, y);
+                r1 = _mm_unpackhi_epi64(x, y);
+            } else {
+                r0 = _mm_unpacklo_epi32(x, y);
+                r1 = _mm_unpackhi_epi32(x, y);
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief Splits two AVX registers into the operands of the butterflies of half size `h < 8`, see `ntt_shuffle_sse`
+     */
+    struct ntt_shuffle_avx {
+        static void split(__m256i r0, __m256i r1, size_t h, __m256i& x, __m256i& y) {
+            if(h == 4) {
+                x = _mm256_permute2x128_si256(r0, r1, 0x20);
+                y = _mm256_permute2x128_si256(r0, r1, 0x31);
+            } else if(h == 2) {
+                x = _mm256_unpacklo_epi64(r0, r1);
+                y = _mm256_unpackhi_epi64(r0, r1);
+            } else {
+                x = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(r0), _mm256_castsi256_ps(r1), _MM_SHUFFLE(2, 0, 2, 0)));
+                y = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(r0), _mm256_castsi256_ps(r1), _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+        }
+        static void join(__m256i x, __m256i y, size_t h, __m256i& r0, __m256i& r1) {
+            if(h == 4) {
+                r0 = _mm256_permute2x128_si256(x, y, 0x20);
+                r1 = _mm256_permute2x128_si256(x, y, 0x31);
+            } else if(h == 2) {
+                r0 = _mm256_unpacklo_epi64(x, y);
+                r1 = _mm256_unpackhi_epi64(x, y);
+            } else {
+                r0 = _mm256_unpacklo_epi32(x, y);
+                r1 = _mm256_unpackhi_epi32(x, y);
+            }
+        }
+    };
+#endif
+
+    /**
+     * @brief SIMD register operations of the butterflies for 32-bit primes below 2^30
+     *
+     * @tparam TOPS The lane operations of the modular kernels, `mod_ops_sse` or `mod_ops_avx`.
+     * @tparam TSHUF The lane shuffles for the stages narrower than a register.
+     */
+    template <typename TOPS, typename TSHUF>
+    struct ntt_ops_simd : TSHUF {
+        static constexpr size_t lanes = TOPS::lanes;
+        using reg = typename TOPS::reg;
+
+        explicit ntt_ops_simd(const ntt_field<uint32_t>& f) noexcept
+            : p(TOPS::set1(f.p)), ninv(TOPS::set1(0u - f.pinv)) { }
+
+        reg load(const uint32_t* ptr) const noexcept    { return TOPS::load(ptr); }
+        void store(uint32_t* ptr, reg v) const noexcept { TOPS::store(ptr, v); }
+        reg set1(uint32_t v) const noexcept             { return TOPS::set1(v); }
+        reg add(reg a, reg b) const noexcept            { return csub(TOPS::add(a, b)); }
+        reg sub(reg a, reg b) const noexcept {
+            const reg d = TOPS::sub(a, b);
+            return TOPS::min(d, TOPS::add(d, p));
+        }
+        /**
+         * @brief `a * b * R^-1`: `(t + ((t * -p^-1) mod R) * p) / R` in the even and odd 64-bit lanes
+         */
+        reg mul(reg a, reg b) const noexcept {
+            const reg te = redc(TOPS::mul_even(a, b));
+            const reg to = redc(TOPS::mul_even(TOPS::odd(a), TOPS::odd(b)));
+            return csub(TOPS::merge(te, to));
+        }
+
+        reg p;
+        reg ninv;
+
+    protected:
+        reg redc(reg t) const noexcept { return TOPS::add64(t, TOPS::mul_even(TOPS::mul_even(t, ninv), p)); }
+        reg csub(reg v) const noexcept { return TOPS::min(v, TOPS::sub(v, p)); }
+    };
+
+    /**
+     * @brief Selects the register operations of `ntt_kernel`, scalar unless specialized.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct ntt_simd_ops {
+        using type = ntt_ops_scalar<TINT>;
+    };
+#ifdef __SSE4_1__
+    template <>
+    struct ntt_simd_ops<uint32_t, techn_type::SSE> {
+        using type = ntt_ops_simd<mod_ops_sse, ntt_shuffle_sse>;
+    };
+#endif
+#ifdef __AVX2__
+    template <>
+    struct ntt_simd_ops<uint32_t, techn_type::AVX> {
+        using type = ntt_ops_simd<mod_ops_avx, ntt_shuffle_avx>;
+    };
+#endif
+#ifdef __AVX512__
+    template <>
+    struct ntt_simd_ops<uint32_t, techn_type::AVX512> : ntt_simd_ops<uint32_t, techn_type::AVX> { };
+#endif
+
+    /**
+     * @class ntt_kernel
+     * @brief In-place transforms of power of two length over a precomputed twiddle table.
+     *
+     * The twiddle table `tw` holds `w_(2h)^j * R mod p` at `tw[h + j]` for every stage
+     * half size `h` and `j < h`, `w_(2h)` being a primitive `2h`-th root of unity; the
+     * inverse transform takes the table of the inverse roots.
+     *
+     * @tparam TINT uint32_t or uint64_t.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct ntt_kernel {
+        using simd_type = typename ntt_simd_ops<TINT, TTECH>::type;
+        using scalar_type = ntt_ops_scalar<TINT>;
+
+        static constexpr size_t block = ADAPTIVE_NTT_BLOCK_BYTES / sizeof(TINT);
+
+        /**
+         * @brief Forward transform of `a[0, n)`, the result is in bit-reversed order
+         */
+        static void forward(const ntt_field<TINT>& f, TINT* a, size_t n, const TINT* tw) {
+            const simd_type vop(f);
+            const scalar_type sop(f);
+            size_t h = n / 2;
+            for(; h >= 1 && 2 * h > block; ) h = dif_pass(vop, sop, a, n, h, tw);
+            if(h >= 1)
+                for(size_t b = 0; b < n; b += 2 * h)
+                    for(size_t bh = h; bh >= 1; ) bh = dif_pass(vop, sop, a + b, 2 * h, bh, tw);
+        }
+        /**
+         * @brief Inverse transform of the bit-reversed `a[0, n)` with the inverse table `itw`,
+         * every result is multiplied by `scale` (in Montgomery form)
+         */
+        static void inverse(const ntt_field<TINT>& f, TINT* a, size_t n, const TINT* itw, TINT scale) {
+            const simd_type vop(f);
+            const scalar_type sop(f);
+            size_t h = 1;
+            const size_t leaf = n < block ? n : block;
+            for(size_t b = 0; b < n; b += leaf)
+                for(h = 1; 2 * h <= leaf; ) h = dit_pass(vop, sop, a + b, leaf, h, leaf, itw);
+            while(2 * h <= n) h = dit_pass(vop, sop, a, n, h, n, itw);
+            pointwise(f, a, nullptr, n, scale);
+        }
+        /**
+         * @brief `a[i] = a[i] * b[i] * R^-1`, or `a[i] * c * R^-1` without `b`
+         */
+        static void pointwise(const ntt_field<TINT>& f, TINT* a, const TINT* b, size_t n, TINT c) {
+            const simd_type vop(f);
+            const scalar_type sop(f);
+            const size_t full = n - n % simd_type::lanes;
+            pointwise_range(vop, a, b, 0, full, c);
+            pointwise_range(sop, a, b, full, n, c);
+        }
+
+    protected:
+        /**
+         * @brief One DIF pass over `a[0, n)` starting at half size `h`, returns the next half size
+         *
+         * Two stages are fused into a radix-4 pass while the quarter is a full register; the
+         * stages narrower than a register all run in registers in one pass.
+         */
+        static size_t dif_pass(const simd_type& vop, const scalar_type& sop, TINT* a, size_t n, size_t h, const TINT* tw) {
+            if(n < 2 * simd_type::lanes) {
+                if(h >= 2) { dif_radix4(sop, a, n, h / 2, tw); return h / 4; }
+                dif_radix2(sop, a, n, h, tw);
+                return 0;
+            }
+            if(h / 2 >= simd_type::lanes) { dif_radix4(vop, a, n, h / 2, tw); return h / 4; }
+            if(h >= simd_type::lanes) { dif_radix2(vop, a, n, h, tw); return h / 2; }
+            narrow_pass<true>(vop, a, n, h, tw);
+            return 0;
+        }
+        /**
+         * @brief One DIT pass over blocks of `len` starting at half size `h`, returns the next half size
+         */
+        static size_t dit_pass(const simd_type& vop, const scalar_type& sop, TINT* a, size_t n, size_t h, size_t len,
+                               const TINT* itw) {
+            if(n < 2 * simd_type::lanes) {
+                if(4 * h <= len) { dit_radix4(sop, a, n, h, itw); return 4 * h; }
+                dit_radix2(sop, a, n, h, itw);
+                return 2 * h;
+            }
+            if(h < simd_type::lanes) {
+                narrow_pass<false>(vop, a, n, simd_type::lanes / 2, itw);
+                return simd_type::lanes;
+            }
+            if(4 * h <= len) { dit_radix4(vop, a, n, h, itw); return 4 * h; }
+            dit_radix2(vop, a, n, h, itw);
+            return 2 * h;
+        }
+
+        /**
+         * @brief The stages of half size `top` down to 1 (DIF) or 1 up to `top` (DIT), all below
+         * the register width, on pairs of registers without storing in between
+         */
+        template <bool TDIF, typename TOPS>
+        static void narrow_pass(const TOPS& op, TINT* a, size_t n, size_t top, const TINT* tw) {
+            if constexpr (TOPS::lanes > 1) {
+                using reg = typename TOPS::reg;
+                // The twiddles of every stage in the order of the split registers.
+                reg w[TOPS::lanes];
+                for(size_t h = 2; h <= top; h *= 2) {
+                    alignas(64) TINT _tw[TOPS::lanes];
+                    for(size_t i = 0; i < TOPS::lanes; ++i) _tw[i] = tw[h + i % h];
+                    w[h] = op.load(_tw);
+                }
+                for(size_t s = 0; s < n; s += 2 * TOPS::lanes) {
+                    reg r0 = op.load(a + s), r1 = op.load(a + s + TOPS::lanes), x, y;
+                    if constexpr (TDIF) {
+                        for(size_t h = top; h >= 1; h /= 2) {
+                            op.split(r0, r1, h, x, y);
+                            const reg d = op.sub(x, y);
+                            op.join(op.add(x, y), h == 1 ? d : op.mul(d, w[h]), h, r0, r1);
+                        }
+                    } else {
+                        for(size_t h = 1; h <= top; h *= 2) {
+                            op.split(r0, r1, h, x, y);
+                            if(h > 1) y = op.mul(y, w[h]);
+                            op.join(op.add(x, y), op.sub(x, y), h, r0, r1);
+                        }
+                    }
+                    op.store(a + s, r0);
+                    op.store(a + s + TOPS::lanes, r1);
+                }
+            } else {
+                (void)op; (void)a; (void)n; (void)top; (void)tw;
+            }
+        }
+
+        /**
+         * @brief `(x, y) -> (x + y, (x - y) * w)` at half size `h`
+         */
+        template <typename TOPS>
+        static void dif_radix2(const TOPS& op, TINT* a, size_t n, size_t h, const TINT* tw) {
+            for(size_t s = 0; s < n; s += 2 * h)
+                for(size_t j = 0; j < h; j += TOPS::lanes) {
+                    const auto x = op.load(a + s + j), y = op.load(a + s + j + h);
+                    op.store(a + s + j, op.add(x, y));
+                    op.store(a + s + j + h, op.mul(op.sub(x, y), op.load(tw + h + j)));
+                }
+        }
+        /**
+         * @brief The DIF stages of half size `2q` and `q` in one pass over blocks of `4q`
+         */
+        template <typename TOPS>
+        static void dif_radix4(const TOPS& op, TINT* a, size_t n, size_t q, const TINT* tw) {
+            for(size_t s = 0; s < n; s += 4 * q) {
+                TINT* p = a + s;
+                for(size_t j = 0; j < q; j += TOPS::lanes) {
+                    const auto x0 = op.load(p + j), x1 = op.load(p + j + q);
+                    const auto x2 = op.load(p + j + 2 * q), x3 = op.load(p + j + 3 * q);
+                    const auto w1 = op.load(tw + q + j);
+                    const auto a0 = op.add(x0, x2), a1 = op.add(x1, x3);
+                    const auto a2 = op.mul(op.sub(x0, x2), op.load(tw + 2 * q + j));
+                    const auto a3 = op.mul(op.sub(x1, x3), op.load(tw + 3 * q + j));
+                    op.store(p + j, op.add(a0, a1));
+                    op.store(p + j + q, op.mul(op.sub(a0, a1), w1));
+                    op.store(p + j + 2 * q, op.add(a2, a3));
+                    op.store(p + j + 3 * q, op.mul(op.sub(a2, a3), w1));
+                }
+            }
+        }
+        /**
+         * @brief `(x, y) -> (x + y * w, x - y * w)` at half size `h`
+         */
+        template <typename TOPS>
+        static void dit_radix2(const TOPS& op, TINT* a, size_t n, size_t h, const TINT* itw) {
+            for(size_t s = 0; s < n; s += 2 * h)
+                for(size_t j = 0; j < h; j += TOPS::lanes) {
+                    const auto x = op.load(a + s + j), y = op.mul(op.load(a + s + j + h), op.load(itw + h + j));
+                    op.store(a + s + j, op.add(x, y));
+                    op.store(a + s + j + h, op.sub(x, y));
+                }
+        }
+        /**
+         * @brief The DIT stages of half size `q` and `2q` in one pass over blocks of `4q`
+         */
+        template <typename TOPS>
+        static void dit_radix4(const TOPS& op, TINT* a, size_t n, size_t q, const TINT* itw) {
+            for(size_t s = 0; s < n; s += 4 * q) {
+                TINT* p = a + s;
+                for(size_t j = 0; j < q; j += TOPS::lanes) {
+                    const auto w1 = op.load(itw + q + j);
+                    const auto x0 = op.load(p + j), x1 = op.mul(op.load(p + j + q), w1);
+                    const auto x2 = op.load(p + j + 2 * q), x3 = op.mul(op.load(p + j + 3 * q), w1);
+                    const auto b0 = op.add(x0, x1), b1 = op.sub(x0, x1);
+                    const auto b2 = op.mul(op.add(x2, x3), op.load(itw + 2 * q + j));
+                    const auto b3 = op.mul(op.sub(x2, x3), op.load(itw + 3 * q + j));
+                    op.store(p + j, op.add(b0, b2));
+                    op.store(p + j + 2 * q, op.sub(b0, b2));
+                    op.store(p + j + q, op.add(b1, b3));
+                    op.store(p + j + 3 * q, op.sub(b1, b3));
+                }
+            }
+        }
+
+        template <typename TOPS>
+        static void pointwise_range(const TOPS& op, TINT* a, const TINT* b, size_t begin, size_t end, TINT c) {
+            const auto vc = op.set1(c);
+            for(size_t i = begin; i < end; i += TOPS::lanes)
+                op.store(a + i, op.mul(op.load(a + i), b ? op.load(b + i) : vc));
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ * @file kernel_qgemm.h
+ * @brief Header file for the quantized u8 x s8 -> s32 matrix multiply kernels.
+ *
+ * This file defines the packed panel layout of the signed right hand side and the
+ * micro kernels that multiply up to `qgemm_mr` rows of the unsigned left hand side
+ * with one panel. The SSE and AVX kernels widen both operands to int16 and multiply
+ * with `pmaddwd`, the AVX kernel switches to `vpdpbusd` when the CPU reports VNNI at
+ * runtime.
+ *
+ * @note `pmaddubsw` is not used: it saturates the sum of two u8*s8 products to int16.
+ * Two products of int16 widened bytes always fit `pmaddwd`'s int32 sum, so every
+ * technique computes the exact same result for the full u8 and s8 range.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_QGEMM_H
+#define ADAPTIVE_KERNEL_QGEMM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#include <adaptive_techniq.h>
+#include "cpu_features.h"
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include "immintrin.h"
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Number of output columns in one packed panel of the right hand side.
+     */
+    constexpr size_t qgemm_nr = 8;
+    /**
+     * @brief Maximal number of left hand side rows a micro kernel processes at once.
+     */
+    constexpr size_t qgemm_mr = 4;
+
+    /**
+     * @brief Loads the four bytes `a[4*k4 .. 4*k4+3]` as one int32, padding with zero past `K`.
+     */
+    inline int32_t qgemm_load_a4(const uint8_t* a, size_t k4, size_t K) {
+        int32_t _result = 0;
+        size_t k = k4 * 4;
+        if(k + 4 <= K) std::memcpy(&_result, a + k, 4);
+        else std::memcpy(&_result, a + k, K - k);
+        return _result;
+    }
+
+    /**
+     * @brief Packs a `K` x `N` row-major int8 matrix into panels of `qgemm_nr` columns.
+     *
+     * Panel `p` holds columns `p*8 .. p*8+7` as `[k/4][column][k%4]`, so that one 32 byte
+     * load gives the four consecutive `k` of eight columns. `K` is padded to a multiple of
+     * four and the last panel to eight columns with zeros.
+     *
+     * @param b The source matrix.
+     * @param ldb The row stride of `b` in elements.
+     * @param dst The destination, `panels * round_up(K, 4) * 8` bytes.
+     * @param colsum Receives the `N` column sums of `b`.
+     */
+    inline void qgemm_pack_b(const int8_t* b, size_t ldb, size_t K, size_t N, int8_t* dst, int32_t* colsum) {
+        const size_t k4n = (K + 3) / 4;
+        const size_t panels = (N + qgemm_nr - 1) / qgemm_nr;
+
+        std::memset(dst, 0, panels * k4n * qgemm_nr * 4);
+        std::fill(colsum, colsum + N, 0);
+
+        for(size_t k = 0; k < K; ++k) {
+            const int8_t* brow = b + k * ldb;
+            for(size_t n = 0; n < N; ++n) {
+                size_t p = n / qgemm_nr, j = n % qgemm_nr;
+                dst[((p * k4n + k / 4) * qgemm_nr + j) * 4 + k % 4] = brow[n];
+                colsum[n] += brow[n];
+            }
+        }
+    }
+
+    /**
+     * @class qgemm_kernel
+     * @brief Scalar micro kernel, used for every technique without a specialization.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct qgemm_kernel {
+        /**
+         * @brief Computes `mr` x 8 raw dot products of `a` rows with one packed panel.
+         *
+         * @param a The first left hand side row.
+         * @param lda The row stride of `a`.
+         * @param mr The number of rows, at most `qgemm_mr`.
+         * @param K The depth.
+         * @param panel The packed panel.
+         * @param acc Receives `mr` rows of 8 int32 results.
+         */
+        static void compute(const uint8_t* a, size_t lda, size_t mr, size_t K, const int8_t* panel, int32_t* acc) {
+            std::fill(acc, acc + mr * qgemm_nr, 0);
+            for(size_t r = 0; r < mr; ++r) {
+                const uint8_t* arow = a + r * lda;
+                for(size_t k = 0; k < K; ++k) {
+                    const int8_t* pb = panel + (k / 4) * qgemm_nr * 4 + k % 4;
+                    for(size_t j = 0; j < qgemm_nr; ++j)
+                        acc[r * qgemm_nr + j] += int32_t(arow[k]) * int32_t(pb[j * 4]);
+                }
+            }
+        }
+    };
+
+#if defined(__SSE2__) && defined(__SSSE3__)
+    /**
+     * @brief Specialization for SSE technique, needs SSSE3 for `phaddd`
+     *
+     * The four `k` of two columns are widened to int16 and multiplied with `pmaddwd`,
+     * which leaves two partial sums per column. They are accumulated as they are and
+     * added pairwise once at the end.
+     */
+    template <>
+    struct qgemm_kernel<techn_type::SSE> {
+        template <size_t MR>
+        static void compute_mr(const uint8_t* a, size_t lda, size_t K, const int8_t* panel, int32_t* acc) {
+            const size_t k4n = (K + 3) / 4;
+            const __m128i zero = _mm_setzero_si128();
+            __m128i c[MR][4];
+
+            for(size_t r = 0; r < MR; ++r) c[r][0] = c[r][1] = c[r][2] = c[r][3] = zero;
+
+            for(size_t k4 = 0; k4 < k4n; ++k4) {
+                __m128i b0 = _mm_load_si128(reinterpret_cast<const __m128i*>(panel + k4 * 32));
+                __m128i b1 = _mm_load_si128(reinterpret_cast<const __m128i*>(panel + k4 * 32 + 16));
+                // Sign extension: the byte lands in the high half, the shift brings it down.
+                __m128i vb[4] = { _mm_srai_epi16(_mm_unpacklo_epi8(b0, b0), 8), _mm_srai_epi16(_mm_unpackhi_epi8(b0, b0), 8),
+                                  _mm_srai_epi16(_mm_unpacklo_epi8(b1, b1), 8), _mm_srai_epi16(_mm_unpackhi_epi8(b1, b1), 8) };
+                for(size_t r = 0; r < MR; ++r) {
+                    __m128i va = _mm_unpacklo_epi8(_mm_set1_epi32(qgemm_load_a4(a + r * lda, k4, K)), zero);
+                    for(size_t j = 0; j < 4; ++j) c[r][j] = _mm_add_epi32(c[r][j], _mm_madd_epi16(va, vb[j]));
+                }
+            }
+            for(size_t r = 0; r < MR; ++r) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + r * qgemm_nr), _mm_hadd_epi32(c[r][0], c[r][1]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + r * qgemm_nr + 4), _mm_hadd_epi32(c[r][2], c[r][3]));
+            }
+        }
+        static void compute(const uint8_t* a, size_t lda, size_t mr, size_t K, const int8_t* panel, int32_t* acc) {
+            switch(mr) {
+            case 4: compute_mr<4>(a, lda, K, panel, acc); break;
+            case 3: compute_mr<3>(a, lda, K, panel, acc); break;
+            case 2: compute_mr<2>(a, lda, K, panel, acc); break;
+            default: compute_mr<1>(a, lda, K, panel, acc); break;
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+#ifdef ADAPTIVE_HAS_CPU_DETECTION
+    /**
+     * @brief AVX-VNNI and AVX512-VNNI variants of the AVX micro kernel, selected at runtime.
+     */
+    template <size_t MR>
+    __attribute__((target("avx512vnni,avx512vl")))
+    void qgemm_compute_avx512vnni(const uint8_t* a, size_t lda, size_t K, const int8_t* panel, int32_t* acc) {
+        const size_t k4n = (K + 3) / 4;
+        __m256i c[MR];
+
+        for(size_t r = 0; r < MR; ++r) c[r] = _mm256_setzero_si256();
+        for(size_t k4 = 0; k4 < k4n; ++k4) {
+            __m256i vb = _mm256_load_si256(reinterpret_cast<const __m256i*>(panel + k4 * 32));
+            for(size_t r = 0; r < MR; ++r)
+                c[r] = _mm256_dpbusd_epi32(c[r], _mm256_set1_epi32(qgemm_load_a4(a + r * lda, k4, K)), vb);
+        }
+        for(size_t r = 0; r < MR; ++r)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * qgemm_nr), c[r]);
+    }
+    template <size_t MR>
+    __attribute__((target("avxvnni")))
+    void qgemm_compute_avxvnni(const uint8_t* a, size_t lda, size_t K, const int8_t* panel, int32_t* acc) {
+        const size_t k4n = (K + 3) / 4;
+        __m256i c[MR];
+
+        for(size_t r = 0; r < MR; ++r) c[r] = _mm256_setzero_si256();
+        for(size_t k4 = 0; k4 < k4n; ++k4) {
+            __m256i vb = _mm256_load_si256(reinterpret_cast<const __m256i*>(panel + k4 * 32));
+            for(size_t r = 0; r < MR; ++r)
+                c[r] = _mm256_dpbusd_avx_epi32(c[r], _mm256_set1_epi32(qgemm_load_a4(a + r * lda, k4, K)), vb);
+        }
+        for(size_t r = 0; r < MR; ++r)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * qgemm_nr), c[r]);
+    }
+#endif
+
+    /**
+     * @brief Specialization for AVX technique
+     */
+    template <>
+    struct qgemm_kernel<techn_type::AVX> {
+        template <size_t MR>
+        static void compute_mr(const uint8_t* a, size_t lda, size_t K, const int8_t* panel, int32_t* acc) {
+#ifdef ADAPTIVE_HAS_CPU_DETECTION
+            if(cpu_features::get().avx512vnni) { qgemm_compute_avx512vnni<MR>(a, lda, K, panel, acc); return; }
+            if(cpu_features::get().avxvnni)    { qgemm_compute_avxvnni<MR>(a, lda, K, panel, acc); return; }
+#endif
+            compute_widened<MR>(a, lda, K, panel, acc);
+        }
+        /**
+         * @brief The kernel without VNNI, exact like the SSE kernel
+         *
+         * Per 128 bit lane the low unpack holds columns 0, 1 (4, 5) and the high unpack
+         * columns 2, 3 (6, 7), so the final `phaddd` gives the columns in order.
+         */
+        template <size_t MR>
+        static void compute_widened(const uint8_t* a, size_t lda, size_t K, const int8_t* panel, int32_t* acc) {
+            const size_t k4n = (K + 3) / 4;
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i lo[MR], hi[MR];
+
+            for(size_t r = 0; r < MR; ++r) lo[r] = hi[r] = zero;
+            for(size_t k4 = 0; k4 < k4n; ++k4) {
+                __m256i vb = _mm256_load_si256(reinterpret_cast<const __m256i*>(panel + k4 * 32));
+                __m256i bl = _mm256_srai_epi16(_mm256_unpacklo_epi8(vb, vb), 8);
+                __m256i bh = _mm256_srai_epi16(_mm256_unpackhi_epi8(vb, vb), 8);
+                for(size_t r = 0; r < MR; ++r) {
+                    __m256i va = _mm256_unpacklo_epi8(_mm256_set1_epi32(qgemm_load_a4(a + r * lda, k4, K)), zero);
+                    lo[r] = _mm256_add_epi32(lo[r], _mm256_madd_epi16(va, bl));
+                    hi[r] = _mm256_add_epi32(hi[r], _mm256_madd_epi16(va, bh));
+                }
+            }
+            for(size_t r = 0; r < MR; ++r)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * qgemm_nr), _mm256_hadd_epi32(lo[r], hi[r]));
+        }
+        static void compute(const uint8_t* a, size_t lda, size_t mr, size_t K, const int8_t* panel, int32_t* acc) {
+            switch(mr) {
+            case 4: compute_mr<4>(a, lda, K, panel, acc); break;
+            case 3: compute_mr<3>(a, lda, K, panel, acc); break;
+            case 2: compute_mr<2>(a, lda, K, panel, acc); break;
+            default: compute_mr<1>(a, lda, K, panel, acc); break;
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <>
+    struct qgemm_kernel<techn_type::AVX512> : qgemm_kernel<techn_type::AVX> { };
+#endif
+
+    /**
+     * @brief Requantizes `n` int32 values to int8: `clamp(round(v * scale) + zero_point)`.
+     *
+     * Rounding is to nearest even in every technique.
+     */
+    template <techn_t TTECH>
+    void qgemm_requantize(const int32_t* src, size_t n, float scale, int32_t zero_point, int8_t* dst) {
+        size_t i = 0;
+#ifdef __AVX2__
+        if(TTECH >= techn_type::AVX) {
+            const __m256 vs = _mm256_set1_ps(scale);
+            const __m256 vmax = _mm256_set1_ps(1e9f), vmin = _mm256_set1_ps(-1e9f);
+            const __m256i vz = _mm256_set1_epi32(zero_point);
+
+            for(; i + 8 <= n; i += 8) {
+                __m256 f = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))), vs);
+                f = _mm256_min_ps(_mm256_max_ps(f, vmin), vmax);
+                __m256i v = _mm256_add_epi32(_mm256_cvtps_epi32(f), vz);
+                __m256i w = _mm256_packs_epi32(v, v);
+                w = _mm256_packs_epi16(w, w);
+                int32_t lo = _mm256_extract_epi32(w, 0), hi = _mm256_extract_epi32(w, 4);
+                std::memcpy(dst + i, &lo, 4);
+                std::memcpy(dst + i + 4, &hi, 4);
+            }
+        }
+#endif
+        for(; i < n; ++i) {
+            float f = std::min(std::max(float(src[i]) * scale, -1e9f), 1e9f);
+            int64_t v = int64_t(std::nearbyint(f)) + zero_point;
+            dst[i] = int8_t(std::min<int64_t>(std::max<int64_t>(v, -128), 127));
+        }
+    }
+}
+}
+
+#endif
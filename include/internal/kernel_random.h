@@ -0,0 +1,262 @@
+/**
+ * @file kernel_random.h
+ * @brief Header file for the multi-lane xoshiro256** generator kernels.
+ *
+ * This file defines `random_kernel`, which advances `xoshiro_lanes` independent
+ * xoshiro256** generators side by side and writes their outputs interleaved, lane by
+ * lane, and maps random words to a bounded range with Lemire's multiply-and-reject
+ * method. xoshiro256** needs only shifts, xors and the multiplications by 5 and 9,
+ * which are a shift and an add, so one SIMD step costs about as much as one scalar
+ * step and filling an array runs at store bandwidth. The lane count is fixed, every
+ * technique produces the same stream for the same state.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_RANDOM_H
+#define ADAPTIVE_KERNEL_RANDOM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Number of interleaved generators, 64-bit words per step.
+     */
+    constexpr size_t xoshiro_lanes = 8;
+
+    /**
+     * @brief The jump polynomials of xoshiro256, 2^128 and 2^192 steps.
+     */
+    constexpr uint64_t xoshiro_jump_poly[4] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+    };
+    constexpr uint64_t xoshiro_long_jump_poly[4] = {
+        0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull
+    };
+
+    /**
+     * @brief splitmix64, expands a seed into generator state.
+     */
+    inline uint64_t splitmix64(uint64_t& x) noexcept {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    /**
+     * @brief One output of a single xoshiro256** generator.
+     */
+    inline uint64_t xoshiro_next(uint64_t (&s)[4]) noexcept {
+        const uint64_t _result = ((s[1] * 5) << 7 | (s[1] * 5) >> 57) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 45) | (s[3] >> 19);
+        return _result;
+    }
+    /**
+     * @brief Advances a single generator by the jump polynomial `poly`.
+     */
+    inline void xoshiro_jump(uint64_t (&s)[4], const uint64_t (&poly)[4]) noexcept {
+        uint64_t t[4] = { 0, 0, 0, 0 };
+        for(uint64_t word : poly) {
+            for(int b = 0; b < 64; ++b) {
+                if(word & (uint64_t(1) << b)) {
+                    for(int k = 0; k < 4; ++k) t[k] ^= s[k];
+                }
+                xoshiro_next(s);
+            }
+        }
+        for(int k = 0; k < 4; ++k) s[k] = t[k];
+    }
+
+    /**
+     * @class rand_ops
+     * @brief Register operations of the generator kernels, the scalar technique with one lane.
+     *
+     * The 32-bit `lemire` works on `lanes32` lanes and returns the bit mask of the lanes
+     * that must be redrawn.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct rand_ops {
+        using reg = uint64_t;
+        using reg32 = uint32_t;
+        static constexpr size_t lanes = 1, lanes32 = 1;
+
+        static reg load(const uint64_t* p)      { return *p; }
+        static void store(void* p, reg v)       { std::memcpy(p, &v, sizeof(v)); }
+        static reg xor_(reg a, reg b)           { return a ^ b; }
+        static reg add(reg a, reg b)            { return a + b; }
+        static reg shl(reg v, int n)            { return v << n; }
+        static reg rotl(reg v, int n)           { return (v << n) | (v >> (64 - n)); }
+
+        static reg32 load32(const uint32_t* p)  { return *p; }
+        static void store32(uint32_t* p, reg32 v) { *p = v; }
+        static reg32 set32(uint32_t v)          { return v; }
+        static unsigned lemire(reg32 x, reg32 s, reg32 t, reg32& hi) {
+            const uint64_t m = uint64_t(x) * s;
+            hi = uint32_t(m >> 32);
+            return unsigned(uint32_t(m) < t);
+        }
+    };
+
+#ifdef __SSE4_1__
+    template <>
+    struct rand_ops<techn_type::SSE> {
+        using reg = __m128i;
+        using reg32 = __m128i;
+        static constexpr size_t lanes = 2, lanes32 = 4;
+
+        static reg load(const uint64_t* p)      { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(void* p, reg v)       { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg xor_(reg a, reg b)           { return _mm_xor_si128(a, b); }
+        static reg add(reg a, reg b)            { return _mm_add_epi64(a, b); }
+        static reg shl(reg v, int n)            { return _mm_slli_epi64(v, n); }
+        static reg rotl(reg v, int n)           { return _mm_or_si128(_mm_slli_epi64(v, n), _mm_srli_epi64(v, 64 - n)); }
+
+        static reg32 load32(const uint32_t* p)  { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store32(uint32_t* p, reg32 v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg32 set32(uint32_t v)          { return _mm_set1_epi32(int(v)); }
+        static unsigned lemire(reg32 x, reg32 s, reg32 t, reg32& hi) {
+            const reg32 even = _mm_mul_epu32(x, s), odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), s);
+            hi = _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+            const reg32 lo = _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+            const reg32 sign = _mm_set1_epi32(INT32_MIN);
+            return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_xor_si128(t, sign), _mm_xor_si128(lo, sign)))));
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <>
+    struct rand_ops<techn_type::AVX> {
+        using reg = __m256i;
+        using reg32 = __m256i;
+        static constexpr size_t lanes = 4, lanes32 = 8;
+
+        static reg load(const uint64_t* p)      { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(void* p, reg v)       { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg xor_(reg a, reg b)           { return _mm256_xor_si256(a, b); }
+        static reg add(reg a, reg b)            { return _mm256_add_epi64(a, b); }
+        static reg shl(reg v, int n)            { return _mm256_slli_epi64(v, n); }
+        static reg rotl(reg v, int n)           { return _mm256_or_si256(_mm256_slli_epi64(v, n), _mm256_srli_epi64(v, 64 - n)); }
+
+        static reg32 load32(const uint32_t* p)  { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store32(uint32_t* p, reg32 v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg32 set32(uint32_t v)          { return _mm256_set1_epi32(int(v)); }
+        static unsigned lemire(reg32 x, reg32 s, reg32 t, reg32& hi) {
+            const reg32 even = _mm256_mul_epu32(x, s), odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), s);
+            hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            const reg32 lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            const reg32 sign = _mm256_set1_epi32(INT32_MIN);
+            return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_xor_si256(t, sign), _mm256_xor_si256(lo, sign)))));
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <>
+    struct rand_ops<techn_type::AVX512> : rand_ops<techn_type::AVX> { };
+#endif
+
+    /**
+     * @class random_kernel
+     * @brief xoshiro256** on `xoshiro_lanes` lanes and the Lemire range mapping, written once over `rand_ops`.
+     *
+     * The state is four rows of `xoshiro_lanes` words, row `k` holds the word `s[k]` of
+     * every lane, so a row is loaded with plain vector loads.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct random_kernel {
+        using ops = rand_ops<TTECH>;
+        using reg = typename ops::reg;
+        static constexpr size_t regs = xoshiro_lanes / ops::lanes;
+
+        /**
+         * @brief Writes `steps * xoshiro_lanes` words to `out`, word `i` from lane `i % xoshiro_lanes`
+         */
+        static void generate(uint64_t (&state)[4][xoshiro_lanes], void* out, size_t steps) {
+            unsigned char* dst = static_cast<unsigned char*>(out);
+            reg s0[regs], s1[regs], s2[regs], s3[regs];
+            for(size_t r = 0; r < regs; ++r) {
+                s0[r] = ops::load(state[0] + r * ops::lanes);
+                s1[r] = ops::load(state[1] + r * ops::lanes);
+                s2[r] = ops::load(state[2] + r * ops::lanes);
+                s3[r] = ops::load(state[3] + r * ops::lanes);
+            }
+            for(size_t i = 0; i < steps; ++i, dst += xoshiro_lanes * sizeof(uint64_t)) {
+                for(size_t r = 0; r < regs; ++r) {
+                    // rotl(s1 * 5, 7) * 9 with the multiplications as shift and add.
+                    const reg x = ops::rotl(ops::add(s1[r], ops::shl(s1[r], 2)), 7);
+                    ops::store(dst + r * ops::lanes * sizeof(uint64_t), ops::add(x, ops::shl(x, 3)));
+
+                    const reg t = ops::shl(s1[r], 17);
+                    s2[r] = ops::xor_(s2[r], s0[r]);
+                    s3[r] = ops::xor_(s3[r], s1[r]);
+                    s1[r] = ops::xor_(s1[r], s2[r]);
+                    s0[r] = ops::xor_(s0[r], s3[r]);
+                    s2[r] = ops::xor_(s2[r], t);
+                    s3[r] = ops::rotl(s3[r], 45);
+                }
+            }
+            for(size_t r = 0; r < regs; ++r) {
+                ops::store(state[0] + r * ops::lanes, s0[r]);
+                ops::store(state[1] + r * ops::lanes, s1[r]);
+                ops::store(state[2] + r * ops::lanes, s2[r]);
+                ops::store(state[3] + r * ops::lanes, s3[r]);
+            }
+        }
+        /**
+         * @brief `x[i] = (x[i] * s) >> 32`, uniform in `[0, s)` without bias
+         *
+         * A value whose low product word is below `t = 2^32 mod s` is rejected and
+         * replaced, in index order, by `redraw()` words until one is accepted.
+         */
+        template <typename TREDRAW>
+        static void lemire32(uint32_t* x, size_t n, uint32_t s, uint32_t t, TREDRAW&& redraw) {
+            const typename ops::reg32 vs = ops::set32(s), vt = ops::set32(t);
+            size_t i = 0;
+            for(; i + ops::lanes32 <= n; i += ops::lanes32) {
+                typename ops::reg32 hi;
+                unsigned reject = ops::lemire(ops::load32(x + i), vs, vt, hi);
+                ops::store32(x + i, hi);
+                for(; reject != 0; reject &= reject - 1) x[i + size_t(ctz(uint32_t(reject)))] = accept32(s, t, redraw);
+            }
+            using scalar_ops = rand_ops<techn_type::Scalar>;
+            for(; i < n; ++i) {
+                uint32_t hi;
+                if(scalar_ops::lemire(x[i], s, t, hi)) hi = accept32(s, t, redraw);
+                x[i] = hi;
+            }
+        }
+
+    protected:
+        template <typename TREDRAW>
+        static uint32_t accept32(uint32_t s, uint32_t t, TREDRAW& redraw) {
+            for(;;) {
+                const uint64_t m = uint64_t(uint32_t(redraw())) * s;
+                if(uint32_t(m) >= t) return uint32_t(m >> 32);
+            }
+        }
+    };
+}
+}
+
+#endif
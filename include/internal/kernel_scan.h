@@ -0,0 +1,248 @@
+/**
+ * @file kernel_scan.h
+ * @brief Header file for the prefix sum kernels.
+ *
+ * This file defines `scan_kernel`, the sum and the inclusive or exclusive prefix sum of
+ * an integer array continuing from a carry, the building blocks of the parallel scan.
+ * The SIMD kernels scan a register in log2(lanes) shift-and-add steps (`pslldq` within
+ * 128-bit lanes, on AVX the low lane's total is then added to the high lane), add the
+ * carry register and broadcast the last lane as the next carry, so only a shuffle per
+ * register is on the dependency chain. Sums wrap like unsigned arithmetic.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_SCAN_H
+#define ADAPTIVE_KERNEL_SCAN_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class scan_kernel
+     * @brief Scalar sum and prefix sum, used for every technique without a specialization.
+     *
+     * @tparam TINT The integer type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct scan_kernel {
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+
+        /**
+         * @brief The wrapping sum of `p[0, n)`
+         */
+        static TINT reduce(const TINT* p, size_t n) noexcept {
+            unsigned_type _result = 0;
+            for(size_t i = 0; i < n; ++i) _result = unsigned_type(_result + unsigned_type(p[i]));
+            return TINT(_result);
+        }
+        /**
+         * @brief `out[i] = carry + in[0] + ... + in[i]`, or up to `in[i - 1]` if `TEXCL`
+         *
+         * `out` may be `in`.
+         *
+         * @return `carry` plus the sum of `in[0, n)`
+         */
+        template <bool TEXCL>
+        static TINT scan(const TINT* in, TINT* out, size_t n, TINT carry) noexcept {
+            unsigned_type c = unsigned_type(carry);
+            for(size_t i = 0; i < n; ++i) {
+                const unsigned_type v = unsigned_type(in[i]);
+                if(TEXCL) out[i] = TINT(c);
+                c = unsigned_type(c + v);
+                if(!TEXCL) out[i] = TINT(c);
+            }
+            return TINT(c);
+        }
+    };
+
+    /**
+     * @class scan_ops
+     * @brief Register operations of the prefix sum kernels, only the SIMD techniques.
+     *
+     * @tparam TINT The integer type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct scan_ops;
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct scan_ops<TINT, techn_type::SSE> {
+        using reg = __m128i;
+        static constexpr size_t width = sizeof(TINT);
+        static constexpr size_t lanes = 16 / width;
+
+        static reg load(const TINT* p)     { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(TINT* p, reg v)  { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg zero()                  { return _mm_setzero_si128(); }
+        static reg set1(TINT v) {
+            if constexpr (width == 1) return _mm_set1_epi8(char(v));
+            else if constexpr (width == 2) return _mm_set1_epi16(short(v));
+            else if constexpr (width == 4) return _mm_set1_epi32(int(v));
+            else return _mm_set1_epi64x(int64_t(v));
+        }
+        static reg add(reg a, reg b) {
+            if constexpr (width == 1) return _mm_add_epi8(a, b);
+            else if constexpr (width == 2) return _mm_add_epi16(a, b);
+            else if constexpr (width == 4) return _mm_add_epi32(a, b);
+            else return _mm_add_epi64(a, b);
+        }
+        static reg sub(reg a, reg b) {
+            if constexpr (width == 1) return _mm_sub_epi8(a, b);
+            else if constexpr (width == 2) return _mm_sub_epi16(a, b);
+            else if constexpr (width == 4) return _mm_sub_epi32(a, b);
+            else return _mm_sub_epi64(a, b);
+        }
+        /**
+         * @brief The inclusive prefix sum of the lanes of `x`
+         */
+        static reg scan(reg x) {
+            if constexpr (width <= 1) x = add(x, _mm_slli_si128(x, 1));
+            if constexpr (width <= 2) x = add(x, _mm_slli_si128(x, 2));
+            if constexpr (width <= 4) x = add(x, _mm_slli_si128(x, 4));
+            return add(x, _mm_slli_si128(x, 8));
+        }
+        /**
+         * @brief The last lane of `x` in every lane
+         */
+        static reg broadcast_last(reg x) {
+            return _mm_shuffle_epi8(x, last_lane_mask());
+        }
+        static TINT first(reg x) {
+            TINT _lanes[lanes];
+            store(_lanes, x);
+            return _lanes[0];
+        }
+
+    protected:
+        static reg last_lane_mask() {
+            alignas(16) int8_t _mask[16];
+            for(size_t i = 0; i < 16; ++i) _mask[i] = int8_t(16 - width + i % width);
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(_mask));
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct scan_ops<TINT, techn_type::AVX> {
+        using reg = __m256i;
+        static constexpr size_t width = sizeof(TINT);
+        static constexpr size_t lanes = 32 / width;
+
+        static reg load(const TINT* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(TINT* p, reg v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg zero()                  { return _mm256_setzero_si256(); }
+        static reg set1(TINT v) {
+            if constexpr (width == 1) return _mm256_set1_epi8(char(v));
+            else if constexpr (width == 2) return _mm256_set1_epi16(short(v));
+            else if constexpr (width == 4) return _mm256_set1_epi32(int(v));
+            else return _mm256_set1_epi64x(int64_t(v));
+        }
+        static reg add(reg a, reg b) {
+            if constexpr (width == 1) return _mm256_add_epi8(a, b);
+            else if constexpr (width == 2) return _mm256_add_epi16(a, b);
+            else if constexpr (width == 4) return _mm256_add_epi32(a, b);
+            else return _mm256_add_epi64(a, b);
+        }
+        static reg sub(reg a, reg b) {
+            if constexpr (width == 1) return _mm256_sub_epi8(a, b);
+            else if constexpr (width == 2) return _mm256_sub_epi16(a, b);
+            else if constexpr (width == 4) return _mm256_sub_epi32(a, b);
+            else return _mm256_sub_epi64(a, b);
+        }
+        static reg scan(reg x) {
+            if constexpr (width <= 1) x = add(x, _mm256_slli_si256(x, 1));
+            if constexpr (width <= 2) x = add(x, _mm256_slli_si256(x, 2));
+            if constexpr (width <= 4) x = add(x, _mm256_slli_si256(x, 4));
+            x = add(x, _mm256_slli_si256(x, 8));
+            // The total of the low 128-bit lane into every element of the high one.
+            const reg t = _mm256_shuffle_epi8(x, last_lane_mask());
+            return add(x, _mm256_permute2x128_si256(t, t, 0x08));
+        }
+        static reg broadcast_last(reg x) {
+            const reg t = _mm256_shuffle_epi8(x, last_lane_mask());
+            return _mm256_permute2x128_si256(t, t, 0x11);
+        }
+        static TINT first(reg x) {
+            TINT _lanes[lanes];
+            store(_lanes, x);
+            return _lanes[0];
+        }
+
+    protected:
+        static reg last_lane_mask() {
+            alignas(32) int8_t _mask[32];
+            for(size_t i = 0; i < 32; ++i) _mask[i] = int8_t(16 - width + i % width);
+            return _mm256_load_si256(reinterpret_cast<const __m256i*>(_mask));
+        }
+    };
+#endif
+
+    /**
+     * @brief Sum and prefix sum over the registers of `TOPS`
+     */
+    template <typename TINT, typename TOPS>
+    struct scan_kernel_simd {
+        using reg = typename TOPS::reg;
+        using scalar = scan_kernel<TINT, techn_type::Scalar>;
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+        static constexpr size_t lanes = TOPS::lanes;
+
+        static TINT reduce(const TINT* p, size_t n) noexcept {
+            reg s0 = TOPS::zero(), s1 = TOPS::zero();
+            size_t i = 0;
+            for(; i + 2 * lanes <= n; i += 2 * lanes) {
+                s0 = TOPS::add(s0, TOPS::load(p + i));
+                s1 = TOPS::add(s1, TOPS::load(p + i + lanes));
+            }
+            TINT _lanes[lanes];
+            TOPS::store(_lanes, TOPS::add(s0, s1));
+            return TINT(unsigned_type(unsigned_type(scalar::reduce(_lanes, lanes)) + unsigned_type(scalar::reduce(p + i, n - i))));
+        }
+        template <bool TEXCL>
+        static TINT scan(const TINT* in, TINT* out, size_t n, TINT carry) noexcept {
+            reg c = TOPS::set1(carry);
+            size_t i = 0;
+            for(; i + lanes <= n; i += lanes) {
+                const reg v = TOPS::load(in + i);
+                const reg x = TOPS::add(TOPS::scan(v), c);
+                TOPS::store(out + i, TEXCL ? TOPS::sub(x, v) : x);
+                c = TOPS::broadcast_last(x);
+            }
+            return scalar::template scan<TEXCL>(in + i, out + i, n - i, TOPS::first(c));
+        }
+    };
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct scan_kernel<TINT, techn_type::SSE, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : scan_kernel_simd<TINT, scan_ops<TINT, techn_type::SSE>> { };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct scan_kernel<TINT, techn_type::AVX, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : scan_kernel_simd<TINT, scan_ops<TINT, techn_type::AVX>> { };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct scan_kernel<TINT, techn_type::AVX512, typename std::enable_if<std::is_integral<TINT>::value>::type>
+        : scan_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file kernel_small_matrix.h
+ * @brief Header file for the batched small-matrix kernels.
+ *
+ * This file defines `small_matrix_kernel`, the multiply, determinant and
+ * matrix-vector kernels over batches of `N` x `N` matrices stored structure-of-arrays:
+ * element `(i, j)` of every matrix lives in its own plane, so one register holds the
+ * same element of `lanes` different matrices and every operation is a plain lane-wise
+ * multiply-add without shuffles. The kernels are written once over `lane_simd`; the
+ * SIMD part covers the full registers, the scalar instantiation the rest.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_SMALL_MATRIX_H
+#define ADAPTIVE_KERNEL_SMALL_MATRIX_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class small_matrix_kernel
+     * @brief Lane-parallel kernels for batches of `N` x `N` matrices.
+     *
+     * Plane `p` of a matrix batch starts at `data + p * stride`, plane `i * N + j` holds
+     * element `(i, j)`. Vector batches have `N` planes. All arithmetic wraps.
+     *
+     * @tparam TINT The element type.
+     * @tparam N The matrix size, 3 or 4.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, size_t N, techn_t TTECH>
+    struct small_matrix_kernel {
+        using simd_type = lane_simd<TINT, TTECH>;
+        using scalar_type = lane_simd<TINT, techn_type::Scalar>;
+
+        /**
+         * @brief `c[m] = a[m] * b[m]` for `m` in `[0, count)`.
+         */
+        static void multiply(const TINT* a, const TINT* b, TINT* c, size_t stride, size_t count) {
+            const size_t full = count - count % simd_type::lanes;
+            multiply_range<simd_type>(a, b, c, stride, 0, full);
+            multiply_range<scalar_type>(a, b, c, stride, full, count);
+        }
+        /**
+         * @brief `y[m] = a[m] * x[m]` for `m` in `[0, count)`.
+         */
+        static void matvec(const TINT* a, const TINT* x, TINT* y, size_t stride, size_t vstride, size_t count) {
+            const size_t full = count - count % simd_type::lanes;
+            matvec_range<simd_type>(a, x, y, stride, vstride, 0, full);
+            matvec_range<scalar_type>(a, x, y, stride, vstride, full, count);
+        }
+        /**
+         * @brief `det[m] = det(a[m])` for `m` in `[0, count)`.
+         */
+        static void determinant(const TINT* a, TINT* det, size_t stride, size_t count) {
+            const size_t full = count - count % simd_type::lanes;
+            determinant_range<simd_type>(a, det, stride, 0, full);
+            determinant_range<scalar_type>(a, det, stride, full, count);
+        }
+
+    protected:
+        template <typename TOPS>
+        static void multiply_range(const TINT* a, const TINT* b, TINT* c, size_t stride, size_t begin, size_t end) {
+            using reg = typename TOPS::reg;
+            for(size_t m = begin; m < end; m += TOPS::lanes) {
+                reg rb[N * N];
+                for(size_t p = 0; p < N * N; ++p) rb[p] = TOPS::load(b + p * stride + m);
+                for(size_t i = 0; i < N; ++i) {
+                    reg ra[N];
+                    for(size_t k = 0; k < N; ++k) ra[k] = TOPS::load(a + (i * N + k) * stride + m);
+                    for(size_t j = 0; j < N; ++j) {
+                        reg s = TOPS::mul(ra[0], rb[j]);
+                        for(size_t k = 1; k < N; ++k) s = TOPS::add(s, TOPS::mul(ra[k], rb[k * N + j]));
+                        TOPS::store(c + (i * N + j) * stride + m, s);
+                    }
+                }
+            }
+        }
+
+        template <typename TOPS>
+        static void matvec_range(const TINT* a, const TINT* x, TINT* y, size_t stride, size_t vstride, size_t begin, size_t end) {
+            using reg = typename TOPS::reg;
+            for(size_t m = begin; m < end; m += TOPS::lanes) {
+                reg rx[N];
+                for(size_t j = 0; j < N; ++j) rx[j] = TOPS::load(x + j * vstride + m);
+                for(size_t i = 0; i < N; ++i) {
+                    reg s = TOPS::mul(TOPS::load(a + (i * N) * stride + m), rx[0]);
+                    for(size_t j = 1; j < N; ++j) s = TOPS::add(s, TOPS::mul(TOPS::load(a + (i * N + j) * stride + m), rx[j]));
+                    TOPS::store(y + i * vstride + m, s);
+                }
+            }
+        }
+
+        template <typename TOPS>
+        static void determinant_range(const TINT* a, TINT* det, size_t stride, size_t begin, size_t end) {
+            using reg = typename TOPS::reg;
+            for(size_t m = begin; m < end; m += TOPS::lanes) {
+                reg e[N * N];
+                for(size_t p = 0; p < N * N; ++p) e[p] = TOPS::load(a + p * stride + m);
+
+                if constexpr (N == 3) {
+                    // Expansion along the first row.
+                    reg c0 = TOPS::sub(TOPS::mul(e[4], e[8]), TOPS::mul(e[5], e[7]));
+                    reg c1 = TOPS::sub(TOPS::mul(e[3], e[8]), TOPS::mul(e[5], e[6]));
+                    reg c2 = TOPS::sub(TOPS::mul(e[3], e[7]), TOPS::mul(e[4], e[6]));
+                    reg d = TOPS::add(TOPS::sub(TOPS::mul(e[0], c0), TOPS::mul(e[1], c1)), TOPS::mul(e[2], c2));
+                    TOPS::store(det + m, d);
+                } else {
+                    // Laplace expansion over the 2x2 minors of rows 0-1 (s) and rows 2-3 (c).
+                    reg s0 = TOPS::sub(TOPS::mul(e[0], e[5]), TOPS::mul(e[1], e[4]));
+                    reg s1 = TOPS::sub(TOPS::mul(e[0], e[6]), TOPS::mul(e[2], e[4]));
+                    reg s2 = TOPS::sub(TOPS::mul(e[0], e[7]), TOPS::mul(e[3], e[4]));
+                    reg s3 = TOPS::sub(TOPS::mul(e[1], e[6]), TOPS::mul(e[2], e[5]));
+                    reg s4 = TOPS::sub(TOPS::mul(e[1], e[7]), TOPS::mul(e[3], e[5]));
+                    reg s5 = TOPS::sub(TOPS::mul(e[2], e[7]), TOPS::mul(e[3], e[6]));
+                    reg c5 = TOPS::sub(TOPS::mul(e[10], e[15]), TOPS::mul(e[11], e[14]));
+                    reg c4 = TOPS::sub(TOPS::mul(e[9], e[15]), TOPS::mul(e[11], e[13]));
+                    reg c3 = TOPS::sub(TOPS::mul(e[9], e[14]), TOPS::mul(e[10], e[13]));
+                    reg c2 = TOPS::sub(TOPS::mul(e[8], e[15]), TOPS::mul(e[11], e[12]));
+                    reg c1 = TOPS::sub(TOPS::mul(e[8], e[14]), TOPS::mul(e[10], e[12]));
+                    reg c0 = TOPS::sub(TOPS::mul(e[8], e[13]), TOPS::mul(e[9], e[12]));
+                    reg d = TOPS::sub(TOPS::mul(s0, c5), TOPS::mul(s1, c4));
+                    d = TOPS::add(d, TOPS::mul(s2, c3));
+                    d = TOPS::add(d, TOPS::mul(s3, c2));
+                    d = TOPS::sub(d, TOPS::mul(s4, c1));
+                    d = TOPS::add(d, TOPS::mul(s5, c0));
+                    TOPS::store(det + m, d);
+                }
+            }
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file kernel_spmv.h
+ * @brief Header file for the sparse matrix-vector multiply kernels.
+ *
+ * This file defines the `spmv_kernel` template, which multiplies a range of rows of a
+ * CSR matrix with a dense vector. The AVX specialization gathers the vector elements
+ * of 32- and 64-bit rows with `vpgatherdd`/`vpgatherdq` once a row is long enough to
+ * pay for the gather latency; short rows and the other widths stay scalar.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_SPMV_H
+#define ADAPTIVE_KERNEL_SPMV_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+#include "simd_util.h"
+
+/**
+ * @brief Minimal number of non zeros in a row before the AVX kernel uses gathers.
+ */
+#ifndef ADAPTIVE_SPMV_GATHER_MIN
+#define ADAPTIVE_SPMV_GATHER_MIN 8
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Scalar dot product of CSR row entries `[k, end)` with `x`, wrapping on overflow.
+     */
+    template <typename TINT>
+    inline TINT spmv_row_scalar(const uint32_t* colidx, const TINT* values, const TINT* x, size_t k, size_t end,
+                                TINT init = 0) {
+        using unsigned_type = typename std::make_unsigned<TINT>::type;
+        // Narrow types would be promoted to (signed) int and could overflow.
+        using wide_type = typename std::conditional<(sizeof(unsigned_type) < sizeof(unsigned)), unsigned, unsigned_type>::type;
+        wide_type _sum = static_cast<unsigned_type>(init);
+
+        for(; k < end; ++k)
+            _sum += static_cast<wide_type>(static_cast<unsigned_type>(values[k])) * static_cast<wide_type>(static_cast<unsigned_type>(x[colidx[k]]));
+        return static_cast<TINT>(static_cast<unsigned_type>(_sum));
+    }
+
+    /**
+     * @class spmv_kernel
+     * @brief Scalar CSR kernel, used for every technique without a specialization.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct spmv_kernel {
+        /**
+         * @brief Computes `y[r] = sum(values[k] * x[colidx[k]])` for the rows `[rbegin, rend)`.
+         */
+        static void rows(const size_t* rowptr, const uint32_t* colidx, const TINT* values,
+                         const TINT* x, TINT* y, size_t rbegin, size_t rend) {
+            for(size_t r = rbegin; r < rend; ++r)
+                y[r] = spmv_row_scalar(colidx, values, x, rowptr[r], rowptr[r + 1]);
+        }
+    };
+
+#ifdef __AVX2__
+    /**
+     * @brief Specialization for AVX technique
+     */
+    template <typename TINT>
+    struct spmv_kernel<TINT, techn_type::AVX> {
+        static void rows(const size_t* rowptr, const uint32_t* colidx, const TINT* values,
+                         const TINT* x, TINT* y, size_t rbegin, size_t rend) {
+            for(size_t r = rbegin; r < rend; ++r) {
+                size_t k = rowptr[r];
+                const size_t end = rowptr[r + 1];
+                TINT _sum = 0;
+
+                if(end - k >= ADAPTIVE_SPMV_GATHER_MIN) {
+                    if constexpr (sizeof(TINT) == 4) {
+                        __m256i acc = _mm256_setzero_si256();
+                        for(; k + 8 <= end; k += 8) {
+                            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colidx + k));
+                            __m256i xv = _mm256_i32gather_epi32(reinterpret_cast<const int*>(x), idx, 4);
+                            __m256i vv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + k));
+                            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(vv, xv));
+                        }
+                        _sum = static_cast<TINT>(hsum_epi32(acc));
+                    } else if constexpr (sizeof(TINT) == 8) {
+                        __m256i acc = _mm256_setzero_si256();
+                        for(; k + 4 <= end; k += 4) {
+                            __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colidx + k));
+                            __m256i xv = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(x), idx, 8);
+                            __m256i vv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + k));
+                            acc = _mm256_add_epi64(acc, mullo_epi64_avx(vv, xv));
+                        }
+                        _sum = static_cast<TINT>(hsum_epi64(acc));
+                    }
+                }
+                y[r] = spmv_row_scalar(colidx, values, x, k, end, _sum);
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <typename TINT>
+    struct spmv_kernel<TINT, techn_type::AVX512> : spmv_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * @file kernel_stencil.h
+ * @brief Header file for the 2D stencil and convolution row kernels.
+ *
+ * This file defines `stencil_kernel`, the row primitives the convolution driver of
+ * `adaptive_stencil.h` is built from. All of them work on rows that are already
+ * padded for the border, so they never branch on the image edge:
+ *
+ * - `hrow_u8_i16`: horizontal taps over uint8 pixels into int16 sums with `pmaddubsw`,
+ *   two output phases (even and odd pixels) per load
+ * - `hrow_i32`: horizontal taps over uint8 or int16 pixels into int32 sums with `pmaddwd`
+ * - `vcol_i32`: vertical taps over int16 or int32 rows into int32 sums
+ * - `store`: rounding shift and saturation into the uint8 or int16 output row
+ *
+ * The caller guarantees that the sums fit the accumulator (see `conv_filter`), so the
+ * SIMD and the scalar kernels give bit identical results.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_STENCIL_H
+#define ADAPTIVE_KERNEL_STENCIL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include "immintrin.h"
+#endif
+
+/**
+ * @brief Elements of slack the driver keeps behind every padded row, vector loads may read into it.
+ */
+#ifndef ADAPTIVE_STENCIL_SLACK
+#define ADAPTIVE_STENCIL_SLACK 64
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Register operations for the SIMD stencil kernels.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH>
+    struct stencil_simd {
+        static constexpr bool enabled = false;
+    };
+
+#ifdef __SSE4_1__
+    template <>
+    struct stencil_simd<techn_type::SSE> {
+        static constexpr bool enabled = true;
+        static constexpr size_t bytes = 16;
+        using reg = __m128i;
+
+        static reg zero()                              { return _mm_setzero_si128(); }
+        static reg load(const void* p)                 { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+        static void store(void* p, reg v)              { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+        static reg widen_u8(const uint8_t* p)          { return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+        static reg set1_16(int16_t v)                  { return _mm_set1_epi16(v); }
+        static reg set1_32(int32_t v)                  { return _mm_set1_epi32(v); }
+        static reg add16(reg a, reg b)                 { return _mm_add_epi16(a, b); }
+        static reg add32(reg a, reg b)                 { return _mm_add_epi32(a, b); }
+        static reg mullo32(reg a, reg b)               { return _mm_mullo_epi32(a, b); }
+        static reg maddubs(reg u8, reg s8)             { return _mm_maddubs_epi16(u8, s8); }
+        static reg madd(reg a, reg b)                  { return _mm_madd_epi16(a, b); }
+        static reg unpacklo16(reg a, reg b)            { return _mm_unpacklo_epi16(a, b); }
+        static reg unpackhi16(reg a, reg b)            { return _mm_unpackhi_epi16(a, b); }
+        static reg srai16(reg a, int s)                { return _mm_sra_epi16(a, _mm_cvtsi32_si128(s)); }
+        static reg srai32(reg a, int s)                { return _mm_sra_epi32(a, _mm_cvtsi32_si128(s)); }
+        static reg packus16(reg a, reg b)              { return _mm_packus_epi16(a, b); }
+        static reg packs32(reg a, reg b)               { return _mm_packs_epi32(a, b); }
+        /**
+         * @brief Puts the results of an unpacklo/unpackhi pair back into element order.
+         */
+        static void order(reg lo, reg hi, reg& out0, reg& out1) { out0 = lo; out1 = hi; }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <>
+    struct stencil_simd<techn_type::AVX> {
+        static constexpr bool enabled = true;
+        static constexpr size_t bytes = 32;
+        using reg = __m256i;
+
+        static reg zero()                              { return _mm256_setzero_si256(); }
+        static reg load(const void* p)                 { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+        static void store(void* p, reg v)              { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+        static reg widen_u8(const uint8_t* p)          { return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+        static reg set1_16(int16_t v)                  { return _mm256_set1_epi16(v); }
+        static reg set1_32(int32_t v)                  { return _mm256_set1_epi32(v); }
+        static reg add16(reg a, reg b)                 { return _mm256_add_epi16(a, b); }
+        static reg add32(reg a, reg b)                 { return _mm256_add_epi32(a, b); }
+        static reg mullo32(reg a, reg b)               { return _mm256_mullo_epi32(a, b); }
+        static reg maddubs(reg u8, reg s8)             { return _mm256_maddubs_epi16(u8, s8); }
+        static reg madd(reg a, reg b)                  { return _mm256_madd_epi16(a, b); }
+        static reg unpacklo16(reg a, reg b)            { return _mm256_unpacklo_epi16(a, b); }
+        static reg unpackhi16(reg a, reg b)            { return _mm256_unpackhi_epi16(a, b); }
+        static reg srai16(reg a, int s)                { return _mm256_sra_epi16(a, _mm_cvtsi32_si128(s)); }
+        static reg srai32(reg a, int s)                { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(s)); }
+        // The AVX2 packs work per 128-bit lane, the permute restores the element order.
+        static reg packus16(reg a, reg b)              { return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8); }
+        static reg packs32(reg a, reg b)               { return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8); }
+        static void order(reg lo, reg hi, reg& out0, reg& out1) {
+            out0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+            out1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <>
+    struct stencil_simd<techn_type::AVX512> : stencil_simd<techn_type::AVX> { };
+#endif
+
+    /**
+     * @brief Saturates `v` to the range of `TDST`.
+     */
+    template <typename TDST>
+    inline TDST stencil_saturate(int32_t v) {
+        return TDST(std::min<int32_t>(std::max<int32_t>(v, std::numeric_limits<TDST>::min()),
+                                      std::numeric_limits<TDST>::max()));
+    }
+
+    /**
+     * @class stencil_kernel
+     * @brief Scalar stencil row kernels, used for every technique without SIMD support.
+     *
+     * `in` rows are padded: output `x` reads `in[x .. x + K - 1]`.
+     *
+     * @tparam TTECH The technique type.
+     */
+    template <techn_t TTECH, bool TSIMD = stencil_simd<TTECH>::enabled>
+    struct stencil_kernel {
+        /**
+         * @brief `acc[x] += sum_k w[k] * in[x + k]` over uint8 pixels with int16 sums.
+         */
+        static void hrow_u8_i16(const uint8_t* in, const int16_t* w, size_t K, int16_t* acc, size_t n) {
+            for(size_t x = 0; x < n; ++x) {
+                int32_t s = acc[x];
+                for(size_t k = 0; k < K; ++k) s += int32_t(w[k]) * in[x + k];
+                acc[x] = int16_t(s);
+            }
+        }
+        /**
+         * @brief `acc[x] += sum_k w[k] * in[x + k]` over uint8 or int16 pixels with int32 sums.
+         */
+        template <typename TSRC>
+        static void hrow_i32(const TSRC* in, const int16_t* w, size_t K, int32_t* acc, size_t n) {
+            for(size_t x = 0; x < n; ++x) {
+                int32_t s = acc[x];
+                for(size_t k = 0; k < K; ++k) s += int32_t(w[k]) * in[x + k];
+                acc[x] = s;
+            }
+        }
+        /**
+         * @brief `acc[x] += sum_i w[i] * rows[i][x]` over int16 or int32 rows.
+         */
+        template <typename TIN>
+        static void vcol_i32(const TIN* const* rows, const int16_t* w, size_t K, int32_t* acc, size_t n) {
+            for(size_t x = 0; x < n; ++x) {
+                int32_t s = acc[x];
+                for(size_t i = 0; i < K; ++i) s += int32_t(w[i]) * int32_t(rows[i][x]);
+                acc[x] = s;
+            }
+        }
+        /**
+         * @brief `dst[x] = saturate((acc[x] + round) >> shift)`.
+         */
+        template <typename TACC, typename TDST>
+        static void store(const TACC* acc, TDST* dst, size_t n, unsigned shift) {
+            const int32_t round = shift ? int32_t(1) << (shift - 1) : 0;
+            for(size_t x = 0; x < n; ++x) dst[x] = stencil_saturate<TDST>((int32_t(acc[x]) + round) >> shift);
+        }
+    };
+
+    /**
+     * @brief SIMD stencil row kernels for SSE4.1 and AVX2, the remainder of a row runs scalar.
+     */
+    template <techn_t TTECH>
+    struct stencil_kernel<TTECH, true> {
+        using simd = stencil_simd<TTECH>;
+        using reg = typename simd::reg;
+        using scalar_type = stencil_kernel<techn_type::Scalar, false>;
+
+        static constexpr size_t B = simd::bytes;
+        static constexpr size_t L16 = B / 2;
+        static constexpr size_t L32 = B / 4;
+
+        static int16_t pair8(const int16_t* w, size_t k, size_t K) {
+            return int16_t(uint16_t(uint8_t(w[k])) | uint16_t((k + 1 < K ? uint8_t(w[k + 1]) : 0) << 8));
+        }
+        static int32_t pair16(const int16_t* w, size_t k, size_t K) {
+            return int32_t(uint32_t(uint16_t(w[k])) | (uint32_t(k + 1 < K ? uint16_t(w[k + 1]) : 0) << 16));
+        }
+        template <typename TSRC>
+        static reg load16(const TSRC* p) {
+            if constexpr (sizeof(TSRC) == 1) return simd::widen_u8(p);
+            else return simd::load(p);
+        }
+
+        static void hrow_u8_i16(const uint8_t* in, const int16_t* w, size_t K, int16_t* acc, size_t n) {
+            size_t x = 0;
+            for(; x + B <= n; x += B) {
+                // Even outputs pair bytes (2j, 2j+1) of the load at x + k, odd outputs of the load at x + k + 1.
+                reg even = simd::zero(), odd = simd::zero();
+                for(size_t k = 0; k < K; k += 2) {
+                    const reg wp = simd::set1_16(pair8(w, k, K));
+                    even = simd::add16(even, simd::maddubs(simd::load(in + x + k), wp));
+                    odd = simd::add16(odd, simd::maddubs(simd::load(in + x + k + 1), wp));
+                }
+                reg out0, out1;
+                simd::order(simd::unpacklo16(even, odd), simd::unpackhi16(even, odd), out0, out1);
+                simd::store(acc + x, simd::add16(simd::load(acc + x), out0));
+                simd::store(acc + x + L16, simd::add16(simd::load(acc + x + L16), out1));
+            }
+            scalar_type::hrow_u8_i16(in + x, w, K, acc + x, n - x);
+        }
+
+        template <typename TSRC>
+        static void hrow_i32(const TSRC* in, const int16_t* w, size_t K, int32_t* acc, size_t n) {
+            size_t x = 0;
+            for(; x + L16 <= n; x += L16) {
+                reg lo = simd::zero(), hi = simd::zero();
+                for(size_t k = 0; k < K; k += 2) {
+                    const reg wp = simd::set1_32(pair16(w, k, K));
+                    const reg a = load16(in + x + k), b = load16(in + x + k + 1);
+                    lo = simd::add32(lo, simd::madd(simd::unpacklo16(a, b), wp));
+                    hi = simd::add32(hi, simd::madd(simd::unpackhi16(a, b), wp));
+                }
+                reg out0, out1;
+                simd::order(lo, hi, out0, out1);
+                simd::store(acc + x, simd::add32(simd::load(acc + x), out0));
+                simd::store(acc + x + L32, simd::add32(simd::load(acc + x + L32), out1));
+            }
+            scalar_type::hrow_i32(in + x, w, K, acc + x, n - x);
+        }
+
+        template <typename TIN>
+        static void vcol_i32(const TIN* const* rows, const int16_t* w, size_t K, int32_t* acc, size_t n) {
+            size_t x = 0;
+            if constexpr (sizeof(TIN) == 2) {
+                for(; x + L16 <= n; x += L16) {
+                    reg lo = simd::zero(), hi = simd::zero();
+                    for(size_t i = 0; i < K; i += 2) {
+                        const reg wp = simd::set1_32(pair16(w, i, K));
+                        const reg a = simd::load(rows[i] + x);
+                        const reg b = i + 1 < K ? simd::load(rows[i + 1] + x) : simd::zero();
+                        lo = simd::add32(lo, simd::madd(simd::unpacklo16(a, b), wp));
+                        hi = simd::add32(hi, simd::madd(simd::unpackhi16(a, b), wp));
+                    }
+                    reg out0, out1;
+                    simd::order(lo, hi, out0, out1);
+                    simd::store(acc + x, simd::add32(simd::load(acc + x), out0));
+                    simd::store(acc + x + L32, simd::add32(simd::load(acc + x + L32), out1));
+                }
+            } else {
+                for(; x + L32 <= n; x += L32) {
+                    reg s = simd::load(acc + x);
+                    for(size_t i = 0; i < K; ++i)
+                        s = simd::add32(s, simd::mullo32(simd::load(rows[i] + x), simd::set1_32(w[i])));
+                    simd::store(acc + x, s);
+                }
+            }
+            const TIN* tail[16];
+            for(size_t i = 0; i < K; ++i) tail[i] = rows[i] + x;
+            scalar_type::vcol_i32(tail, w, K, acc + x, n - x);
+        }
+
+        template <typename TACC, typename TDST>
+        static void store(const TACC* acc, TDST* dst, size_t n, unsigned shift) {
+            static_assert(sizeof(TDST) <= 2, "stencil_kernel::store: uint8 or int16 output");
+            const int s = int(shift);
+            const int32_t round = shift ? int32_t(1) << (shift - 1) : 0;
+            // Outputs per iteration: one register of output elements.
+            constexpr size_t step = B / sizeof(TDST);
+            size_t x = 0;
+            for(; x + step <= n; x += step) {
+                reg out;
+                if constexpr (sizeof(TACC) == 2) {
+                    const reg r = simd::set1_16(int16_t(round));
+                    const reg v0 = simd::srai16(simd::add16(simd::load(acc + x), r), s);
+                    if constexpr (sizeof(TDST) == 1) {
+                        const reg v1 = simd::srai16(simd::add16(simd::load(acc + x + L16), r), s);
+                        out = simd::packus16(v0, v1);
+                    } else {
+                        out = v0;
+                    }
+                } else {
+                    const reg r = simd::set1_32(round);
+                    const reg v0 = simd::srai32(simd::add32(simd::load(acc + x), r), s);
+                    const reg v1 = simd::srai32(simd::add32(simd::load(acc + x + L32), r), s);
+                    const reg w0 = simd::packs32(v0, v1);
+                    if constexpr (sizeof(TDST) == 1) {
+                        const reg v2 = simd::srai32(simd::add32(simd::load(acc + x + 2 * L32), r), s);
+                        const reg v3 = simd::srai32(simd::add32(simd::load(acc + x + 3 * L32), r), s);
+                        out = simd::packus16(w0, simd::packs32(v2, v3));
+                    } else {
+                        out = w0;
+                    }
+                }
+                simd::store(dst + x, out);
+            }
+            scalar_type::store(acc + x, dst + x, n - x, shift);
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file kernel_strided.h
+ * @brief Header file for the strided copy kernels behind the adaptive views.
+ *
+ * This file defines `strided_kernel`, which copies `n` elements from a source with an
+ * arbitrary element stride into a contiguous or strided destination. Contiguous data
+ * is moved with `memcpy`; the AVX specialization gathers 32- and 64-bit elements with
+ * `vpgatherdd`/`vpgatherdq`, everything else is a scalar loop.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_STRIDED_H
+#define ADAPTIVE_KERNEL_STRIDED_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include <adaptive_techniq.h>
+
+#ifdef __AVX2__
+#include "immintrin.h"
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class strided_kernel
+     * @brief Scalar strided copy, used for every technique without a specialization.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct strided_kernel {
+        /**
+         * @brief Copies `src[i * sstride]` to `dst[i * dstride]` for `i` in `[0, n)`.
+         */
+        static void copy(const TINT* src, ptrdiff_t sstride, TINT* dst, ptrdiff_t dstride, size_t n) {
+            if(sstride == 1 && dstride == 1) {
+                std::memmove(dst, src, n * sizeof(TINT));
+                return;
+            }
+            for(size_t i = 0; i < n; ++i) dst[ptrdiff_t(i) * dstride] = src[ptrdiff_t(i) * sstride];
+        }
+    };
+
+#ifdef __AVX2__
+    /**
+     * @brief Specialization for AVX technique
+     */
+    template <typename TINT>
+    struct strided_kernel<TINT, techn_type::AVX> {
+        using scalar_type = strided_kernel<TINT, techn_type::Scalar>;
+
+        static void copy(const TINT* src, ptrdiff_t sstride, TINT* dst, ptrdiff_t dstride, size_t n) {
+            constexpr ptrdiff_t lanes = 32 / ptrdiff_t(sizeof(TINT) < 4 ? 4 : sizeof(TINT));
+            constexpr ptrdiff_t limit = std::numeric_limits<int32_t>::max() / lanes;
+            size_t i = 0;
+
+            if((sizeof(TINT) == 4 || sizeof(TINT) == 8) && dstride == 1 && sstride != 1 &&
+               sstride < limit && sstride > -limit) {
+                const int32_t s = int32_t(sstride);
+                if constexpr (sizeof(TINT) == 4) {
+                    const __m256i idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(s));
+                    for(; i + 8 <= n; i += 8) {
+                        __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src + ptrdiff_t(i) * sstride), idx, 4);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+                    }
+                } else if constexpr (sizeof(TINT) == 8) {
+                    const __m128i idx = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(s));
+                    for(; i + 4 <= n; i += 4) {
+                        __m256i v = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src + ptrdiff_t(i) * sstride), idx, 8);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+                    }
+                }
+            }
+            scalar_type::copy(src + ptrdiff_t(i) * sstride, sstride, dst + ptrdiff_t(i) * dstride, dstride, n - i);
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <typename TINT>
+    struct strided_kernel<TINT, techn_type::AVX512> : strided_kernel<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,543 @@
+/**
+ * @file kernel_transpose.h
+ * @brief Header file for the matrix transpose kernels.
+ *
+ * This file defines the `transpose_kernel` template, which transposes a small square
+ * tile completely in registers, and the cache-oblivious drivers that walk a whole
+ * matrix with it. The tile kernels use unpack/permute sequences on SSE and AVX for
+ * 8-, 16-, 32- and 64-bit elements; every other combination falls back to the scalar
+ * kernel.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_KERNEL_TRANSPOSE_H
+#define ADAPTIVE_KERNEL_TRANSPOSE_H
+
+#include <cstddef>
+#include <algorithm>
+
+#include <adaptive_techniq.h>
+
+#ifdef __SSE2__
+#include "emmintrin.h"
+#endif
+#ifdef __AVX2__
+#include "immintrin.h"
+#endif
+
+/**
+ * @brief Side length (in elements) below which the recursion stops and the tiles are walked directly.
+ */
+#ifndef ADAPTIVE_TRANSPOSE_LEAF
+#define ADAPTIVE_TRANSPOSE_LEAF 64
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @class transpose_kernel
+     * @brief Scalar tile transpose, used for every technique without a specialization.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH>
+    struct transpose_kernel {
+        using value_type = TINT;
+        using size_type = size_t;
+
+        /**
+         * @brief Side length of the tile handled by `transpose_tile`.
+         */
+        static constexpr size_type tile = 8;
+
+        /**
+         * @brief Transposes one `tile` x `tile` block.
+         *
+         * @param src The first element of the source block.
+         * @param sstride The row stride of the source in elements.
+         * @param dst The first element of the destination block.
+         * @param dstride The row stride of the destination in elements.
+         */
+        static void transpose_tile(const value_type* src, size_type sstride, value_type* dst, size_type dstride) {
+            for(size_type r = 0; r < tile; ++r)
+                for(size_type c = 0; c < tile; ++c)
+                    dst[c * dstride + r] = src[r * sstride + c];
+        }
+    };
+
+#ifdef __SSE2__
+    /**
+     * @brief Transposes a 8x8 block of bytes with SSE2 unpack instructions.
+     */
+    inline void transpose_8x8_epi8_sse(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m128i r0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 0 * sstride));
+        __m128i r1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 1 * sstride));
+        __m128i r2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 2 * sstride));
+        __m128i r3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 3 * sstride));
+        __m128i r4 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 4 * sstride));
+        __m128i r5 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 5 * sstride));
+        __m128i r6 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 6 * sstride));
+        __m128i r7 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + 7 * sstride));
+
+        __m128i a0 = _mm_unpacklo_epi8(r0, r1);
+        __m128i a1 = _mm_unpacklo_epi8(r2, r3);
+        __m128i a2 = _mm_unpacklo_epi8(r4, r5);
+        __m128i a3 = _mm_unpacklo_epi8(r6, r7);
+
+        __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+        __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+        __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+        __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+
+        __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+        __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+        __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+        __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 0 * dstride), c0);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 1 * dstride), _mm_unpackhi_epi64(c0, c0));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 2 * dstride), c1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 3 * dstride), _mm_unpackhi_epi64(c1, c1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 4 * dstride), c2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 5 * dstride), _mm_unpackhi_epi64(c2, c2));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 6 * dstride), c3);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 7 * dstride), _mm_unpackhi_epi64(c3, c3));
+    }
+    /**
+     * @brief Transposes eight registers of 8x16-bit elements in place.
+     */
+    inline void transpose_8x8_epi16_regs(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3,
+                                         __m128i& r4, __m128i& r5, __m128i& r6, __m128i& r7) {
+        __m128i a0 = _mm_unpacklo_epi16(r0, r1);
+        __m128i a1 = _mm_unpackhi_epi16(r0, r1);
+        __m128i a2 = _mm_unpacklo_epi16(r2, r3);
+        __m128i a3 = _mm_unpackhi_epi16(r2, r3);
+        __m128i a4 = _mm_unpacklo_epi16(r4, r5);
+        __m128i a5 = _mm_unpackhi_epi16(r4, r5);
+        __m128i a6 = _mm_unpacklo_epi16(r6, r7);
+        __m128i a7 = _mm_unpackhi_epi16(r6, r7);
+
+        __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+        __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+        __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+        __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+        __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+        __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+        __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+        __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+        r0 = _mm_unpacklo_epi64(b0, b4);
+        r1 = _mm_unpackhi_epi64(b0, b4);
+        r2 = _mm_unpacklo_epi64(b1, b5);
+        r3 = _mm_unpackhi_epi64(b1, b5);
+        r4 = _mm_unpacklo_epi64(b2, b6);
+        r5 = _mm_unpackhi_epi64(b2, b6);
+        r6 = _mm_unpacklo_epi64(b3, b7);
+        r7 = _mm_unpackhi_epi64(b3, b7);
+    }
+    /**
+     * @brief Transposes a 8x8 block of 16-bit elements with SSE2 unpack instructions.
+     */
+    inline void transpose_8x8_epi16_sse(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 0 * sstride));
+        __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 1 * sstride));
+        __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * sstride));
+        __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * sstride));
+        __m128i r4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * sstride));
+        __m128i r5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 5 * sstride));
+        __m128i r6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 6 * sstride));
+        __m128i r7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 7 * sstride));
+
+        transpose_8x8_epi16_regs(r0, r1, r2, r3, r4, r5, r6, r7);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 0 * dstride), r0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 1 * dstride), r1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * dstride), r2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 3 * dstride), r3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * dstride), r4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 5 * dstride), r5);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 6 * dstride), r6);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 7 * dstride), r7);
+    }
+    /**
+     * @brief Transposes a 4x4 block of 32-bit elements with SSE2 unpack instructions.
+     */
+    inline void transpose_4x4_epi32_sse(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 0 * sstride));
+        __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 1 * sstride));
+        __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * sstride));
+        __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * sstride));
+
+        __m128i a0 = _mm_unpacklo_epi32(r0, r1);
+        __m128i a1 = _mm_unpackhi_epi32(r0, r1);
+        __m128i a2 = _mm_unpacklo_epi32(r2, r3);
+        __m128i a3 = _mm_unpackhi_epi32(r2, r3);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 0 * dstride), _mm_unpacklo_epi64(a0, a2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 1 * dstride), _mm_unpackhi_epi64(a0, a2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * dstride), _mm_unpacklo_epi64(a1, a3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 3 * dstride), _mm_unpackhi_epi64(a1, a3));
+    }
+    /**
+     * @brief Transposes a 2x2 block of 64-bit elements with SSE2 unpack instructions.
+     */
+    inline void transpose_2x2_epi64_sse(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 0 * sstride));
+        __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 1 * sstride));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 0 * dstride), _mm_unpacklo_epi64(r0, r1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 1 * dstride), _mm_unpackhi_epi64(r0, r1));
+    }
+
+    /**
+     * @brief Specialization for SSE technique
+     */
+    template <typename TINT>
+    struct transpose_kernel<TINT, techn_type::SSE> {
+        using value_type = TINT;
+        using size_type = size_t;
+
+        static constexpr size_type tile = (sizeof(TINT) == 4) ? 4 : (sizeof(TINT) == 8) ? 2 : 8;
+
+        static void transpose_tile(const value_type* src, size_type sstride, value_type* dst, size_type dstride) {
+            if constexpr (sizeof(TINT) == 1) {
+                transpose_8x8_epi8_sse(src, sstride, dst, dstride);
+            } else if constexpr (sizeof(TINT) == 2) {
+                transpose_8x8_epi16_sse(src, sstride * 2, dst, dstride * 2);
+            } else if constexpr (sizeof(TINT) == 4) {
+                transpose_4x4_epi32_sse(src, sstride * 4, dst, dstride * 4);
+            } else if constexpr (sizeof(TINT) == 8) {
+                transpose_2x2_epi64_sse(src, sstride * 8, dst, dstride * 8);
+            } else {
+                transpose_kernel<TINT, techn_type::Scalar>::transpose_tile(src, sstride, dst, dstride);
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief Transposes a 16x16 block of 16-bit elements with AVX2.
+     *
+     * Each 128-bit lane is transposed as an independent 8x8 block, the four blocks are
+     * then exchanged between the two halves with `vperm2i128`.
+     */
+    inline void transpose_16x16_epi16_avx(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+        __m256i r[16];
+
+        for(int i = 0; i < 16; ++i)
+            r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * sstride));
+
+        for(int h = 0; h < 16; h += 8) {
+            __m256i a0 = _mm256_unpacklo_epi16(r[h + 0], r[h + 1]);
+            __m256i a1 = _mm256_unpackhi_epi16(r[h + 0], r[h + 1]);
+            __m256i a2 = _mm256_unpacklo_epi16(r[h + 2], r[h + 3]);
+            __m256i a3 = _mm256_unpackhi_epi16(r[h + 2], r[h + 3]);
+            __m256i a4 = _mm256_unpacklo_epi16(r[h + 4], r[h + 5]);
+            __m256i a5 = _mm256_unpackhi_epi16(r[h + 4], r[h + 5]);
+            __m256i a6 = _mm256_unpacklo_epi16(r[h + 6], r[h + 7]);
+            __m256i a7 = _mm256_unpackhi_epi16(r[h + 6], r[h + 7]);
+
+            __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+            __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+            __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+            __m256i b3 = _mm256_unpackhi_epi32(a1, a3);
+            __m256i b4 = _mm256_unpacklo_epi32(a4, a6);
+            __m256i b5 = _mm256_unpackhi_epi32(a4, a6);
+            __m256i b6 = _mm256_unpacklo_epi32(a5, a7);
+            __m256i b7 = _mm256_unpackhi_epi32(a5, a7);
+
+            r[h + 0] = _mm256_unpacklo_epi64(b0, b4);
+            r[h + 1] = _mm256_unpackhi_epi64(b0, b4);
+            r[h + 2] = _mm256_unpacklo_epi64(b1, b5);
+            r[h + 3] = _mm256_unpackhi_epi64(b1, b5);
+            r[h + 4] = _mm256_unpacklo_epi64(b2, b6);
+            r[h + 5] = _mm256_unpackhi_epi64(b2, b6);
+            r[h + 6] = _mm256_unpacklo_epi64(b3, b7);
+            r[h + 7] = _mm256_unpackhi_epi64(b3, b7);
+        }
+        for(int i = 0; i < 8; ++i) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * dstride),
+                                _mm256_permute2x128_si256(r[i], r[i + 8], 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + (i + 8) * dstride),
+                                _mm256_permute2x128_si256(r[i], r[i + 8], 0x31));
+        }
+    }
+    /**
+     * @brief Transposes a 8x8 block of 32-bit elements with AVX2.
+     */
+    inline void transpose_8x8_epi32_avx(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 0 * sstride));
+        __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 1 * sstride));
+        __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * sstride));
+        __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * sstride));
+        __m256i r4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * sstride));
+        __m256i r5 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 5 * sstride));
+        __m256i r6 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 6 * sstride));
+        __m256i r7 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 7 * sstride));
+
+        __m256i a0 = _mm256_unpacklo_epi32(r0, r1);
+        __m256i a1 = _mm256_unpackhi_epi32(r0, r1);
+        __m256i a2 = _mm256_unpacklo_epi32(r2, r3);
+        __m256i a3 = _mm256_unpackhi_epi32(r2, r3);
+        __m256i a4 = _mm256_unpacklo_epi32(r4, r5);
+        __m256i a5 = _mm256_unpackhi_epi32(r4, r5);
+        __m256i a6 = _mm256_unpacklo_epi32(r6, r7);
+        __m256i a7 = _mm256_unpackhi_epi32(r6, r7);
+
+        __m256i b0 = _mm256_unpacklo_epi64(a0, a2);
+        __m256i b1 = _mm256_unpackhi_epi64(a0, a2);
+        __m256i b2 = _mm256_unpacklo_epi64(a1, a3);
+        __m256i b3 = _mm256_unpackhi_epi64(a1, a3);
+        __m256i b4 = _mm256_unpacklo_epi64(a4, a6);
+        __m256i b5 = _mm256_unpackhi_epi64(a4, a6);
+        __m256i b6 = _mm256_unpacklo_epi64(a5, a7);
+        __m256i b7 = _mm256_unpackhi_epi64(a5, a7);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 0 * dstride), _mm256_permute2x128_si256(b0, b4, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 1 * dstride), _mm256_permute2x128_si256(b1, b5, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 2 * dstride), _mm256_permute2x128_si256(b2, b6, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 3 * dstride), _mm256_permute2x128_si256(b3, b7, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * dstride), _mm256_permute2x128_si256(b0, b4, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 5 * dstride), _mm256_permute2x128_si256(b1, b5, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 6 * dstride), _mm256_permute2x128_si256(b2, b6, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 7 * dstride), _mm256_permute2x128_si256(b3, b7, 0x31));
+    }
+    /**
+     * @brief Transposes a 4x4 block of 64-bit elements with AVX2.
+     */
+    inline void transpose_4x4_epi64_avx(const void* src, size_t sstride, void* dst, size_t dstride) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+
+        __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 0 * sstride));
+        __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 1 * sstride));
+        __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * sstride));
+        __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * sstride));
+
+        __m256i a0 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i a1 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i a2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i a3 = _mm256_unpackhi_epi64(r2, r3);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 0 * dstride), _mm256_permute2x128_si256(a0, a2, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 1 * dstride), _mm256_permute2x128_si256(a1, a3, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 2 * dstride), _mm256_permute2x128_si256(a0, a2, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 3 * dstride), _mm256_permute2x128_si256(a1, a3, 0x31));
+    }
+
+    /**
+     * @brief Specialization for AVX technique
+     *
+     * Bytes stay on the 8x8 SSE kernel, a 32x32 byte tile would need more registers than there are.
+     */
+    template <typename TINT>
+    struct transpose_kernel<TINT, techn_type::AVX> {
+        using value_type = TINT;
+        using size_type = size_t;
+
+        static constexpr size_type tile = (sizeof(TINT) == 2) ? 16 : (sizeof(TINT) == 8) ? 4 : 8;
+
+        static void transpose_tile(const value_type* src, size_type sstride, value_type* dst, size_type dstride) {
+            if constexpr (sizeof(TINT) == 1) {
+                transpose_8x8_epi8_sse(src, sstride, dst, dstride);
+            } else if constexpr (sizeof(TINT) == 2) {
+                transpose_16x16_epi16_avx(src, sstride * 2, dst, dstride * 2);
+            } else if constexpr (sizeof(TINT) == 4) {
+                transpose_8x8_epi32_avx(src, sstride * 4, dst, dstride * 4);
+            } else if constexpr (sizeof(TINT) == 8) {
+                transpose_4x4_epi64_avx(src, sstride * 8, dst, dstride * 8);
+            } else {
+                transpose_kernel<TINT, techn_type::Scalar>::transpose_tile(src, sstride, dst, dstride);
+            }
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    /**
+     * @brief Specialization for AVX512 technique
+     */
+    template <typename TINT>
+    struct transpose_kernel<TINT, techn_type::AVX512> : transpose_kernel<TINT, techn_type::AVX> { };
+#endif
+
+    /**
+     * @brief Transposes a block that fits into the L1 cache, tile by tile.
+     *
+     * Full tiles go through `TKERNEL::transpose_tile`, the ragged right and bottom
+     * edges are copied element by element.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_leaf(const TINT* src, size_t sstride, TINT* dst, size_t dstride, size_t rows, size_t cols) {
+        constexpr size_t T = TKERNEL::tile;
+        const size_t rfull = rows - rows % T;
+        const size_t cfull = cols - cols % T;
+
+        for(size_t r = 0; r < rfull; r += T) {
+            for(size_t c = 0; c < cfull; c += T)
+                TKERNEL::transpose_tile(src + r * sstride + c, sstride, dst + c * dstride + r, dstride);
+            for(size_t rr = r; rr < r + T; ++rr)
+                for(size_t c = cfull; c < cols; ++c)
+                    dst[c * dstride + rr] = src[rr * sstride + c];
+        }
+        for(size_t r = rfull; r < rows; ++r)
+            for(size_t c = 0; c < cols; ++c)
+                dst[c * dstride + r] = src[r * sstride + c];
+    }
+
+    /**
+     * @brief Cache-oblivious out-of-place transpose.
+     *
+     * The larger dimension is halved (on a tile boundary) until the block fits in
+     * `ADAPTIVE_TRANSPOSE_LEAF`, so every level of the cache hierarchy sees a working
+     * set that fits without knowing its size.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_recursive(const TINT* src, size_t sstride, TINT* dst, size_t dstride, size_t rows, size_t cols) {
+        constexpr size_t T = TKERNEL::tile;
+        constexpr size_t leaf = std::max<size_t>(ADAPTIVE_TRANSPOSE_LEAF, T);
+
+        if(rows <= leaf && cols <= leaf) {
+            transpose_leaf<TKERNEL>(src, sstride, dst, dstride, rows, cols);
+        } else if(rows >= cols) {
+            size_t half = ((rows / 2 + T - 1) / T) * T;
+            transpose_recursive<TKERNEL>(src, sstride, dst, dstride, half, cols);
+            transpose_recursive<TKERNEL>(src + half * sstride, sstride, dst + half, dstride, rows - half, cols);
+        } else {
+            size_t half = ((cols / 2 + T - 1) / T) * T;
+            transpose_recursive<TKERNEL>(src, sstride, dst, dstride, rows, half);
+            transpose_recursive<TKERNEL>(src + half, sstride, dst + half * dstride, dstride, rows, cols - half);
+        }
+    }
+
+    /**
+     * @brief Copies the transpose of a `T` x `T` scratch tile back into strided storage.
+     */
+    template <size_t T, typename TINT>
+    inline void transpose_store_tile(const TINT* tmp, TINT* dst, size_t dstride) {
+        for(size_t i = 0; i < T; ++i)
+            std::copy(tmp + i * T, tmp + i * T + T, dst + i * dstride);
+    }
+
+    /**
+     * @brief Exchanges block `b` (`rows` x `cols`) with the transpose of block `c` (`cols` x `rows`).
+     *
+     * Both blocks live in the same matrix with row stride `stride` and must not overlap.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_swap_leaf(TINT* b, TINT* c, size_t stride, size_t rows, size_t cols) {
+        constexpr size_t T = TKERNEL::tile;
+        const size_t rfull = rows - rows % T;
+        const size_t cfull = cols - cols % T;
+        TINT ta[T * T];
+        TINT tb[T * T];
+
+        for(size_t r = 0; r < rfull; r += T) {
+            for(size_t k = 0; k < cfull; k += T) {
+                TINT* pb = b + r * stride + k;
+                TINT* pc = c + k * stride + r;
+
+                TKERNEL::transpose_tile(pb, stride, ta, T);
+                TKERNEL::transpose_tile(pc, stride, tb, T);
+                transpose_store_tile<T>(ta, pc, stride);
+                transpose_store_tile<T>(tb, pb, stride);
+            }
+            for(size_t rr = r; rr < r + T; ++rr)
+                for(size_t k = cfull; k < cols; ++k)
+                    std::swap(b[rr * stride + k], c[k * stride + rr]);
+        }
+        for(size_t r = rfull; r < rows; ++r)
+            for(size_t k = 0; k < cols; ++k)
+                std::swap(b[r * stride + k], c[k * stride + r]);
+    }
+
+    /**
+     * @brief Cache-oblivious exchange of block `b` with the transpose of block `c`.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_swap_recursive(TINT* b, TINT* c, size_t stride, size_t rows, size_t cols) {
+        constexpr size_t T = TKERNEL::tile;
+        constexpr size_t leaf = std::max<size_t>(ADAPTIVE_TRANSPOSE_LEAF, T);
+
+        if(rows <= leaf && cols <= leaf) {
+            transpose_swap_leaf<TKERNEL>(b, c, stride, rows, cols);
+        } else if(rows >= cols) {
+            size_t half = ((rows / 2 + T - 1) / T) * T;
+            transpose_swap_recursive<TKERNEL>(b, c, stride, half, cols);
+            transpose_swap_recursive<TKERNEL>(b + half * stride, c + half, stride, rows - half, cols);
+        } else {
+            size_t half = ((cols / 2 + T - 1) / T) * T;
+            transpose_swap_recursive<TKERNEL>(b, c, stride, rows, half);
+            transpose_swap_recursive<TKERNEL>(b + half, c + half * stride, stride, rows, cols - half);
+        }
+    }
+
+    /**
+     * @brief Transposes a small square block in place, tile by tile.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_inplace_leaf(TINT* a, size_t stride, size_t n) {
+        constexpr size_t T = TKERNEL::tile;
+        const size_t full = n - n % T;
+        TINT ta[T * T];
+
+        for(size_t r = 0; r < full; r += T) {
+            TINT* pd = a + r * stride + r;
+            TKERNEL::transpose_tile(pd, stride, ta, T);
+            transpose_store_tile<T>(ta, pd, stride);
+        }
+        for(size_t r = 0; r < full; r += T)
+            transpose_swap_leaf<TKERNEL>(a + r * stride + r + T, a + (r + T) * stride + r, stride, T, full - r - T);
+        for(size_t r = 0; r < n; ++r)
+            for(size_t k = std::max(r + 1, full); k < n; ++k)
+                std::swap(a[r * stride + k], a[k * stride + r]);
+    }
+
+    /**
+     * @brief Cache-oblivious in-place transpose of a square `n` x `n` block.
+     *
+     * The block is split into quadrants [A B; C D]: A and D are transposed in place
+     * recursively, B and C are transposed into each other.
+     */
+    template <typename TKERNEL, typename TINT>
+    void transpose_inplace_recursive(TINT* a, size_t stride, size_t n) {
+        constexpr size_t T = TKERNEL::tile;
+        constexpr size_t leaf = std::max<size_t>(ADAPTIVE_TRANSPOSE_LEAF, T);
+
+        if(n <= leaf) {
+            transpose_inplace_leaf<TKERNEL>(a, stride, n);
+            return;
+        }
+        size_t h = ((n / 2 + T - 1) / T) * T;
+
+        transpose_inplace_recursive<TKERNEL>(a, stride, h);
+        transpose_inplace_recursive<TKERNEL>(a + h * stride + h, stride, n - h);
+        transpose_swap_recursive<TKERNEL>(a + h, a + h * stride, stride, h, n - h);
+    }
+}
+}
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @file numa.h
+ * @brief Header file for the NUMA placement helpers of `numa_allocator` and `numa_place`.
+ *
+ * This file finds the NUMA nodes of the machine and places memory on them with the
+ * `mbind` system call directly, so the library needs neither libnuma nor its headers.
+ * Every function is a no-op on machines with a single node and on other systems than
+ * Linux, and a failed `mbind` (no permission, unsupported page size) leaves the memory
+ * where the kernel would have put it anyway.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_NUMA_H
+#define ADAPTIVE_NUMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <internal/parallel_for.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(SYS_mbind) && defined(SYS_getcpu)
+#define ADAPTIVE_HAS_NUMA 1
+#endif
+#endif
+
+#ifndef ADAPTIVE_NUMA_MAX_NODES
+/**
+ * @brief The highest node number + 1 the helpers place memory on
+ */
+#define ADAPTIVE_NUMA_MAX_NODES 1024
+#endif
+
+namespace adaptive {
+    /**
+     * @brief Where the pages of an allocation go on a machine with several NUMA nodes
+     */
+    enum class numa_policy {
+        /**
+         * @brief The kernel default, the node of the thread that writes a page first
+         */
+        none,
+        /**
+         * @brief Pages round robin over all nodes, for data every thread reads
+         */
+        interleave,
+        /**
+         * @brief Each chunk of the `parallel_for` partition on the node of the thread running it
+         */
+        first_touch
+    };
+
+namespace internal {
+    /**
+     * @brief The online NUMA nodes, read once from sysfs
+     */
+    struct numa_topology {
+        static constexpr size_t mask_words = ADAPTIVE_NUMA_MAX_NODES / (8 * sizeof(unsigned long));
+
+        unsigned long mask[mask_words] = { };
+        size_t nodes = 1;
+
+        static const numa_topology& get() {
+            static const numa_topology _topology = detect();
+            return _topology;
+        }
+
+    private:
+        static numa_topology detect() {
+            numa_topology _result;
+#ifdef ADAPTIVE_HAS_NUMA
+            // A list of ranges like "0-3,8-11".
+            std::FILE* f = std::fopen("/sys/devices/system/node/online", "r");
+            if(f == nullptr) return _result;
+            char _line[256] = { };
+            const bool ok = std::fgets(_line, sizeof(_line), f) != nullptr;
+            std::fclose(f);
+            if(!ok) return _result;
+
+            size_t _count = 0;
+            for(const char* p = _line; *p >= '0' && *p <= '9'; ) {
+                size_t lo = 0, hi;
+                while(*p >= '0' && *p <= '9') lo = lo * 10 + size_t(*p++ - '0');
+                hi = lo;
+                if(*p == '-') {
+                    hi = 0;
+                    ++p;
+                    while(*p >= '0' && *p <= '9') hi = hi * 10 + size_t(*p++ - '0');
+                }
+                for(size_t n = lo; n <= hi && n < ADAPTIVE_NUMA_MAX_NODES; ++n, ++_count)
+                    _result.mask[n / (8 * sizeof(unsigned long))] |= 1ul << (n % (8 * sizeof(unsigned long)));
+                if(*p == ',') ++p;
+            }
+            if(_count != 0) _result.nodes = _count;
+#endif
+            return _result;
+        }
+    };
+
+    /**
+     * @brief Get the number of online NUMA nodes, 1 where they are not known
+     */
+    inline size_t numa_node_count() noexcept {
+        return numa_topology::get().nodes;
+    }
+
+    /**
+     * @brief Get the node of the CPU the calling thread runs on, 0 where it is not known
+     */
+    inline unsigned numa_current_node() noexcept {
+#ifdef ADAPTIVE_HAS_NUMA
+        unsigned _cpu = 0, _node = 0;
+        if(syscall(SYS_getcpu, &_cpu, &_node, nullptr) == 0) return _node;
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief Applies an `mbind` mode to the whole pages of `[p, p + bytes)`
+     *
+     * @param mode `MPOL_PREFERRED` (1) or `MPOL_INTERLEAVE` (3)
+     * @param mask The nodes, `ADAPTIVE_NUMA_MAX_NODES` bits
+     * @param move Also migrate pages that are already placed (`MPOL_MF_MOVE`)
+     * @return True if the kernel accepted the policy
+     */
+    inline bool numa_mbind(void* p, size_t bytes, int mode, const unsigned long* mask, bool move) noexcept {
+#ifdef ADAPTIVE_HAS_NUMA
+        const uintptr_t page = uintptr_t(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = (reinterpret_cast<uintptr_t>(p) + page - 1) & ~(page - 1);
+        const uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes) & ~(page - 1);
+        if(end <= begin) return false;
+        return syscall(SYS_mbind, begin, end - begin, mode, mask, ADAPTIVE_NUMA_MAX_NODES + 1,
+                       move ? 2u /* MPOL_MF_MOVE */ : 0u) == 0;
+#else
+        (void)p; (void)bytes; (void)mode; (void)mask; (void)move;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Spreads the pages of `[p, p + bytes)` round robin over all nodes
+     *
+     * @param move Also migrate pages that are already placed
+     */
+    inline bool numa_interleave(void* p, size_t bytes, bool move = false) noexcept {
+        if(numa_node_count() < 2) return false;
+        return numa_mbind(p, bytes, 3 /* MPOL_INTERLEAVE */, numa_topology::get().mask, move);
+    }
+
+    /**
+     * @brief Places every chunk of `count` elements of `size` bytes on the node of the pool thread that gets it
+     *
+     * The chunks are the ones `parallel_for(0, count, 0, ...)` makes, so kernels that use
+     * the same partition read node-local memory. Pages that are not placed yet are placed
+     * when they are zeroed here, placed ones are migrated if `move` is set.
+     *
+     * @param zero Writes zeros to the chunks, for fresh allocations
+     * @param move Migrate pages that are already placed
+     */
+    inline void numa_first_touch(void* p, size_t count, size_t size, bool zero, bool move,
+                                 thread_pool& pool = thread_pool::instance()) {
+        if(numa_node_count() < 2 || count == 0) return;
+        unsigned char* bytes = static_cast<unsigned char*>(p);
+        parallel_for(0, count, pool.size(), [=](size_t, size_t begin, size_t end) {
+            if(move) {
+                unsigned long _mask[numa_topology::mask_words] = { };
+                const unsigned node = numa_current_node() % ADAPTIVE_NUMA_MAX_NODES;
+                _mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+                numa_mbind(bytes + begin * size, (end - begin) * size, 1 /* MPOL_PREFERRED */, _mask, true);
+            }
+            if(zero) std::memset(bytes + begin * size, 0, (end - begin) * size);
+        }, pool);
+    }
+}
+}
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file parallel_for.h
+ * @brief Header file for the `parallel_for` helper.
+ *
+ * This file defines `parallel_for`, which splits a range into contiguous chunks and runs
+ * them on the library thread pool. The multi-threaded kernels of the library use it so
+ * the partitioning lives in one place.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_PARALLEL_FOR_H
+#define ADAPTIVE_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include <adaptive_thread_pool.h>
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Runs `fn(chunk, begin, end)` for every chunk of a partition of a range
+     *
+     * Chunk `i` covers `[bounds[i], bounds[i + 1])`.
+     *
+     * @param bounds The `chunks + 1` boundaries of the partition
+     * @param fn The work function
+     * @param pool The pool to run on
+     */
+    template <typename TFUNC>
+    void parallel_for_bounds(const std::vector<size_t>& bounds, TFUNC&& fn,
+                             thread_pool& pool = thread_pool::instance()) {
+        pool.parallel(bounds.size() - 1, [&fn, &bounds](size_t i) { fn(i, bounds[i], bounds[i + 1]); });
+    }
+
+    /**
+     * @brief Runs `fn(chunk, begin, end)` over `[begin, end)` split into equal chunks
+     *
+     * @param begin The first index
+     * @param end One past the last index
+     * @param threads The number of threads, 0 selects all hardware threads
+     * @param fn The work function
+     * @param pool The pool to run on
+     */
+    template <typename TFUNC>
+    void parallel_for(size_t begin, size_t end, size_t threads, TFUNC&& fn,
+                      thread_pool& pool = thread_pool::instance()) {
+        const size_t n = end - begin;
+        const size_t chunks = std::max<size_t>(1, std::min(resolve_threads(threads), n));
+        std::vector<size_t> bounds(chunks + 1);
+
+        for(size_t i = 0; i <= chunks; ++i) bounds[i] = begin + n * i / chunks;
+        parallel_for_bounds(bounds, fn, pool);
+    }
+}
+}
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @file simd_util.h
+ * @brief Header file for small SIMD helpers shared by the kernels.
+ *
+ * Horizontal reductions and emulations of instructions the SSE/AVX2 instruction sets
+ * lack (like a 64-bit low multiply), used by several kernel headers, and `lane_simd`,
+ * the wrapping lane-wise arithmetic of one register for kernels that are written once
+ * for every technique.
+ *
+ * @author Amber-Sophia Schröck
+ * @date 2026-10-17
+ * @version 1.0
+ *
+ * @copyright SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef ADAPTIVE_SIMD_UTIL_H
+#define ADAPTIVE_SIMD_UTIL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <adaptive_techniq.h>
+
+#ifdef __SSE2__
+#include "emmintrin.h"
+#endif
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include "immintrin.h"
+#endif
+
+namespace adaptive {
+namespace internal {
+    /**
+     * @brief Number of trailing zero bits of `v`, which must not be 0 (`tzcnt`/`bsf`).
+     */
+    inline int ctz(uint32_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(v);
+#else
+        int _result = 0;
+        for(; (v & 1u) == 0; v >>= 1) ++_result;
+        return _result;
+#endif
+    }
+    inline int ctz(uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        int _result = 0;
+        for(; (v & 1u) == 0; v >>= 1) ++_result;
+        return _result;
+#endif
+    }
+    /**
+     * @brief Number of leading zero bits of `v`, which must not be 0 (`lzcnt`/`bsr`).
+     */
+    inline int clz(uint32_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clz(v);
+#else
+        int _result = 0;
+        for(; (v & 0x80000000u) == 0; v <<= 1) ++_result;
+        return _result;
+#endif
+    }
+    inline int clz(uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(v);
+#else
+        int _result = 0;
+        for(; (v & 0x8000000000000000ull) == 0; v <<= 1) ++_result;
+        return _result;
+#endif
+    }
+
+    /**
+     * @brief Number of set bits of `v`.
+     */
+    inline int popcount(uint32_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(v);
+#else
+        int _result = 0;
+        for(; v != 0; v &= v - 1) ++_result;
+        return _result;
+#endif
+    }
+
+#ifdef __SSE2__
+    /**
+     * @brief Sum of the four 32-bit lanes of `v`.
+     */
+    inline int32_t hsum_epi32(__m128i v) {
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(v);
+    }
+    /**
+     * @brief Sum of the two 64-bit lanes of `v`.
+     */
+    inline int64_t hsum_epi64(__m128i v) {
+        v = _mm_add_epi64(v, _mm_unpackhi_epi64(v, v));
+        return _mm_cvtsi128_si64(v);
+    }
+    /**
+     * @brief Low 64 bits of the lane-wise 64x64 bit product, SSE has no `pmullq`.
+     */
+    inline __m128i mullo_epi64_sse(__m128i a, __m128i b) {
+        __m128i lo = _mm_mul_epu32(a, b);
+        __m128i c1 = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+        __m128i c2 = _mm_mul_epu32(a, _mm_srli_epi64(b, 32));
+        return _mm_add_epi64(lo, _mm_slli_epi64(_mm_add_epi64(c1, c2), 32));
+    }
+    /**
+     * @brief Signed 64-bit `a > b` per lane, `pcmpgtq` needs SSE4.2.
+     */
+    inline __m128i cmpgt_epi64_sse(__m128i a, __m128i b) {
+#ifdef __SSE4_2__
+        return _mm_cmpgt_epi64(a, b);
+#else
+        // High words compare signed, low words unsigned and only count on equal high words.
+        const __m128i bias = _mm_set_epi32(0, INT32_MIN, 0, INT32_MIN);
+        const __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        const __m128i r = _mm_or_si128(gt, _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_slli_epi64(gt, 32)));
+        return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+#endif
+    }
+#endif
+
+#ifdef __AVX2__
+    /**
+     * @brief Sum of the eight 32-bit lanes of `v`.
+     */
+    inline int32_t hsum_epi32(__m256i v) {
+        return hsum_epi32(_mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+    /**
+     * @brief Sum of the four 64-bit lanes of `v`.
+     */
+    inline int64_t hsum_epi64(__m256i v) {
+        return hsum_epi64(_mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+    /**
+     * @brief Low 64 bits of the lane-wise 64x64 bit product, AVX2 has no `vpmullq`.
+     */
+    inline __m256i mullo_epi64_avx(__m256i a, __m256i b) {
+        __m256i lo = _mm256_mul_epu32(a, b);
+        __m256i c1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+        __m256i c2 = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(_mm256_add_epi64(c1, c2), 32));
+    }
+#endif
+
+    /**
+     * @class lane_simd
+     * @brief Wrapping add, sub and mul on one register of `lanes` elements.
+     *
+     * The primary template is the scalar fallback with one lane; the arithmetic is done
+     * unsigned so that overflow wraps like the SIMD lanes do.
+     *
+     * @tparam TINT The element type.
+     * @tparam TTECH The technique type.
+     */
+    template <typename TINT, techn_t TTECH, typename = void>
+    struct lane_simd {
+        static constexpr size_t lanes = 1;
+        using reg = typename std::make_unsigned<TINT>::type;
+
+        static reg load(const TINT* p)       { return reg(*p); }
+        static void store(TINT* p, reg v)    { *p = TINT(v); }
+        static reg add(reg a, reg b)         { return reg(a + b); }
+        static reg sub(reg a, reg b)         { return reg(a - b); }
+        static reg mul(reg a, reg b)         { return reg(wide(a) * wide(b)); }
+
+    private:
+        // Narrow types would be promoted to (signed) int and could overflow.
+        using wide = typename std::conditional<(sizeof(reg) < sizeof(unsigned)), unsigned, reg>::type;
+    };
+
+#ifdef __SSE4_1__
+    template <typename TINT>
+    struct lane_simd<TINT, techn_type::SSE, typename std::enable_if<sizeof(TINT) == 2 || sizeof(TINT) == 4 || sizeof(TINT) == 8>::type> {
+        static constexpr size_t lanes = 16 / sizeof(TINT);
+        using reg = __m128i;
+
+        static reg load(const TINT* p)       { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(TINT* p, reg v)    { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static reg add(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm_add_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_add_epi32(a, b);
+            else return _mm_add_epi64(a, b);
+        }
+        static reg sub(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm_sub_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_sub_epi32(a, b);
+            else return _mm_sub_epi64(a, b);
+        }
+        static reg mul(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm_mullo_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_mullo_epi32(a, b);
+            else return mullo_epi64_sse(a, b);
+        }
+    };
+#endif
+
+#ifdef __AVX2__
+    template <typename TINT>
+    struct lane_simd<TINT, techn_type::AVX, typename std::enable_if<sizeof(TINT) == 2 || sizeof(TINT) == 4 || sizeof(TINT) == 8>::type> {
+        static constexpr size_t lanes = 32 / sizeof(TINT);
+        using reg = __m256i;
+
+        static reg load(const TINT* p)       { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(TINT* p, reg v)    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static reg add(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm256_add_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_add_epi32(a, b);
+            else return _mm256_add_epi64(a, b);
+        }
+        static reg sub(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm256_sub_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_sub_epi32(a, b);
+            else return _mm256_sub_epi64(a, b);
+        }
+        static reg mul(reg a, reg b) {
+            if constexpr (sizeof(TINT) == 2) return _mm256_mullo_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_mullo_epi32(a, b);
+            else return mullo_epi64_avx(a, b);
+        }
+    };
+#endif
+
+#ifdef __AVX512__
+    template <typename TINT>
+    struct lane_simd<TINT, techn_type::AVX512, typename std::enable_if<sizeof(TINT) == 2 || sizeof(TINT) == 4 || sizeof(TINT) == 8>::type>
+        : lane_simd<TINT, techn_type::AVX> { };
+#endif
+}
+}
+
+#endif
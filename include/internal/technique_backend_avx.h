@@ -6,6 +6,11 @@
  * backend operations for arithmetic computations. The class supports addition, subtraction, 
  * multiplication, and division using standard scalar operations. It is templated to work 
  * with different integer types.
+ *
+ * abs, min, max, clamp, sign and the rounding average use `vpabs*`, `vpmin*`/`vpmax*`,
+ * `vpsign*` and `vpavg*`; AVX2 has no 64-bit min, max, abs or arithmetic shift, those
+ * lanes use `vpcmpgtq` and blends unless AVX-512VL provides them. Their batch versions
+ * run 32 bytes per step with a scalar tail.
  * 
  * @author Amber-Sophia Schröck 
  * @date 2025-06-09
@@ -17,7 +22,12 @@
 #define ADAPTIVE_BACKEND_AVX_H
 
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 #include "technique_backend_type.h"
+#include "technique_backend_scalar.h"
 
 #ifdef __AVX2__
 #include "immintrin.h"
@@ -158,6 +168,161 @@ namespace adaptive {
         static value_type div(const value_type& a, const value_type& b)  {
             return a / b;
         }
+        /**
+         * @brief The absolute value of `a`, the most negative value wraps to itself like `vpabs`.
+         */
+        static value_type abs(const value_type& a)  {
+            return extract(abs_v(set1(a)));
+        }
+        static value_type min(const value_type& a, const value_type& b)  {
+            return extract(min_v(set1(a), set1(b)));
+        }
+        static value_type max(const value_type& a, const value_type& b)  {
+            return extract(max_v(set1(a), set1(b)));
+        }
+        /**
+         * @brief `a` limited to `[lo, hi]`, `lo` must not be above `hi`.
+         */
+        static value_type clamp(const value_type& a, const value_type& lo, const value_type& hi)  {
+            return extract(min_v(max_v(set1(a), set1(lo)), set1(hi)));
+        }
+        /**
+         * @brief -1, 0 or 1 by the sign of `a`, 0 or 1 for unsigned types.
+         */
+        static value_type sign(const value_type& a)  {
+            return extract(sign_v(set1(a)));
+        }
+        /**
+         * @brief The average of `a` and `b` rounded up, `(a + b + 1) >> 1` without overflow like `vpavg`.
+         */
+        static value_type avg(const value_type& a, const value_type& b)  {
+            return extract(avg_v(set1(a), set1(b)));
+        }
+
+        /**
+         * @brief Batch versions, `out[i] = f(a[i])` or `f(a[i], b[i])`, `out` may alias the inputs.
+         */
+        static void abs(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, abs_v(load(a + i)));
+            scalar_type::abs(a + i, out + i, n - i);
+        }
+        static void min(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, min_v(load(a + i), load(b + i)));
+            scalar_type::min(a + i, b + i, out + i, n - i);
+        }
+        static void max(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, max_v(load(a + i), load(b + i)));
+            scalar_type::max(a + i, b + i, out + i, n - i);
+        }
+        static void clamp(const value_type* a, const value_type& lo, const value_type& hi, value_type* out, size_type n)  {
+            const __m256i vlo = set1(lo), vhi = set1(hi);
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, min_v(max_v(load(a + i), vlo), vhi));
+            scalar_type::clamp(a + i, lo, hi, out + i, n - i);
+        }
+        static void sign(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, sign_v(load(a + i)));
+            scalar_type::sign(a + i, out + i, n - i);
+        }
+        static void avg(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, avg_v(load(a + i), load(b + i)));
+            scalar_type::avg(a + i, b + i, out + i, n - i);
+        }
+
+    protected:
+        using scalar_type = technique_backend_scalar<TINT>;
+        static constexpr size_type lanes = 32 / sizeof(TINT);
+        static constexpr bool is_signed = std::is_signed<TINT>::value;
+
+        static __m256i load(const value_type* p)   { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(value_type* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static __m256i set1(value_type v) {
+            if constexpr (sizeof(TINT) == 1) return _mm256_set1_epi8(char(v));
+            else if constexpr (sizeof(TINT) == 2) return _mm256_set1_epi16(short(v));
+            else if constexpr (sizeof(TINT) == 4) return _mm256_set1_epi32(int(v));
+            else return _mm256_set1_epi64x(int64_t(v));
+        }
+        static value_type extract(__m256i v) {
+            const __m128i lo = _mm256_castsi256_si128(v);
+            if constexpr (sizeof(TINT) == 8) return static_cast<value_type>(_mm_cvtsi128_si64(lo));
+            else return static_cast<value_type>(_mm_cvtsi128_si32(lo));
+        }
+        /**
+         * @brief Signed `a > b` of 64-bit lanes, unsigned ones with the sign bit flipped.
+         */
+        static __m256i cmpgt64(__m256i a, __m256i b) {
+            if constexpr (is_signed) return _mm256_cmpgt_epi64(a, b);
+            const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+        }
+        static __m256i abs_v(__m256i v) {
+            if constexpr (!is_signed) return v;
+            else if constexpr (sizeof(TINT) == 1) return _mm256_abs_epi8(v);
+            else if constexpr (sizeof(TINT) == 2) return _mm256_abs_epi16(v);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_abs_epi32(v);
+            else {
+#ifdef __AVX512VL__
+                return _mm256_abs_epi64(v);
+#else
+                const __m256i m = cmpgt64(_mm256_setzero_si256(), v);
+                return _mm256_sub_epi64(_mm256_xor_si256(v, m), m);
+#endif
+            }
+        }
+        static __m256i min_v(__m256i a, __m256i b) {
+            if constexpr (sizeof(TINT) == 1) return is_signed ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return is_signed ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return is_signed ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+            else {
+#ifdef __AVX512VL__
+                return is_signed ? _mm256_min_epi64(a, b) : _mm256_min_epu64(a, b);
+#else
+                return _mm256_blendv_epi8(a, b, cmpgt64(a, b));
+#endif
+            }
+        }
+        static __m256i max_v(__m256i a, __m256i b) {
+            if constexpr (sizeof(TINT) == 1) return is_signed ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return is_signed ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return is_signed ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+            else {
+#ifdef __AVX512VL__
+                return is_signed ? _mm256_max_epi64(a, b) : _mm256_max_epu64(a, b);
+#else
+                return _mm256_blendv_epi8(b, a, cmpgt64(a, b));
+#endif
+            }
+        }
+        static __m256i sign_v(__m256i v) {
+            if constexpr (!is_signed) return min_v(v, set1(1));
+            else if constexpr (sizeof(TINT) == 1) return _mm256_sign_epi8(_mm256_set1_epi8(1), v);
+            else if constexpr (sizeof(TINT) == 2) return _mm256_sign_epi16(_mm256_set1_epi16(1), v);
+            else if constexpr (sizeof(TINT) == 4) return _mm256_sign_epi32(_mm256_set1_epi32(1), v);
+            else return _mm256_sub_epi64(cmpgt64(_mm256_setzero_si256(), v), cmpgt64(v, _mm256_setzero_si256()));
+        }
+        static __m256i avg_v(__m256i a, __m256i b) {
+            if constexpr (sizeof(TINT) <= 2) {
+                const __m256i bias = is_signed ? set1(value_type(value_type(1) << (8 * sizeof(TINT) - 1))) : _mm256_setzero_si256();
+                a = _mm256_xor_si256(a, bias);
+                b = _mm256_xor_si256(b, bias);
+                const __m256i r = sizeof(TINT) == 1 ? _mm256_avg_epu8(a, b) : _mm256_avg_epu16(a, b);
+                return _mm256_xor_si256(r, bias);
+            } else {
+                // (a | b) - ((a ^ b) >> 1), arithmetic shift for signed lanes.
+                const __m256i x = _mm256_xor_si256(a, b), o = _mm256_or_si256(a, b);
+                if constexpr (sizeof(TINT) == 4) return _mm256_sub_epi32(o, is_signed ? _mm256_srai_epi32(x, 1) : _mm256_srli_epi32(x, 1));
+                else {
+                    __m256i h = _mm256_srli_epi64(x, 1);
+                    if constexpr (is_signed) h = _mm256_or_si256(h, _mm256_and_si256(x, _mm256_set1_epi64x(INT64_MIN)));
+                    return _mm256_sub_epi64(o, h);
+                }
+            }
+        }
     };
 }
 #endif 
@@ -6,6 +6,11 @@
  * backend operations for arithmetic computations. The class supports addition, subtraction, 
  * multiplication, and division using standard scalar operations. It is templated to work 
  * with different integer types.
+ *
+ * MMX has no min, max, abs, sign or average instructions for general lane types, so
+ * abs, min, max, clamp, sign and the rounding average are built from `pcmpgt*` masks,
+ * and/andnot selects and shifts on 8, 16 and 32-bit lanes; 64-bit values, which MMX
+ * cannot compare, use the scalar backend. Their batch versions run 8 bytes per step.
  * 
  * @author Amber-Sophia Schröck 
  * @date 2025-06-09
@@ -16,7 +21,13 @@
 #ifndef ADAPTIVE_BACKEND_MMX_H
 #define ADAPTIVE_BACKEND_MMX_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
 #include "technique_backend_type.h"
+#include "technique_backend_scalar.h"
 
 #ifdef __MMX__
 
@@ -137,6 +148,172 @@ namespace adaptive {
         static value_type div(const value_type& a, const value_type& b)  {
             return a / b;
         }
+        /**
+         * @brief The absolute value of `a`, the most negative value wraps to itself.
+         */
+        static value_type abs(const value_type& a)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::abs(a);
+            else return finish(abs_v(set1(a)));
+        }
+        static value_type min(const value_type& a, const value_type& b)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::min(a, b);
+            else return finish(min_v(set1(a), set1(b)));
+        }
+        static value_type max(const value_type& a, const value_type& b)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::max(a, b);
+            else return finish(max_v(set1(a), set1(b)));
+        }
+        /**
+         * @brief `a` limited to `[lo, hi]`, `lo` must not be above `hi`.
+         */
+        static value_type clamp(const value_type& a, const value_type& lo, const value_type& hi)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::clamp(a, lo, hi);
+            else return finish(min_v(max_v(set1(a), set1(lo)), set1(hi)));
+        }
+        /**
+         * @brief -1, 0 or 1 by the sign of `a`, 0 or 1 for unsigned types.
+         */
+        static value_type sign(const value_type& a)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::sign(a);
+            else return finish(sign_v(set1(a)));
+        }
+        /**
+         * @brief The average of `a` and `b` rounded up, `(a + b + 1) >> 1` without overflow.
+         */
+        static value_type avg(const value_type& a, const value_type& b)  {
+            if constexpr (sizeof(TINT) == 8) return scalar_type::avg(a, b);
+            else return finish(avg_v(set1(a), set1(b)));
+        }
+
+        /**
+         * @brief Batch versions, `out[i] = f(a[i])` or `f(a[i], b[i])`, `out` may alias the inputs.
+         */
+        static void abs(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                for(; i + lanes <= n; i += lanes) store(out + i, abs_v(load(a + i)));
+                _mm_empty();
+            }
+            scalar_type::abs(a + i, out + i, n - i);
+        }
+        static void min(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                for(; i + lanes <= n; i += lanes) store(out + i, min_v(load(a + i), load(b + i)));
+                _mm_empty();
+            }
+            scalar_type::min(a + i, b + i, out + i, n - i);
+        }
+        static void max(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                for(; i + lanes <= n; i += lanes) store(out + i, max_v(load(a + i), load(b + i)));
+                _mm_empty();
+            }
+            scalar_type::max(a + i, b + i, out + i, n - i);
+        }
+        static void clamp(const value_type* a, const value_type& lo, const value_type& hi, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                const __m64 vlo = set1(lo), vhi = set1(hi);
+                for(; i + lanes <= n; i += lanes) store(out + i, min_v(max_v(load(a + i), vlo), vhi));
+                _mm_empty();
+            }
+            scalar_type::clamp(a + i, lo, hi, out + i, n - i);
+        }
+        static void sign(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                for(; i + lanes <= n; i += lanes) store(out + i, sign_v(load(a + i)));
+                _mm_empty();
+            }
+            scalar_type::sign(a + i, out + i, n - i);
+        }
+        static void avg(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            if constexpr (sizeof(TINT) < 8) {
+                for(; i + lanes <= n; i += lanes) store(out + i, avg_v(load(a + i), load(b + i)));
+                _mm_empty();
+            }
+            scalar_type::avg(a + i, b + i, out + i, n - i);
+        }
+
+    protected:
+        using scalar_type = technique_backend_scalar<TINT>;
+        static constexpr size_type lanes = 8 / sizeof(TINT);
+        static constexpr bool is_signed = std::is_signed<TINT>::value;
+
+        static __m64 load(const value_type* p) {
+            __m64 _result;
+            std::memcpy(&_result, p, sizeof(_result));
+            return _result;
+        }
+        static void store(value_type* p, __m64 v) { std::memcpy(p, &v, sizeof(v)); }
+        static __m64 set1(value_type v) {
+            if constexpr (sizeof(TINT) == 1) return _mm_set1_pi8(char(v));
+            else if constexpr (sizeof(TINT) == 2) return _mm_set1_pi16(short(v));
+            else return _mm_set1_pi32(int(v));
+        }
+        /**
+         * @brief The low lane of `v`, leaves the MMX state.
+         */
+        static value_type finish(__m64 v) {
+            const value_type _result = static_cast<value_type>(_mm_cvtsi64_si32(v));
+            _mm_empty();
+            return _result;
+        }
+        static __m64 sub(__m64 a, __m64 b) {
+            if constexpr (sizeof(TINT) == 1) return _mm_sub_pi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_sub_pi16(a, b);
+            else return _mm_sub_pi32(a, b);
+        }
+        static __m64 cmpeq(__m64 a, __m64 b) {
+            if constexpr (sizeof(TINT) == 1) return _mm_cmpeq_pi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_cmpeq_pi16(a, b);
+            else return _mm_cmpeq_pi32(a, b);
+        }
+        /**
+         * @brief `a > b` per lane, unsigned lanes with the sign bit flipped.
+         */
+        static __m64 cmpgt(__m64 a, __m64 b) {
+            if constexpr (!is_signed) {
+                const __m64 bias = set1(value_type(value_type(1) << (8 * sizeof(TINT) - 1)));
+                a = _mm_xor_si64(a, bias);
+                b = _mm_xor_si64(b, bias);
+            }
+            if constexpr (sizeof(TINT) == 1) return _mm_cmpgt_pi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_cmpgt_pi16(a, b);
+            else return _mm_cmpgt_pi32(a, b);
+        }
+        static __m64 select(__m64 m, __m64 a, __m64 b) {
+            return _mm_or_si64(_mm_and_si64(m, a), _mm_andnot_si64(m, b));
+        }
+        static __m64 abs_v(__m64 v) {
+            if constexpr (!is_signed) return v;
+            const __m64 m = cmpgt(_mm_setzero_si64(), v);
+            return sub(_mm_xor_si64(v, m), m);
+        }
+        static __m64 min_v(__m64 a, __m64 b) { return select(cmpgt(a, b), b, a); }
+        static __m64 max_v(__m64 a, __m64 b) { return select(cmpgt(a, b), a, b); }
+        static __m64 sign_v(__m64 v) {
+            const __m64 zero = _mm_setzero_si64();
+            if constexpr (is_signed) return sub(cmpgt(zero, v), cmpgt(v, zero));
+            else return _mm_andnot_si64(cmpeq(v, zero), set1(1));
+        }
+        static __m64 avg_v(__m64 a, __m64 b) {
+            // (a | b) - ((a ^ b) >> 1), arithmetic shift for signed lanes.
+            const __m64 x = _mm_xor_si64(a, b), o = _mm_or_si64(a, b);
+            __m64 h;
+            if constexpr (sizeof(TINT) == 1) {
+                h = _mm_and_si64(_mm_srli_pi16(x, 1), _mm_set1_pi8(0x7F));
+                if constexpr (is_signed) h = _mm_or_si64(h, _mm_and_si64(x, _mm_set1_pi8(char(0x80))));
+            } else if constexpr (sizeof(TINT) == 2) {
+                h = is_signed ? _mm_srai_pi16(x, 1) : _mm_srli_pi16(x, 1);
+            } else {
+                h = is_signed ? _mm_srai_pi32(x, 1) : _mm_srli_pi32(x, 1);
+            }
+            return sub(o, h);
+        }
     };
 }
 #endif
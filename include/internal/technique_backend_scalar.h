@@ -5,8 +5,9 @@
  * 
  * This file defines the `technique_backend_scalar` class, which provides scalar-based 
  * backend operations for arithmetic computations. The class supports addition, subtraction, 
- * multiplication, and division using standard scalar operations. It is templated to work 
- * with different integer types.
+ * multiplication, and division using standard scalar operations, plus abs, min, max,
+ * clamp, sign and the rounding average, each also as a batch over arrays. It is
+ * templated to work with different integer types.
  * 
  * @author Amber-Sophia Schröck 
  * @date 2025-06-09
@@ -17,6 +18,9 @@
 #ifndef ADAPTIVE_BACKEND_SCALAR_H
 #define ADAPTIVE_BACKEND_SCALAR_H
 
+#include <cstddef>
+#include <type_traits>
+
 #include "technique_backend_type.h"
 
 /**
@@ -93,6 +97,63 @@ namespace adaptive {
         static value_type div(const value_type& a, const value_type& b)  {
             return a / b;
         }
+        /**
+         * @brief The absolute value of `a`, the most negative value wraps to itself like `pabs`.
+         */
+        static value_type abs(const value_type& a)  {
+            if constexpr (std::is_signed<value_type>::value) {
+                using unsigned_type = typename std::make_unsigned<value_type>::type;
+                return a < 0 ? value_type(unsigned_type(0) - unsigned_type(a)) : a;
+            } else {
+                return a;
+            }
+        }
+        static value_type min(const value_type& a, const value_type& b)  {
+            return b < a ? b : a;
+        }
+        static value_type max(const value_type& a, const value_type& b)  {
+            return a < b ? b : a;
+        }
+        /**
+         * @brief `a` limited to `[lo, hi]`, `lo` must not be above `hi`.
+         */
+        static value_type clamp(const value_type& a, const value_type& lo, const value_type& hi)  {
+            return min(max(a, lo), hi);
+        }
+        /**
+         * @brief -1, 0 or 1 by the sign of `a`, 0 or 1 for unsigned types.
+         */
+        static value_type sign(const value_type& a)  {
+            return value_type((a > 0) - (a < 0));
+        }
+        /**
+         * @brief The average of `a` and `b` rounded up, `(a + b + 1) >> 1` without overflow like `pavg`.
+         */
+        static value_type avg(const value_type& a, const value_type& b)  {
+            return value_type((a | b) - ((a ^ b) >> 1));
+        }
+
+        /**
+         * @brief Batch versions, `out[i] = f(a[i])` or `f(a[i], b[i])`, `out` may alias the inputs.
+         */
+        static void abs(const value_type* a, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = abs(a[i]);
+        }
+        static void min(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = min(a[i], b[i]);
+        }
+        static void max(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = max(a[i], b[i]);
+        }
+        static void clamp(const value_type* a, const value_type& lo, const value_type& hi, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = clamp(a[i], lo, hi);
+        }
+        static void sign(const value_type* a, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = sign(a[i]);
+        }
+        static void avg(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            for(size_type i = 0; i < n; ++i) out[i] = avg(a[i], b[i]);
+        }
     };
 }
 
@@ -6,6 +6,13 @@
  * backend operations for arithmetic computations. The class supports addition, subtraction, 
  * multiplication, and division using standard scalar operations. It is templated to work 
  * with different integer types.
+ *
+ * abs, min, max, clamp, sign and the rounding average use `pavg*` and the SSE2
+ * `pminub`/`pminsw` forms, the SSSE3 `pabs*`/`psign*` and the SSE4.1 `pmin*`/`pmax*`
+ * and `pblendvb` when the target has them; the other widths compare and select with
+ * SSE2 instructions (`pcmpgtq` is emulated below SSE4.2), signed `pavg` flips the sign
+ * bit around the unsigned one. Their batch versions run 16 bytes per step with a
+ * scalar tail.
  * 
  * @author Amber-Sophia Schröck 
  * @date 2025-06-09
@@ -16,12 +23,18 @@
 #ifndef ADAPTIVE_BACKEND_SSE3_H
 #define ADAPTIVE_BACKEND_SSE3_H
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 #include "technique_backend_type.h"
+#include "technique_backend_scalar.h"
 
 
 #ifdef __SSE2__
 #include "emmintrin.h"
 #include "smmintrin.h"
+#include "simd_util.h"
 
 namespace adaptive {
     /**
@@ -128,6 +141,178 @@ namespace adaptive {
         static value_type div(const value_type& a, const value_type& b)  {
             return a / b;
         }
+        /**
+         * @brief The absolute value of `a`, the most negative value wraps to itself like `pabs`.
+         */
+        static value_type abs(const value_type& a)  {
+            return extract(abs_v(set1(a)));
+        }
+        static value_type min(const value_type& a, const value_type& b)  {
+            return extract(min_v(set1(a), set1(b)));
+        }
+        static value_type max(const value_type& a, const value_type& b)  {
+            return extract(max_v(set1(a), set1(b)));
+        }
+        /**
+         * @brief `a` limited to `[lo, hi]`, `lo` must not be above `hi`.
+         */
+        static value_type clamp(const value_type& a, const value_type& lo, const value_type& hi)  {
+            return extract(min_v(max_v(set1(a), set1(lo)), set1(hi)));
+        }
+        /**
+         * @brief -1, 0 or 1 by the sign of `a`, 0 or 1 for unsigned types.
+         */
+        static value_type sign(const value_type& a)  {
+            return extract(sign_v(set1(a)));
+        }
+        /**
+         * @brief The average of `a` and `b` rounded up, `(a + b + 1) >> 1` without overflow like `pavg`.
+         */
+        static value_type avg(const value_type& a, const value_type& b)  {
+            return extract(avg_v(set1(a), set1(b)));
+        }
+
+        /**
+         * @brief Batch versions, `out[i] = f(a[i])` or `f(a[i], b[i])`, `out` may alias the inputs.
+         */
+        static void abs(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, abs_v(load(a + i)));
+            scalar_type::abs(a + i, out + i, n - i);
+        }
+        static void min(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, min_v(load(a + i), load(b + i)));
+            scalar_type::min(a + i, b + i, out + i, n - i);
+        }
+        static void max(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, max_v(load(a + i), load(b + i)));
+            scalar_type::max(a + i, b + i, out + i, n - i);
+        }
+        static void clamp(const value_type* a, const value_type& lo, const value_type& hi, value_type* out, size_type n)  {
+            const __m128i vlo = set1(lo), vhi = set1(hi);
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, min_v(max_v(load(a + i), vlo), vhi));
+            scalar_type::clamp(a + i, lo, hi, out + i, n - i);
+        }
+        static void sign(const value_type* a, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, sign_v(load(a + i)));
+            scalar_type::sign(a + i, out + i, n - i);
+        }
+        static void avg(const value_type* a, const value_type* b, value_type* out, size_type n)  {
+            size_type i = 0;
+            for(; i + lanes <= n; i += lanes) store(out + i, avg_v(load(a + i), load(b + i)));
+            scalar_type::avg(a + i, b + i, out + i, n - i);
+        }
+
+    protected:
+        using scalar_type = technique_backend_scalar<TINT>;
+        static constexpr size_type lanes = 16 / sizeof(TINT);
+        static constexpr bool is_signed = std::is_signed<TINT>::value;
+
+        static __m128i load(const value_type* p)   { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(value_type* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static __m128i set1(value_type v) {
+            if constexpr (sizeof(TINT) == 1) return _mm_set1_epi8(char(v));
+            else if constexpr (sizeof(TINT) == 2) return _mm_set1_epi16(short(v));
+            else if constexpr (sizeof(TINT) == 4) return _mm_set1_epi32(int(v));
+            else return _mm_set1_epi64x(int64_t(v));
+        }
+        static value_type extract(__m128i v) {
+            if constexpr (sizeof(TINT) == 8) return static_cast<value_type>(_mm_cvtsi128_si64(v));
+            else return static_cast<value_type>(_mm_cvtsi128_si32(v));
+        }
+        /**
+         * @brief Signed `a > b` of the lanes, unsigned ones with the sign bit flipped.
+         */
+        static __m128i cmpgt_v(__m128i a, __m128i b) {
+            if constexpr (!is_signed) {
+                const __m128i bias = set1(value_type(value_type(1) << (8 * sizeof(TINT) - 1)));
+                a = _mm_xor_si128(a, bias);
+                b = _mm_xor_si128(b, bias);
+            }
+            if constexpr (sizeof(TINT) == 1) return _mm_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_cmpgt_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_cmpgt_epi32(a, b);
+            else return internal::cmpgt_epi64_sse(a, b);
+        }
+        /**
+         * @brief `m ? a : b` per lane, `m` is a compare mask.
+         */
+        static __m128i select_v(__m128i m, __m128i a, __m128i b) {
+#ifdef __SSE4_1__
+            return _mm_blendv_epi8(b, a, m);
+#else
+            return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+#endif
+        }
+        static __m128i sub_v(__m128i a, __m128i b) {
+            if constexpr (sizeof(TINT) == 1) return _mm_sub_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_sub_epi16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return _mm_sub_epi32(a, b);
+            else return _mm_sub_epi64(a, b);
+        }
+        static __m128i abs_v(__m128i v) {
+            if constexpr (!is_signed) return v;
+#ifdef __SSSE3__
+            else if constexpr (sizeof(TINT) == 1) return _mm_abs_epi8(v);
+            else if constexpr (sizeof(TINT) == 2) return _mm_abs_epi16(v);
+            else if constexpr (sizeof(TINT) == 4) return _mm_abs_epi32(v);
+#endif
+            else {
+                const __m128i m = cmpgt_v(_mm_setzero_si128(), v);
+                return sub_v(_mm_xor_si128(v, m), m);
+            }
+        }
+        static __m128i min_v(__m128i a, __m128i b) {
+            if constexpr (sizeof(TINT) == 1 && !is_signed) return _mm_min_epu8(a, b);
+            else if constexpr (sizeof(TINT) == 2 && is_signed) return _mm_min_epi16(a, b);
+#ifdef __SSE4_1__
+            else if constexpr (sizeof(TINT) == 1) return _mm_min_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_min_epu16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return is_signed ? _mm_min_epi32(a, b) : _mm_min_epu32(a, b);
+#endif
+            else return select_v(cmpgt_v(a, b), b, a);
+        }
+        static __m128i max_v(__m128i a, __m128i b) {
+            if constexpr (sizeof(TINT) == 1 && !is_signed) return _mm_max_epu8(a, b);
+            else if constexpr (sizeof(TINT) == 2 && is_signed) return _mm_max_epi16(a, b);
+#ifdef __SSE4_1__
+            else if constexpr (sizeof(TINT) == 1) return _mm_max_epi8(a, b);
+            else if constexpr (sizeof(TINT) == 2) return _mm_max_epu16(a, b);
+            else if constexpr (sizeof(TINT) == 4) return is_signed ? _mm_max_epi32(a, b) : _mm_max_epu32(a, b);
+#endif
+            else return select_v(cmpgt_v(a, b), a, b);
+        }
+        static __m128i sign_v(__m128i v) {
+            if constexpr (!is_signed) return min_v(v, set1(1));
+#ifdef __SSSE3__
+            else if constexpr (sizeof(TINT) == 1) return _mm_sign_epi8(_mm_set1_epi8(1), v);
+            else if constexpr (sizeof(TINT) == 2) return _mm_sign_epi16(_mm_set1_epi16(1), v);
+            else if constexpr (sizeof(TINT) == 4) return _mm_sign_epi32(_mm_set1_epi32(1), v);
+#endif
+            else return sub_v(cmpgt_v(_mm_setzero_si128(), v), cmpgt_v(v, _mm_setzero_si128()));
+        }
+        static __m128i avg_v(__m128i a, __m128i b) {
+            if constexpr (sizeof(TINT) <= 2) {
+                const __m128i bias = is_signed ? set1(value_type(value_type(1) << (8 * sizeof(TINT) - 1))) : _mm_setzero_si128();
+                a = _mm_xor_si128(a, bias);
+                b = _mm_xor_si128(b, bias);
+                const __m128i r = sizeof(TINT) == 1 ? _mm_avg_epu8(a, b) : _mm_avg_epu16(a, b);
+                return _mm_xor_si128(r, bias);
+            } else {
+                // (a | b) - ((a ^ b) >> 1), arithmetic shift for signed lanes.
+                const __m128i x = _mm_xor_si128(a, b), o = _mm_or_si128(a, b);
+                if constexpr (sizeof(TINT) == 4) return _mm_sub_epi32(o, is_signed ? _mm_srai_epi32(x, 1) : _mm_srli_epi32(x, 1));
+                else {
+                    __m128i h = _mm_srli_epi64(x, 1);
+                    if constexpr (is_signed) h = _mm_or_si128(h, _mm_and_si128(x, _mm_set1_epi64x(INT64_MIN)));
+                    return _mm_sub_epi64(o, h);
+                }
+            }
+        }
     };
 }
 #endif